@@ -1,33 +1,47 @@
 #ifndef BMSSP_H
 #define BMSSP_H
 #include "Graph.h"
-#include<unordered_set>
+#include "CSRGraph.h"
+#include "CompressedGraph.h"
+#include "Cancellation.h"
+#include "MemoryTracker.h"
 #include<vector>
 
 struct BaseCaseResults {
     double B;
-    std::unordered_set<int> U;
+    TrackedUnorderedSet<int> U;
 };
 
-BaseCaseResults runBaseCase(Graph& graph, int src, double B);
+// Standalone base case: bounded Dijkstra from src at distance 0 on private arrays. runBMSSP's
+// level 0 runs the same search on the caller's distances and predecessors instead.
+// GraphT is Graph, CSRGraph<float | uint32_t | double> or CompressedGraph (explicitly instantiated)
+template <typename GraphT>
+BaseCaseResults runBaseCase(const GraphT& graph, int src, double B);
 
 // A struct to hold the results of a BMSSP call, as described in the paper [cite: 109]
 struct BMSSPResult {
     double new_bound;
     std::vector<int> completed_vertices;
+    // false when a CancellationToken stopped this call or one below it; completed_vertices
+    // then lists only what was finished and new_bound is not meaningful
+    bool complete = true;
 };
 
 // The declaration for the main recursive function
+template <typename GraphT>
 BMSSPResult runBMSSP(
     // --- Main data that doesn't change ---
-    Graph& graph,
+    const GraphT& graph,
     std::vector<double>& distances,
     std::vector<int>& predecessors,
 
     // --- Parameters for this specific recursive call ---
     int level,                      // The current recursion level, l [cite: 106]
     double B,                       // The upper bound for this search [cite: 106]
-    const std::vector<int>& S       // The set of source vertices for this sub-problem [cite: 106]
+    const std::vector<int>& S,      // The set of source vertices for this sub-problem [cite: 106]
+
+    // Checked before every BatchHeap pull; a stop unwinds all levels with complete = false
+    const CancellationToken* cancel = nullptr
 );
 
 
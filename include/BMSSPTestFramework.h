@@ -20,7 +20,13 @@ enum class GraphType {
     BIPARTITE,
     LAYERED,
     COMPLETE,
-    DISCONNECTED
+    DISCONNECTED,
+    RMAT,               // power-law, see GraphGenerators.h
+    // These two ignore TestParameters::weight_dist: their weights are the edges' euclidean
+    // lengths (road segments also scaled by speed and congestion), which is what makes them
+    // geometric. Every other type, RMAT included, draws its weights from weight_dist.
+    RANDOM_GEOMETRIC,
+    ROAD_GRID
 };
 
 enum class WeightDistribution {
@@ -88,6 +94,10 @@ struct BMSSPTestOutput {
     double execution_time_ms;
     int recursive_calls;
     int total_vertices_processed;
+    // Peak of the run's tracked allocations (see MemoryTracker.h) plus its distance and
+    // predecessor arrays. Not counted: the completed_vertices and pulled-vertex vectors
+    // handed between levels, each at most as large as the run's own result.
+    size_t memory_peak_kb = 0;
     std::string error_message;
 };
 
@@ -159,6 +169,10 @@ public:
     // Main test case generation
     BMSSPTestCase generateTestCase(const TestParameters& params);
     std::vector<BMSSPTestCase> generateTestSuite();
+    // One case per entry, generated in parallel on the shared runtime (Parallel.h). Each case
+    // draws from its own generator, seeded from rng in entry order, so the cases depend on
+    // the framework seed but not on the thread count.
+    std::vector<BMSSPTestCase> generateTestCases(const std::vector<TestParameters>& params);
 
     // Test execution
     BMSSPTestOutput executeBMSSP(const BMSSPTestCase& test_case);
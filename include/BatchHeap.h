@@ -1,14 +1,17 @@
 #ifndef BATCHHEAP_H
 #define BATCHHEAP_H
+#include "MemoryTracker.h"
+#include <cstddef>
 #include <list>
 #include <unordered_map>
 #include <map>
+#include <vector>
 
 // a batch of nodes for the custom datastructure
 // a simple linked list of key value pairs
 struct Block {
     int upper_bound;
-    std::list<std::pair<int, double>> block;
+    TrackedList<std::pair<int, double>> block;
 };
 
 // a struct to hold the result of a pull call
@@ -20,24 +23,29 @@ struct PullResults {
 class BatchHeap {
     private:
     int M; int B;
-    std::list<Block> D0;
-    std::list<Block> D1;
+    // All containers count their allocations in MemoryTracker
+    TrackedList<Block> D0;
+    TrackedList<Block> D1;
     // address books for O(1) deletion
-    std::unordered_map<int, std::list<Block>::iterator> address_book_l1_D0;
-    std::unordered_map<int, std::list<Block>::iterator> address_book_l1_D1;
-    std::unordered_map<int, std::list<std::pair<int, double>>::iterator> address_book_l2;
+    TrackedUnorderedMap<int, TrackedList<Block>::iterator> address_book_l1_D0;
+    TrackedUnorderedMap<int, TrackedList<Block>::iterator> address_book_l1_D1;
+    TrackedUnorderedMap<int, TrackedList<std::pair<int, double>>::iterator> address_book_l2;
 
-    std::map<double, std::list<Block>::iterator> D1_bound;
+    TrackedMap<double, TrackedList<Block>::iterator> D1_bound;
 
     void del(int key);
-    void split(std::list<Block>::iterator);
+    void split(TrackedList<Block>::iterator);
 
     public:
     BatchHeap(int M, int B);
     void insert(int key, double value);
-    void batchPrepend(std::list<std::pair<int, double>> items);
+    void batchPrepend(TrackedList<std::pair<int, double>> items);
     PullResults pull();
 
+    // Bytes held by the heap: the object, its blocks and address books. Container nodes are
+    // sized after the libstdc++ layouts, so this is an estimate within allocator overhead.
+    size_t memoryUsage() const;
+
 
 };
 
@@ -0,0 +1,39 @@
+#ifndef BIDIRECTIONAL_DIJKSTRA_H
+#define BIDIRECTIONAL_DIJKSTRA_H
+
+#include "Graph.h"
+#include "PointToPoint.h"
+#include "SearchWorkspace.h"
+#include <vector>
+
+// Point-to-point query that grows a forward search from the source and a backward search
+// (over Graph::reverseNeighbors) from the target, always expanding the side with the smaller
+// queue head. It stops once the two queue heads together reach the best meeting distance
+// found so far. The graph must have reverse edges enabled.
+class BidirectionalQuery {
+    private:
+    const Graph& graph;
+    SearchWorkspace forward;
+    SearchWorkspace backward;
+    int source;
+    int target;
+    int meeting_vertex;   // -1 when the last query found no path
+    double distance;
+    int settled_vertices;
+
+    public:
+    // Throws std::invalid_argument if !graph.hasReverseEdges()
+    explicit BidirectionalQuery(const Graph& graph);
+
+    // Distance from source to target, or max() when unreachable. Honours
+    // QueryOptions::distance_cap; stop_at_first_target does not apply.
+    double run(int source, int target, const QueryOptions& options = QueryOptions());
+
+    // source..target inclusive for the most recent run; empty when no path was found
+    std::vector<int> getPath() const;
+    int getMeetingVertex() const;
+    // Vertices settled by both searches together in the most recent run
+    int getSettledCount() const;
+};
+
+#endif // BIDIRECTIONAL_DIJKSTRA_H
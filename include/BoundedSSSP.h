@@ -0,0 +1,30 @@
+#ifndef BOUNDED_SSSP_H
+#define BOUNDED_SSSP_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "CompressedGraph.h"
+#include "SparseResult.h"
+#include <vector>
+
+// One vertex inside the radius; predecessor is -1 for the sources
+struct ReachedVertex {
+    int vertex;
+    double distance;
+    int predecessor;
+};
+
+// Every vertex whose distance from the nearest source is < radius (strict, like BMSSP's B),
+// in nondecreasing distance order. Edges leading past the radius are never queued, and the
+// search runs on the per-thread SearchWorkspace, so a call costs O(explored vertices) time
+// and memory once the workspace exists; nothing n-sized is allocated or returned.
+// Throws std::invalid_argument on out-of-range sources or a NaN radius.
+// Instantiated for Graph, CSRGraph<float | uint32_t | double> and CompressedGraph.
+template <typename GraphT>
+std::vector<ReachedVertex> boundedSSSP(const GraphT& graph, const std::vector<int>& sources, double radius);
+
+// The same search emitted as a SparseResult, for lookups and on-demand densifying
+template <typename GraphT>
+SparseResult boundedSSSPSparse(const GraphT& graph, const std::vector<int>& sources, double radius);
+
+#endif // BOUNDED_SSSP_H
@@ -0,0 +1,61 @@
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Cooperative stop signal for long-running searches. Another thread calls cancel(), or a
+// deadline is set up front; searches poll shouldStop() at cheap intervals and return what
+// they have so far, flagged as incomplete. Nothing is ever interrupted mid-update, so
+// partial distances are always lengths of real paths (upper bounds on the true distance).
+class CancellationToken {
+    private:
+    std::atomic<bool> cancelled;
+    std::atomic<int64_t> deadline_ns;   // steady_clock ticks since epoch, 0 when unset
+
+    public:
+    CancellationToken();
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    // Token that expires timeout after construction
+    explicit CancellationToken(std::chrono::nanoseconds timeout);
+
+    void cancel();
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    void setTimeout(std::chrono::nanoseconds timeout);   // deadline = now + timeout
+    void clearDeadline();
+
+    bool isCancelled() const;   // cancel() was called (no clock read)
+    bool isExpired() const;     // the deadline has passed
+    bool shouldStop() const;    // either of the above
+};
+
+// Amortised polling for hot loops: tick() reads the token (and possibly the clock) only once
+// every `interval` calls and stays true once the token fired. A null token never stops.
+class StopCheck {
+    private:
+    const CancellationToken* token;
+    uint32_t interval;
+    uint32_t countdown;
+    bool stopped;
+
+    public:
+    static const uint32_t DEFAULT_INTERVAL = 256;
+
+    explicit StopCheck(const CancellationToken* token, uint32_t interval = DEFAULT_INTERVAL)
+        : token(token), interval(interval > 0 ? interval : 1), countdown(1), stopped(false) {}
+
+    bool tick() {
+        if (!token || stopped) return stopped;
+        if (--countdown == 0) {
+            countdown = interval;
+            stopped = token->shouldStop();
+        }
+        return stopped;
+    }
+    bool isStopped() const { return stopped; }
+};
+
+#endif // CANCELLATION_H
@@ -0,0 +1,126 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "GraphGenerators.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Frozen adjacency for graphs that do not fit in RAM as CSR. Each out-list is sorted by
+// target and stored as a byte stream of (target gap, quantized weight) varint pairs:
+// the first target as zigzag(target - u), the rest as the difference to the previous
+// target, and each weight as round(weight / weight_quantum). Locality-friendly labelings
+// (see Reorder.h) keep the gaps short; typical lists take 2-4 bytes per edge.
+//
+// Weights decode to q * weight_quantum, so distances stay in the original units with an
+// error of at most weight_quantum / 2 per edge (none for weights that are multiples of
+// the quantum). Tombstoned edges are dropped on construction. The graph is immutable.
+class CompressedGraph {
+    private:
+    int num_vertices;
+    int64_t num_edges;
+    std::vector<uint64_t> offsets;   // byte offset of each list in data, size num_vertices + 1
+    std::vector<uint8_t> data;
+    double weight_quantum;
+    int k; int t;   // BMSSP parameters, as Graph computes them
+
+    // Sort and encode the lists produced by edgesOf(u, out) for every u, in parallel
+    template <typename EdgesOf>
+    static CompressedGraph build(int n, double weight_quantum, const EdgesOf& edgesOf);
+
+    public:
+    class EdgeIterator {
+        const uint8_t* pos;
+        const uint8_t* end;
+        double quantum;
+        WeightedEdge<double> current;
+        const uint8_t* next;
+
+        static uint64_t readVarint(const uint8_t*& p) {
+            uint64_t value = *p & 0x7f;
+            int shift = 7;
+            while (*p++ & 0x80) {
+                value |= static_cast<uint64_t>(*p & 0x7f) << shift;
+                shift += 7;
+            }
+            return value;
+        }
+
+        void decode(int previous, bool first) {
+            if (pos == end) return;
+            const uint8_t* p = pos;
+            uint64_t gap = readVarint(p);
+            if (first) {
+                int64_t delta = static_cast<int64_t>(gap >> 1) ^ -static_cast<int64_t>(gap & 1);
+                current.dest = static_cast<int>(previous + delta);
+            } else {
+                current.dest = previous + static_cast<int>(gap);
+            }
+            current.weight = static_cast<double>(readVarint(p)) * quantum;
+            next = p;
+        }
+
+        public:
+        // previous is the owning vertex for the first edge of a list
+        EdgeIterator(const uint8_t* pos, const uint8_t* end, double quantum, int owner)
+            : pos(pos), end(end), quantum(quantum), current{0, 0.0}, next(pos) {
+            decode(owner, true);
+        }
+        const WeightedEdge<double>& operator*() const { return current; }
+        EdgeIterator& operator++() {
+            pos = next;
+            decode(current.dest, false);
+            return *this;
+        }
+        bool operator!=(const EdgeIterator& other) const { return pos != other.pos; }
+        bool operator==(const EdgeIterator& other) const { return pos == other.pos; }
+    };
+
+    class EdgeRange {
+        const uint8_t* first;
+        const uint8_t* last;
+        double quantum;
+        int owner;
+
+        public:
+        EdgeRange(const uint8_t* first, const uint8_t* last, double quantum, int owner)
+            : first(first), last(last), quantum(quantum), owner(owner) {}
+        EdgeIterator begin() const { return EdgeIterator(first, last, quantum, owner); }
+        EdgeIterator end() const { return EdgeIterator(last, last, quantum, owner); }
+        bool empty() const { return first == last; }
+        size_t bytes() const { return static_cast<size_t>(last - first); }
+    };
+
+    CompressedGraph();
+
+    // Encode the live edges of graph. Throws std::invalid_argument if weight_quantum is not
+    // positive or a weight is negative or too large to quantize.
+    static CompressedGraph fromGraph(const Graph& graph, double weight_quantum = 1.0);
+    static CompressedGraph fromGenerated(const GeneratedGraph& graph, double weight_quantum = 1.0);
+
+    int getNumVertices() const { return num_vertices; }
+    int64_t getNumEdges() const { return num_edges; }
+    int getK() const { return k; }
+    int getT() const { return t; }
+    double getWeightQuantum() const { return weight_quantum; }
+
+    EdgeRange neighbors(int src) const {
+        const uint8_t* base = data.data();
+        return EdgeRange(base + offsets[src], base + offsets[src + 1], weight_quantum, src);
+    }
+
+    // Decoded copy with the quantized weights, lists in target order
+    Graph toGraph() const;
+
+    // Bytes of encoded edge data, and of everything the graph holds (data plus offsets)
+    size_t edgeBytes() const { return data.size(); }
+    size_t memoryBytes() const { return data.size() + offsets.size() * sizeof(uint64_t); }
+    // Same as the other graph types' memoryUsage(): the object plus allocated capacity
+    size_t memoryUsage() const {
+        return sizeof(*this) + data.capacity() + offsets.capacity() * sizeof(uint64_t);
+    }
+};
+
+#endif // COMPRESSED_GRAPH_H
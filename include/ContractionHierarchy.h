@@ -0,0 +1,99 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Graph.h"
+#include "SearchWorkspace.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arc of the hierarchy. middle is the contracted vertex a shortcut bypasses, -1 for an
+// original edge; shortcuts are unpacked recursively through it.
+struct CHArc {
+    int target;
+    double weight;
+    int middle;
+};
+
+struct CHParams {
+    // Witness searches give up after settling this many vertices. A lower limit speeds up
+    // preprocessing but may add shortcuts that are not strictly needed (never wrong ones).
+    int witness_settle_limit = 500;
+    // Priority = edge_difference_weight * (shortcuts added - arcs removed)
+    //          + contracted_neighbors_weight * (neighbours already contracted)
+    //          + level_weight * (1 + highest level among contracted neighbours)
+    int edge_difference_weight = 2;
+    int contracted_neighbors_weight = 1;
+    int level_weight = 1;
+};
+
+// Contraction Hierarchy over a static Graph. Vertices are contracted in rounds: each round
+// picks an independent set of vertices whose priority is a local minimum, computes their
+// shortcuts in parallel, then applies them. The result is deterministic for a given graph
+// and parameters regardless of the thread count.
+//
+// Only upward arcs are kept: forward arcs (v -> w) and backward arcs (w -> v, stored at v with
+// target w), both with rank[w] > rank[v].
+class ContractionHierarchy {
+    private:
+    int num_vertices;
+    std::vector<int> ranks;
+    std::vector<int64_t> forward_offsets;
+    std::vector<CHArc> forward_arcs;
+    std::vector<int64_t> backward_offsets;
+    std::vector<CHArc> backward_arcs;
+    int64_t num_shortcuts;
+
+    public:
+    ContractionHierarchy();
+
+    static ContractionHierarchy build(const Graph& graph, const CHParams& params = CHParams());
+
+    // Binary file: magic, format version, vertex count, ranks, both CSR arc arrays.
+    // Throws std::runtime_error on I/O failure or a malformed/incompatible file, including
+    // counts larger than the file, ranks that are not a permutation, and arcs or shortcut
+    // middles out of rank order.
+    void save(const std::string& path) const;
+    static ContractionHierarchy load(const std::string& path);
+
+    int getNumVertices() const;
+    int64_t getNumShortcuts() const;
+    int64_t getNumArcs() const;
+    int getRank(int v) const;
+
+    const CHArc* forwardBegin(int v) const { return forward_arcs.data() + forward_offsets[v]; }
+    const CHArc* forwardEnd(int v) const { return forward_arcs.data() + forward_offsets[v + 1]; }
+    const CHArc* backwardBegin(int v) const { return backward_arcs.data() + backward_offsets[v]; }
+    const CHArc* backwardEnd(int v) const { return backward_arcs.data() + backward_offsets[v + 1]; }
+
+    // Append the original-graph vertices strictly after `from` along the hierarchy arc
+    // from -> to (either direction in rank), expanding shortcuts recursively
+    void unpackArc(int from, int to, std::vector<int>& path) const;
+};
+
+// Bidirectional upward Dijkstra on a ContractionHierarchy. Reuses its workspaces across
+// queries, so one instance per thread answers repeated queries without O(n) resets.
+class CHQuery {
+    private:
+    const ContractionHierarchy& hierarchy;
+    SearchWorkspace forward;
+    SearchWorkspace backward;
+    int source;
+    int target;
+    int meeting_vertex;
+    double distance;
+    int settled_vertices;
+
+    public:
+    explicit CHQuery(const ContractionHierarchy& hierarchy);
+
+    // Same distance as runDijkstra(graph, source).distances[target]; max() when unreachable.
+    // Throws std::invalid_argument on out-of-range ids.
+    double run(int source, int target);
+
+    // source..target in the original graph (shortcuts unpacked); empty when unreachable
+    std::vector<int> getPath() const;
+    int getSettledCount() const;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -4,7 +4,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include "MemoryTracker.h"
 
 // Debug control - can be controlled via compile-time flag or runtime variable
 #ifndef DEBUG_ENABLED
@@ -70,7 +70,7 @@ extern bool g_debug_enabled;
 // Helper functions for printing complex data structures
 std::string vectorToString(const std::vector<int>& vec);
 std::string vectorToString(const std::vector<double>& vec);
-std::string setToString(const std::unordered_set<int>& set);
+std::string setToString(const TrackedUnorderedSet<int>& set);
 
 // Initialize debug system - call this early in main()
 void initializeDebug(int argc, char* argv[]);
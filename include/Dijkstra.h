@@ -3,12 +3,40 @@
 
 #include <vector>
 #include "Graph.h"
+#include "CSRGraph.h"
+#include "CompressedGraph.h"
+#include "Cancellation.h"
 
 struct DijkstraResults {
     std::vector<int> predecessors;
     std::vector<double> distances;
+    // false when a CancellationToken stopped the search: settled vertices are exact, the
+    // rest hold tentative (upper-bound) distances or max()
+    bool complete = true;
 };
 
-DijkstraResults runDijkstra(Graph& graph, int source);
+// Instantiated for Graph, CSRGraph<float | uint32_t | double> and CompressedGraph; distances are accumulated
+// in double whatever the stored weight type. cancel, when given, is polled every
+// StopCheck::DEFAULT_INTERVAL settled vertices.
+template <typename GraphT>
+DijkstraResults runDijkstra(const GraphT& graph, int source, const CancellationToken* cancel = nullptr);
+
+struct MultiSourceResults {
+    std::vector<double> distances;   // min over i of offsets[i] + d(sources[i], v); max() when unreached
+    std::vector<int> predecessors;   // -1 for unreached vertices and for the sources themselves
+    // Index into sources of the source whose shortest-path tree holds each vertex (its Voronoi
+    // cell), -1 when unreached. Empty unless requested. Among equally near sources, the one
+    // whose search reached the vertex first keeps it.
+    std::vector<int> origins;
+};
+
+// One Dijkstra from all sources at once, sources[i] starting at offsets[i] (all 0 when offsets
+// is empty). A source listed twice keeps its smallest offset. Uses the per-thread
+// SearchWorkspace, so the heap holds each vertex at most once. Throws std::invalid_argument on
+// out-of-range sources, an offsets/sources size mismatch or non-finite offsets.
+template <typename GraphT>
+MultiSourceResults runMultiSourceDijkstra(const GraphT& graph, const std::vector<int>& sources,
+                                          const std::vector<double>& offsets = std::vector<double>(),
+                                          bool track_origins = false);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+// |S| x |T| shortest-path distance matrix, stored row-major in one contiguous buffer.
+// Unreachable pairs hold std::numeric_limits<double>::max(), as in DijkstraResults.
+struct DistanceTable {
+    int num_sources = 0;
+    int num_targets = 0;
+    std::vector<double> distances;  // distances[i * num_targets + j] = d(sources[i], targets[j])
+
+    double at(int source_idx, int target_idx) const {
+        return distances[static_cast<size_t>(source_idx) * num_targets + target_idx];
+    }
+    const double* row(int source_idx) const {
+        return distances.data() + static_cast<size_t>(source_idx) * num_targets;
+    }
+};
+
+// Many-to-many distances. One pruned search per distinct source, run in parallel with
+// per-thread reusable workspaces; each search stops as soon as every target is settled.
+// Throws std::invalid_argument on out-of-range vertex ids.
+DistanceTable distanceTable(const Graph& graph, const std::vector<int>& sources,
+                            const std::vector<int>& targets);
+
+#endif // DISTANCE_TABLE_H
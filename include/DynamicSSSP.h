@@ -0,0 +1,53 @@
+#ifndef DYNAMIC_SSSP_H
+#define DYNAMIC_SSSP_H
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include <limits>
+#include <vector>
+
+// One change to the src -> dest edge. weight == max() (or infinity) removes the edge;
+// otherwise the edge's weight is set, inserting the edge if it does not exist yet.
+struct EdgeUpdate {
+    int src;
+    int dest;
+    double weight;
+};
+
+// Single-source shortest paths kept up to date while the graph changes. After a batch of
+// updates only the affected vertices are repaired, in the style of Ramalingam-Reps:
+// 1. vertices whose shortest-path-tree edge got heavier or disappeared, and their tree
+//    descendants, forget their distance and take the best offer from unaffected in-neighbours;
+// 2. edges that got lighter or were inserted seed improvements at their heads;
+// 3. one Dijkstra pass over the seeds settles the new distances.
+// The graph is mutated through this object (it enables reverse edges on it) so the two can
+// never disagree.
+class DynamicSSSP {
+    private:
+    Graph& graph;
+    int source;
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    IndexedHeap queue;
+    std::vector<char> affected;
+    int last_affected;
+
+    public:
+    // Runs the initial full search. Throws std::invalid_argument for an invalid source.
+    DynamicSSSP(Graph& graph, int source);
+
+    // Apply the batch to the graph in order, then repair. Throws std::invalid_argument for
+    // invalid ids or negative weights (before anything is changed).
+    void applyUpdates(const std::vector<EdgeUpdate>& updates);
+
+    // Discard the maintained state and search from scratch
+    void recompute();
+
+    int getSource() const;
+    const std::vector<double>& getDistances() const;
+    const std::vector<int>& getPredecessors() const;
+    // Vertices whose distance was recomputed or improved by the last applyUpdates()
+    int getLastAffectedCount() const;
+};
+
+#endif // DYNAMIC_SSSP_H
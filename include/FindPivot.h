@@ -1,18 +1,22 @@
 #ifndef FINDPIVOT_H
 #define FINDPIVOT_H
 #include "Graph.h"
-#include <unordered_set>
+#include "CSRGraph.h"
+#include "CompressedGraph.h"
+#include "MemoryTracker.h"
 #include <vector>
 
 struct FindPivotResult {
-    std::unordered_set<int> pivots;
-    std::unordered_set<int> nearby;
+    TrackedUnorderedSet<int> pivots;
+    TrackedUnorderedSet<int> nearby;
 };
 
+// GraphT is Graph, CSRGraph<float | uint32_t | double> or CompressedGraph (explicitly instantiated)
+template <typename GraphT>
 FindPivotResult findPivots(
-    Graph& graph,
+    const GraphT& graph,
     double B,  //upper bound
-    std::unordered_set<int>& S, // frontier set
+    TrackedUnorderedSet<int>& S, // frontier set
     std::vector<double>& d_hat //current best distances
 );
 
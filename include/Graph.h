@@ -1,6 +1,11 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
 #include <vector>
 // #include <iostream>
 
@@ -8,6 +13,20 @@
 struct Edge {
     int dest;
     double weight = 1.0;
+
+    // Removed edges stay in their slot as tombstones until Graph::compact(). Their weight is
+    // +infinity, so relaxation loops reject them without an extra check.
+    bool isRemoved() const { return weight == std::numeric_limits<double>::infinity(); }
+};
+
+// Stable reference to one stored edge: slot `slot` of src's outgoing list. Handles survive
+// any number of insertions and removals and are invalidated only by compaction.
+struct EdgeHandle {
+    int src = -1;
+    int slot = -1;
+    uint32_t generation = 0;
+
+    bool isValid() const { return src >= 0; }
 };
 
 class Graph {
@@ -15,12 +34,34 @@ class Graph {
     int num_vertices;
     // const float default_weight = 1.0;
     std::vector<std::vector<Edge>> adjList;
+    // Optional incoming edges in the same layout (Edge::dest holds the edge's source);
+    // empty unless enableReverseEdges() was called, then kept in sync by addEdge
+    std::vector<std::vector<Edge>> reverseAdjList;
+    // Cross links for O(1) mirroring while reverse edges are enabled: reverseSlot[u][i] is the
+    // position of adjList[u][i] in its target's incoming list, forwardSlot[v][j] the position
+    // of reverseAdjList[v][j] in its source's outgoing list
+    std::vector<std::vector<int>> reverseSlot;
+    std::vector<std::vector<int>> forwardSlot;
+    bool reverseEnabled = false;
+    size_t num_edges = 0;         // live edges
+    size_t num_tombstones = 0;
+    uint32_t generation = 0;      // bumped by compact(); handles from older layouts are stale
+    uint64_t version;             // see getVersion()
+    std::vector<char> removedVertices;   // empty until the first removeVertex()
     int k; int t;// parameters
 
+    // Throws std::invalid_argument unless handle addresses a slot of the current layout
+    void checkHandle(const EdgeHandle& handle) const;
+    // Set the stored edge and its incoming mirror to weight (infinity tombstones it)
+    void writeWeight(int src, int slot, double weight);
+    static uint64_t nextVersion();
+
     public:
     Graph(int n);
     Graph(int n, const std::vector<std::vector<int>>& edges);
     Graph(int n, const std::vector<std::vector<int>>& edges, const std::vector<double>& weights);
+    // Takes ownership of a prebuilt adjacency list (used by the bulk generators)
+    Graph(int n, std::vector<std::vector<Edge>>&& adjacency);
 
     // Copy constructor
     Graph(const Graph& other);
@@ -28,16 +69,80 @@ class Graph {
     // Assignment operator
     Graph& operator=(const Graph& other);
 
+    Graph(Graph&& other) = default;
+    Graph& operator=(Graph&& other) = default;
+
     int getNumVertices() const;
     std::vector<Edge> getConnections(int src) const;
+    // Read-only view of the outgoing edges, no copy; for hot loops (src must be valid)
+    const std::vector<Edge>& neighbors(int src) const;
     // void buildGraph(const std::vector<std::vector<Edge>>& edges, const std::vector<double>& weights);
-    void addEdge(int src, int dest, double weight = 1.0);
+    // Weights must be finite (infinity is reserved for tombstones); addEdge, setEdgeWeight and
+    // updateWeight throw std::invalid_argument otherwise. Remove edges with removeEdge().
+    EdgeHandle addEdge(int src, int dest, double weight = 1.0);
+
+    // Edit the first live src -> dest edge in place; both return false when there is none.
+    // O(out-degree).
+    bool setEdgeWeight(int src, int dest, double weight);
+    bool removeEdge(int src, int dest);
+    // Weight of the first live src -> dest edge, std::numeric_limits<double>::max() when absent
+    double getEdgeWeight(int src, int dest) const;
+
+    // Handle-based mutation, O(1) each. Stale handles (from before a compact()) and handles
+    // to removed edges throw std::invalid_argument.
+    EdgeHandle findEdge(int src, int dest) const;   // first live edge, invalid handle if none
+    bool isLive(const EdgeHandle& handle) const;
+    const Edge& getEdge(const EdgeHandle& handle) const;
+    void updateWeight(const EdgeHandle& handle, double weight);
+    void removeEdge(const EdgeHandle& handle);
+    // Tombstone every edge into and out of v and refuse new ones; the id stays allocated so
+    // result vectors keep their indexing. O(degree) with reverse edges enabled, else O(m).
+    void removeVertex(int v);
+    bool isVertexRemoved(int v) const;
+
+    // Stamp of the current edge set, drawn from a process-wide counter on construction and
+    // on every insertion, weight change or removal. Copies carry their source's stamp, so
+    // equal versions mean identical edges; result caches compare it to detect mutation.
+    uint64_t getVersion() const;
+
+    size_t getNumEdges() const;        // live edges
+    size_t getNumTombstones() const;
+    // True once tombstones take up a quarter of the stored edges
+    bool needsCompaction() const;
+
+    // Drop tombstones and rebuild the adjacency (and reverse adjacency) tightly packed.
+    // Invalidates all handles.
+    void compact();
+    // Compacted copy, leaving this graph untouched
+    Graph compacted() const;
+    // Compact an immutable snapshot on a parallel runtime worker (see Parallel.h) while the
+    // caller keeps serving from its live graph. The result reflects the snapshot only: any
+    // write made to the live graph after the snapshot was taken is not in it, and handles
+    // issued since do not carry over. Install it with adoptCompacted(), which refuses when
+    // such writes happened; the caller then snapshots again or calls compact() itself.
+    // With a single runtime thread the compaction runs before this returns.
+    static std::future<Graph> compactAsync(std::shared_ptr<const Graph> snapshot);
+    // Replace this graph with a compacted copy of one of its snapshots if its version still
+    // matches, i.e. nothing was written since the snapshot; returns false and leaves this
+    // graph untouched otherwise. Existing handles become stale as after compact().
+    bool adoptCompacted(Graph&& compacted_snapshot);
+
+    // Build the incoming adjacency (O(n + m) extra memory) needed by backward searches
+    void enableReverseEdges();
+    void disableReverseEdges();
+    bool hasReverseEdges() const;
+    // Incoming edges of dest; Edge::dest is the source vertex. Requires hasReverseEdges()
+    const std::vector<Edge>& reverseNeighbors(int dest) const;
 
     void calcK();
     void calcT();
     int getT() const;
     int getK() const;
 
+    // Bytes held by the graph: the object plus the allocated capacity of its forward and
+    // reverse adjacency, slot links and removal flags
+    size_t memoryUsage() const;
+
     void printAdjacencyList();
 
 };
@@ -0,0 +1,81 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Output of the large-scale generators, written directly in compressed sparse row form.
+// Edges of vertex v live in [offsets[v], offsets[v + 1]) of targets/weights, sorted by target.
+// Every generator is seed-deterministic: the same arguments produce the same arrays no matter
+// how many threads were used.
+struct GeneratedGraph {
+    int num_vertices = 0;
+    std::vector<int64_t> offsets;   // size num_vertices + 1
+    std::vector<int> targets;
+    std::vector<double> weights;
+    std::vector<double> x;          // vertex coordinates, empty when the generator has no geometry
+    std::vector<double> y;
+
+    int64_t getNumEdges() const;
+    bool hasCoordinates() const;
+    Graph toGraph() const;
+    // Live edges of graph, each list sorted by target; no coordinates
+    static GeneratedGraph fromGraph(const Graph& graph);
+
+    // Binary file: magic "FDGR", format version, n, m, then the arrays as stored (host byte
+    // order), coordinates included when present. Both throw std::runtime_error on I/O
+    // failure; load also rejects truncated or inconsistent files, counts larger than the
+    // file can hold, and weights that are negative, NaN or infinite.
+    void save(const std::string& path) const;
+    static GeneratedGraph load(const std::string& path);
+};
+
+// R-MAT recursive matrix parameters; d = 1 - a - b - c
+struct RMATParams {
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+    double noise = 0.1;               // per-level multiplicative jitter on a, b, c, d (fixed per graph)
+    double min_weight = 1.0;
+    double max_weight = 100.0;
+    bool allow_self_loops = false;
+    bool remove_duplicate_edges = false;  // keep the lightest copy of parallel edges
+};
+
+struct GeometricParams {
+    double weight_scale = 1000.0;     // edge weight = euclidean length * weight_scale
+};
+
+struct RoadGridParams {
+    double jitter = 0.3;              // coordinate perturbation, in grid cells
+    double drop_probability = 0.05;   // chance a street segment is missing
+    double diagonal_probability = 0.02;
+    int highway_spacing = 16;         // every n-th row/column is a fast road (0 disables)
+    double highway_speed = 3.0;       // speed multiplier on highway segments
+    double congestion = 0.2;          // max relative weight noise per segment
+    double weight_scale = 100.0;      // edge weight = length * weight_scale / speed
+};
+
+// Power-law graph from the R-MAT model. num_vertices need not be a power of two;
+// ids past num_vertices are redrawn.
+GeneratedGraph generateRMAT(int num_vertices, int64_t num_edges, uint64_t seed,
+                            const RMATParams& params = RMATParams());
+
+// Graph500-style Kronecker graph: 2^scale vertices, edge_factor * 2^scale edges,
+// with vertex labels scrambled by a seeded permutation.
+GeneratedGraph generateKronecker(int scale, int edge_factor, uint64_t seed,
+                                 const RMATParams& params = RMATParams());
+
+// Random geometric graph in the unit square: both directions of every pair closer than radius.
+// Throws std::invalid_argument unless radius is finite and positive.
+GeneratedGraph generateRandomGeometric(int num_vertices, double radius, uint64_t seed,
+                                       const GeometricParams& params = GeometricParams());
+
+// Road-like network: perturbed rows x cols grid with missing segments, occasional diagonals and
+// periodic highways. Edges are bidirectional with symmetric weights.
+GeneratedGraph generateRoadGrid(int rows, int cols, uint64_t seed,
+                                const RoadGridParams& params = RoadGridParams());
+
+#endif // GRAPH_GENERATORS_H
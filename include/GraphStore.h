@@ -0,0 +1,54 @@
+#ifndef GRAPH_STORE_H
+#define GRAPH_STORE_H
+
+#include "Graph.h"
+#include "DynamicSSSP.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Publishes immutable Graph versions to concurrent readers, read-copy-update style. A Graph
+// is safe to share between threads only while nobody mutates it; the store guarantees that
+// by never mutating a published version. Readers take snapshot() and query it for as long as
+// they like. Writers build the next version off to the side, as a copy of the current one
+// with the changes applied, and publish it with a single atomic pointer swap. Queries never
+// wait for an update and never see a half-applied batch. Old versions are reclaimed by
+// reference counting: a version is freed when the last reader holding it lets go, which
+// plays the part of the RCU grace period. Writers are serialized among themselves.
+class GraphStore {
+    private:
+    std::shared_ptr<const Graph> current;   // read and written only via std::atomic_load/store
+    std::atomic<uint64_t> epoch;
+    std::mutex writer_mutex;
+
+    uint64_t publishLocked(std::shared_ptr<const Graph> next);
+
+    public:
+    explicit GraphStore(Graph initial);
+    // Throws std::invalid_argument on a null graph
+    explicit GraphStore(std::shared_ptr<const Graph> initial);
+    GraphStore(const GraphStore&) = delete;
+    GraphStore& operator=(const GraphStore&) = delete;
+
+    // The current version; lock-free with respect to writers
+    std::shared_ptr<const Graph> snapshot() const;
+    // Versions published since construction
+    uint64_t getEpoch() const;
+
+    // Replace the current version; returns the new epoch
+    uint64_t publish(Graph next);
+    // Copy the current version, let mutate change the copy, publish it. mutate runs under the
+    // writer lock while readers carry on with the old version; if it throws, nothing is
+    // published.
+    uint64_t update(const std::function<void(Graph&)>& mutate);
+    // update() with DynamicSSSP's semantics per entry: a weight >= max() removes the first
+    // src -> dest edge, a missing edge is inserted, an existing one reweighted. Throws
+    // std::invalid_argument for invalid ids or negative weights before anything is changed.
+    // The new version is compacted when tombstones take up a quarter of its edges.
+    uint64_t applyUpdates(const std::vector<EdgeUpdate>& updates);
+};
+
+#endif // GRAPH_STORE_H
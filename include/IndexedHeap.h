@@ -0,0 +1,47 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 4-ary min-heap over vertex ids 0..capacity-1 with O(1) membership lookup and in-place
+// decrease-key, so each vertex occupies at most one slot (no stale entries, unlike the
+// lazy-deletion std::priority_queue used by runDijkstra).
+class IndexedHeap {
+    private:
+    struct Entry {
+        double key;
+        int vertex;
+    };
+
+    std::vector<Entry> heap;
+    std::vector<int> position;  // index into heap, -1 when absent
+
+    void siftUp(size_t idx);
+    void siftDown(size_t idx);
+
+    public:
+    explicit IndexedHeap(int capacity = 0);
+
+    void resize(int capacity);
+    int capacity() const;
+    bool empty() const;
+    size_t size() const;
+    bool contains(int vertex) const;
+    double getKey(int vertex) const;
+
+    // Insert the vertex, or lower its key if already present. Returns false when the
+    // vertex is present with a key <= key.
+    bool pushOrDecrease(int vertex, double key);
+    std::pair<int, double> top() const;
+    std::pair<int, double> pop();
+
+    // O(size()) reset; capacity is kept
+    void clear();
+
+    // Bytes held by the heap, allocated capacity included
+    size_t memoryUsage() const;
+};
+
+#endif // INDEXED_HEAP_H
@@ -0,0 +1,94 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "Graph.h"
+#include "SearchWorkspace.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class LandmarkStrategy {
+    FARTHEST,   // each landmark maximises its distance to the ones already chosen
+    AVOID       // Goldberg-Werneck: descend into the shortest-path-tree region the current
+                // landmarks cover worst
+};
+
+enum class LandmarkPrecision {
+    FLOAT32,
+    FLOAT16     // half the memory; bounds stay admissible, just slightly looser
+};
+
+struct LandmarkParams {
+    int num_landmarks = 16;
+    LandmarkStrategy strategy = LandmarkStrategy::AVOID;
+    LandmarkPrecision precision = LandmarkPrecision::FLOAT32;
+    uint64_t seed = 42;
+};
+
+// ALT preprocessing: for every landmark L, the exact distances d(L, v) and d(v, L) to all
+// vertices, from one forward and one backward runDijkstra per landmark. Tables are stored
+// vertex-major (all landmarks of a vertex are adjacent) in float32 or float16. Values are
+// rounded down on store and the subtracted term is taken at its next representable value,
+// so every bound remains a true lower bound. Cheap to rebuild when weights change.
+class LandmarkIndex {
+    private:
+    int num_vertices;
+    std::vector<int> landmarks;
+    LandmarkPrecision precision;
+    double half_scale;   // FLOAT16 values are stored as d / half_scale (a power of two)
+    std::vector<float> from_landmark32;   // [v * k + l] = d(landmarks[l], v)
+    std::vector<float> to_landmark32;     // [v * k + l] = d(v, landmarks[l])
+    std::vector<uint16_t> from_landmark16;
+    std::vector<uint16_t> to_landmark16;
+
+    void fromLandmark(int v, int l, double& lower, double& upper) const;
+    void toLandmark(int v, int l, double& lower, double& upper) const;
+
+    public:
+    LandmarkIndex();
+
+    // Throws std::invalid_argument for num_landmarks < 1
+    static LandmarkIndex build(const Graph& graph, const LandmarkParams& params = LandmarkParams());
+
+    int getNumVertices() const;
+    int getNumLandmarks() const;
+    const std::vector<int>& getLandmarks() const;
+    LandmarkPrecision getPrecision() const;
+    size_t tableBytes() const;
+
+    // Lower bound on d(v, target) from landmarks[active[0..count)], via the triangle
+    // inequality in both directions. max() when v provably cannot reach target.
+    double lowerBound(int v, int target, const int* active, int count) const;
+    double lowerBound(int v, int target) const;
+
+    // Up to max_count landmark indices giving the tightest bound for d(source, target)
+    std::vector<int> selectActive(int source, int target, int max_count) const;
+};
+
+// A* with landmark potentials. Each query bounds with the few landmarks that give the best
+// source/target estimate, like the usual ALT implementations.
+class ALTQuery {
+    private:
+    const Graph& graph;
+    const LandmarkIndex& index;
+    int max_active;
+    SearchWorkspace workspace;
+    std::vector<double> potentials;   // valid for vertices reached by the current search
+    std::vector<int> active;
+    int source;
+    int target;
+    double distance;
+    int settled_vertices;
+
+    public:
+    ALTQuery(const Graph& graph, const LandmarkIndex& index, int max_active = 4);
+
+    // Same distance as runDijkstra(graph, source).distances[target]; max() when unreachable.
+    // Throws std::invalid_argument on out-of-range ids or an index built for another graph size.
+    double run(int source, int target);
+
+    std::vector<int> getPath() const;   // source..target; empty when unreachable
+    int getSettledCount() const;
+};
+
+#endif // LANDMARKS_H
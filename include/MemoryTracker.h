@@ -0,0 +1,127 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Byte counts of the allocations made through CountingAllocator, i.e. the internal
+// containers of the algorithms (BatchHeap, runBaseCase, findPivots and the working sets of
+// each runBMSSP level). Per-thread counts are
+// always kept, so MemoryScope can report the peak of one query even while other threads run
+// queries of their own; they cost one thread-local add per allocation. The process-wide
+// counts (current and high-water mark) are shared by every thread, so they are opt-in:
+// setEnabled(true) turns them on, otherwise currentBytes() and peakBytes() stay at zero and
+// no allocation writes to shared memory. Enable them before creating the containers to be
+// counted; a container that lives across a toggle skews currentBytes() by its size.
+class MemoryTracker {
+    private:
+    static inline std::atomic<bool> global_enabled{false};
+    static inline std::atomic<int64_t> global_current{0};
+    static inline std::atomic<int64_t> global_peak{0};
+    static inline thread_local int64_t thread_current = 0;
+    static inline thread_local int64_t thread_peak = 0;
+
+    friend class MemoryScope;
+
+    public:
+    static void allocated(size_t bytes) {
+        thread_current += static_cast<int64_t>(bytes);
+        if (thread_current > thread_peak) thread_peak = thread_current;
+        if (!global_enabled.load(std::memory_order_relaxed)) return;
+        int64_t now = global_current.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+                      static_cast<int64_t>(bytes);
+        int64_t peak = global_peak.load(std::memory_order_relaxed);
+        while (now > peak && !global_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+    static void released(size_t bytes) {
+        // Memory may be freed on another thread than the one that allocated it; the
+        // per-thread count then drops below zero, which MemoryScope tolerates
+        thread_current -= static_cast<int64_t>(bytes);
+        if (!global_enabled.load(std::memory_order_relaxed)) return;
+        global_current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    // Turn the process-wide counts on or off; either way they restart from zero
+    static void setEnabled(bool enabled) {
+        global_enabled.store(enabled, std::memory_order_relaxed);
+        global_current.store(0, std::memory_order_relaxed);
+        global_peak.store(0, std::memory_order_relaxed);
+    }
+    static bool isEnabled() { return global_enabled.load(std::memory_order_relaxed); }
+
+    // Process-wide bytes currently held by tracked containers, and the most ever held
+    // since the last resetPeak(); zero unless enabled
+    static int64_t currentBytes() { return global_current.load(std::memory_order_relaxed); }
+    static int64_t peakBytes() { return global_peak.load(std::memory_order_relaxed); }
+    static void resetPeak() { global_peak.store(currentBytes(), std::memory_order_relaxed); }
+};
+
+// High-water mark of tracked allocations on this thread while the scope is alive, relative
+// to what the thread held when it opened. Scopes nest.
+class MemoryScope {
+    private:
+    int64_t baseline;
+    int64_t saved_peak;
+
+    public:
+    MemoryScope() : baseline(MemoryTracker::thread_current), saved_peak(MemoryTracker::thread_peak) {
+        MemoryTracker::thread_peak = MemoryTracker::thread_current;
+    }
+    ~MemoryScope() { MemoryTracker::thread_peak = std::max(saved_peak, MemoryTracker::thread_peak); }
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+    size_t peakBytes() const {
+        return static_cast<size_t>(std::max<int64_t>(0, MemoryTracker::thread_peak - baseline));
+    }
+};
+
+// std::allocator that reports to MemoryTracker; stateless, so containers using it behave
+// exactly like their std::allocator counterparts
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() noexcept {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        MemoryTracker::allocated(n * sizeof(T));
+        return p;
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        MemoryTracker::released(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using TrackedVector = std::vector<T, CountingAllocator<T>>;
+template <typename T>
+using TrackedList = std::list<T, CountingAllocator<T>>;
+template <typename K, typename V>
+using TrackedMap = std::map<K, V, std::less<K>, CountingAllocator<std::pair<const K, V>>>;
+template <typename K, typename V>
+using TrackedUnorderedMap =
+    std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, CountingAllocator<std::pair<const K, V>>>;
+template <typename K>
+using TrackedUnorderedSet = std::unordered_set<K, std::hash<K>, std::equal_to<K>, CountingAllocator<K>>;
+
+#endif // MEMORY_TRACKER_H
@@ -0,0 +1,136 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Log-linear (HDR-style) histogram of non-negative integers, e.g. latencies in nanoseconds.
+// Values below 2^SUB_BUCKET_BITS are exact; above that each power of two is split into
+// 2^SUB_BUCKET_BITS buckets, so any value is reported within ~3% (1/32) of its true size.
+// Fixed 15 KB footprint whatever the range. Not thread-safe; MetricsRegistry guards it.
+class LatencyHistogram {
+    public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    private:
+    std::vector<uint64_t> buckets;
+    uint64_t total;
+    uint64_t min_value;
+    uint64_t max_value;
+    double sum;
+
+    public:
+    LatencyHistogram();
+
+    static int bucketOf(uint64_t value);
+    static uint64_t bucketLow(int bucket);
+    static uint64_t bucketHigh(int bucket);   // largest value that maps to the bucket
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t min() const;   // 0 when empty
+    uint64_t max() const;
+    double mean() const;
+    // Upper edge of the bucket holding the q-quantile, clamped to [min(), max()]; q <= 0 gives min()
+    uint64_t percentile(double q) const;
+};
+
+// Counters and latency of one finished query
+struct QueryRecord {
+    std::string engine;       // entry point, e.g. "runDijkstra"
+    std::string graph;        // label from MetricsRegistry::labelGraph
+    std::string parameters;   // human-readable arguments, e.g. "source=5"
+    uint64_t latency_ns = 0;
+    bool complete = true;     // false when cancelled
+    // Per-phase counters in first-use order ("settled_vertices", "relaxed_edges", "pulls", ...)
+    std::vector<std::pair<std::string, uint64_t>> counters;
+
+    uint64_t counter(const std::string& name) const;   // 0 when absent
+};
+
+// Process-wide metrics surface. Disabled by default, when instrumented entry points pay one
+// relaxed atomic load per query and nothing else. When enabled, every top-level query lands
+// in a histogram keyed by (engine, graph) together with counter totals, and the N slowest
+// queries are kept with their parameters and counters. Thread-safe; toJson() snapshots it all.
+class MetricsRegistry {
+    private:
+    struct EngineStats {
+        LatencyHistogram latency;
+        uint64_t queries = 0;
+        uint64_t incomplete = 0;
+        std::vector<std::pair<std::string, uint64_t>> counters;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::pair<std::string, std::string>, EngineStats> stats;
+    std::map<const void*, std::string> graph_labels;
+    std::vector<QueryRecord> slowest;   // min-heap on latency_ns, at most slow_capacity
+    size_t slow_capacity;
+
+    public:
+    MetricsRegistry();
+
+    static MetricsRegistry& global();
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+
+    // Name the graph at this address in histograms and captures; unnamed graphs appear as
+    // "graph@<address>". Labels are keyed by address, so relabel a graph built in the same
+    // place as a destroyed one.
+    void labelGraph(const void* graph, const std::string& label);
+    std::string graphLabel(const void* graph) const;
+    // How many of the slowest queries to keep (default 32); shrinking drops the fastest
+    void setSlowQueryCapacity(size_t capacity);
+
+    void record(const QueryRecord& query);
+
+    // Copies, safe to use while queries keep running
+    LatencyHistogram histogram(const std::string& engine, const std::string& graph) const;
+    uint64_t queryCount(const std::string& engine, const std::string& graph) const;
+    std::vector<QueryRecord> slowQueries() const;   // slowest first
+
+    // {"engines": [{engine, graph, queries, incomplete, counters, latency_ns: {count, min,
+    //  mean, p50, p90, p99, p999, max}}], "slow_queries": [{engine, graph, parameters,
+    //  latency_ns, complete, counters}]}
+    std::string toJson() const;
+    // Forget histograms and captures; labels and capacity are kept
+    void reset();
+};
+
+// Times one query and collects its counters for the global registry. Only the outermost
+// scope on a thread is active, so recursive engines (runBMSSP) and engines built on others
+// record once, with the inner calls' counters folded in. Inactive scopes cost nothing.
+class QueryScope {
+    private:
+    QueryScope* parent;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+    QueryRecord record;
+
+    public:
+    QueryScope(const char* engine, const void* graph);
+    ~QueryScope();
+    QueryScope(const QueryScope&) = delete;
+    QueryScope& operator=(const QueryScope&) = delete;
+
+    // True when this scope will record; build parameter strings only then
+    bool isActive() const { return active; }
+    void setParameters(const std::string& parameters);
+    void setComplete(bool complete);
+
+    // Add to a counter of the active scope on this thread; no-op when there is none
+    static void count(const char* counter, uint64_t delta);
+};
+
+#endif // METRICS_H
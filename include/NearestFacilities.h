@@ -0,0 +1,51 @@
+#ifndef NEAREST_FACILITIES_H
+#define NEAREST_FACILITIES_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+struct FacilityHit {
+    int facility = -1;                                        // vertex id, -1 for an empty slot
+    double distance = std::numeric_limits<double>::max();
+};
+
+// k nearest facilities of every vertex, row-major: slots [v * k, (v + 1) * k) in increasing
+// distance. Vertices that reach fewer than k facilities have trailing empty slots.
+struct NearestFacilityTable {
+    int num_vertices = 0;
+    int k = 0;
+    std::vector<FacilityHit> hits;
+
+    const FacilityHit& at(int v, int rank) const { return hits[static_cast<size_t>(v) * k + rank]; }
+    const FacilityHit* row(int v) const { return hits.data() + static_cast<size_t>(v) * k; }
+};
+
+// k-nearest-facility queries over a fixed facility set. Distances are measured from the
+// query vertex along outgoing edges. A single query is a Dijkstra from the query vertex that
+// stops as soon as k facilities are settled, so its cost tracks the neighbourhood holding
+// those facilities rather than the whole graph; it uses the per-thread SearchWorkspace and
+// queries may run concurrently.
+class NearestFacilityQuery {
+    private:
+    const Graph& graph;
+    std::vector<char> is_facility;
+    int num_facilities;
+
+    public:
+    // Duplicate facilities count once. Throws std::invalid_argument on out-of-range ids.
+    NearestFacilityQuery(const Graph& graph, const std::vector<int>& facilities);
+
+    // Up to k hits in increasing distance (fewer when fewer are reachable). Ties between
+    // facilities at the same distance follow the search's settle order.
+    std::vector<FacilityHit> run(int source, int k) const;
+    // run() for every vertex, as one backward sweep from all facilities that labels each
+    // vertex with its k nearest. Uses the graph's reverse edges when enabled, else builds a
+    // temporary incoming adjacency. Distances match run(); ties may pick other facilities.
+    NearestFacilityTable runAll(int k) const;
+
+    int getNumFacilities() const;
+};
+
+#endif // NEAREST_FACILITIES_H
@@ -0,0 +1,82 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// All parallel work in the library runs on one shared work-stealing runtime: a pool of
+// getParallelThreads() - 1 worker threads plus whichever thread is waiting on the work.
+// Each worker owns a task deque; it pops its own newest task and, when idle, steals the
+// oldest task of another worker. Threads that wait on parallel work run queued tasks while
+// they wait, so parallel calls nest (a parallelFor body may itself call parallelFor or a
+// parallel engine) without deadlocking or oversubscribing the machine. A body that nests
+// must not hold thread-local scratch such as SearchWorkspace::threadLocal across the inner
+// call, since the waiting thread may run an unrelated task on the same scratch.
+
+class ParallelRuntime;
+
+// Number of threads used by the runtime, the caller included.
+// Defaults to std::thread::hardware_concurrency(); override with setParallelThreads()
+// or the FASTDIJKSTRA_THREADS environment variable. Changing it retires the current pool
+// once its queued work is done; call it from outside parallel regions.
+int getParallelThreads();
+void setParallelThreads(int num_threads);
+
+// Pin worker i to the (i + 1)-th CPU of the process affinity mask (Linux only; a no-op
+// elsewhere). Off by default; FASTDIJKSTRA_AFFINITY=1 turns it on. Recreates the pool.
+bool getParallelAffinity();
+void setParallelAffinity(bool enabled);
+
+struct ParallelRuntimeStats {
+    int threads = 0;            // getParallelThreads()
+    int workers = 0;            // pool threads currently running
+    uint64_t pools = 0;         // pools started since process start
+    uint64_t tasks = 0;         // queued tasks run by the current pool
+    uint64_t steals = 0;        // of which taken from another thread's deque
+};
+ParallelRuntimeStats getParallelRuntimeStats();
+
+// Split [begin, end) into chunks of at most `grain` indices and run body(chunk_begin, chunk_end)
+// on each chunk. Chunk boundaries depend only on the range and the grain, never on the thread
+// count, so callers that seed per-chunk state from the chunk index stay deterministic.
+// The first exception thrown by body is rethrown once the remaining chunks are abandoned.
+void parallelFor(size_t begin, size_t end, size_t grain,
+                 const std::function<void(size_t, size_t)>& body);
+
+// Fire-and-forget task on the runtime, e.g. background compaction. With a single thread
+// configured there is no pool to hand it to and the task runs before parallelSpawn returns.
+// Exceptions escaping task are discarded; report them through a promise.
+void parallelSpawn(std::function<void()> task);
+
+// Fork-join group of heterogeneous tasks:
+//   TaskGroup group;
+//   group.run([&] { left = build(lo, mid); });
+//   group.run([&] { right = build(mid, hi); });
+//   group.wait();
+// wait() runs queued tasks until every task of the group has finished, then rethrows the
+// first exception any of them threw. The destructor waits but swallows exceptions.
+class TaskGroup {
+    private:
+    std::shared_ptr<ParallelRuntime> runtime;
+    std::atomic<size_t> pending;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    public:
+    TaskGroup();
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+    void wait();
+};
+
+#endif // PARALLEL_H
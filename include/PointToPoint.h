@@ -0,0 +1,56 @@
+#ifndef POINT_TO_POINT_H
+#define POINT_TO_POINT_H
+
+#include "Graph.h"
+#include "SearchWorkspace.h"
+#include "SparseResult.h"
+#include "Cancellation.h"
+#include <limits>
+#include <vector>
+
+struct QueryOptions {
+    // Like BMSSP's B: only vertices with distance < distance_cap are settled, and edges
+    // leading to distances >= distance_cap are never queued
+    double distance_cap = std::numeric_limits<double>::max();
+    // Stop as soon as any one target is settled instead of waiting for all of them
+    bool stop_at_first_target = false;
+    // Polled every StopCheck::DEFAULT_INTERVAL settled vertices (PointToPointQuery only)
+    const CancellationToken* cancel = nullptr;
+};
+
+struct PointToPointResult {
+    std::vector<double> distances;  // one per requested target; max() when unreached or capped
+    int settled_vertices = 0;       // search-space size, for diagnostics
+    bool complete = true;           // false when options.cancel stopped the search early
+};
+
+// Dijkstra from one source that stops once the requested targets are settled. The query
+// owns its workspace, so repeated runs on the same graph cost O(search space) rather than
+// O(n). Paths are not materialised during the search: getPath() walks the predecessor
+// chain of the most recent run on demand.
+class PointToPointQuery {
+    private:
+    const Graph& graph;
+    SearchWorkspace workspace;
+    int source;
+
+    public:
+    explicit PointToPointQuery(const Graph& graph);
+
+    // Distance from source to target, or max() when unreachable within the cap
+    double run(int source, int target, const QueryOptions& options = QueryOptions());
+    PointToPointResult run(int source, const std::vector<int>& targets,
+                           const QueryOptions& options = QueryOptions());
+
+    // Results of the most recent run. Only settled vertices have final distances; every
+    // requested target that was reached is settled.
+    bool isSettled(int v) const;
+    double getDistance(int v) const;   // max() unless v was settled
+    // source..target inclusive; empty when target was not settled by the last run
+    std::vector<int> getPath(int target) const;
+    // Settled vertices of the most recent run, O(search space)
+    SparseResult getSparseResult() const;
+    int getSource() const;
+};
+
+#endif // POINT_TO_POINT_H
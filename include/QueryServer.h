@@ -0,0 +1,184 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include "Graph.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GraphStore;
+class PointToPointQuery;
+class SSSPCache;
+
+// Wire protocol spoken over a Unix domain stream socket. Every message is one frame; all
+// integers and doubles are in host byte order (both ends share the machine).
+//
+//   request:  uint32 payload_bytes, uint32 request_id, uint8 type,   payload
+//   response: uint32 payload_bytes, uint32 request_id, uint8 status, payload
+//
+// A client may pipeline any number of requests on one connection; responses carry the
+// request_id and may arrive out of order. status is STATUS_OK or STATUS_ERROR, in which
+// case the payload is the error message; an answer larger than the server's
+// max_response_bytes is such an error. Payloads by type:
+//
+//   INFO            -> int32 n, int64 m
+//   SSSP            int32 source, uint8 flags (bit 0: predecessors)
+//                   -> uint32 n, double distances[n], [int32 predecessors[n]]
+//   POINT_TO_POINT  int32 source, int32 target, uint8 flags (bit 0: path)
+//                   -> double distance, uint32 path_length, int32 path[path_length]
+//   DISTANCE_TABLE  uint32 ns, uint32 nt, int32 sources[ns], int32 targets[nt]
+//                   -> uint32 ns, uint32 nt, double distances[ns * nt] (row-major)
+//
+// Unreachable distances are std::numeric_limits<double>::max(), as everywhere else.
+namespace QueryProtocol {
+    enum RequestType : uint8_t { INFO = 0, SSSP = 1, POINT_TO_POINT = 2, DISTANCE_TABLE = 3 };
+    enum Status : uint8_t { STATUS_OK = 0, STATUS_ERROR = 1 };
+
+    const uint8_t FLAG_PREDECESSORS = 1;
+    const uint8_t FLAG_PATH = 1;
+    const size_t HEADER_BYTES = 9;
+}
+
+struct QueryServerOptions {
+    int num_workers = 0;                     // 0: getParallelThreads()
+    size_t max_batch = 64;                   // requests a worker takes off the queue at once
+    size_t max_request_bytes = 64u << 20;    // larger frames close the connection
+    // Larger answers are refused with STATUS_ERROR, SSSP and distance tables before they are
+    // computed. The uint32 frame length caps it at 4 GiB - 1 whatever the setting.
+    size_t max_response_bytes = 1u << 30;
+    size_t max_queued_requests = 1024;       // readers stop reading while this many wait
+    // SSSPCache budget for full trees; 0 disables it. With a cache, SSSP requests and
+    // point-to-point requests from an already cached source are answered without a search.
+    size_t cache_bytes = 0;
+};
+
+struct QueryServerStats {
+    uint64_t connections = 0;   // accepted since start()
+    uint64_t requests = 0;      // answered, errors included
+    uint64_t errors = 0;
+    uint64_t batches = 0;       // worker wake-ups that took at least one request
+    uint64_t searches = 0;      // Dijkstra searches run for SSSP and point-to-point requests
+    uint64_t cache_hits = 0;    // full trees served by the SSSP cache
+};
+
+// Keeps one graph resident and answers QueryProtocol requests on a Unix socket. An accept
+// thread hands each connection a reader thread, which parses frames into a shared queue;
+// while max_queued_requests wait there, the readers stop reading and clients block on the
+// socket. Workers drain up to max_batch requests at a time and group them: SSSP and
+// point-to-point requests with the same source share a single search (one runDijkstra, or
+// one multi-target PointToPointQuery::run), and distance tables go through distanceTable().
+// Responses are written back under a per-connection lock. Serving a fixed Graph, the graph must outlive
+// the server and must not be mutated while it runs. Serving a GraphStore, every batch runs
+// on the snapshot current when it was taken, so updates published to the store reach
+// queries without pausing them.
+class QueryServer {
+    private:
+    // One accepted socket. The fd is closed when the last reference (the server's list or a
+    // queued request) goes away, so a late response never reaches a recycled descriptor.
+    struct Connection {
+        int fd;
+        std::mutex write_mutex;
+        std::atomic<bool> finished;   // reader saw EOF or an error; joinable and reapable
+        std::thread reader;
+
+        explicit Connection(int fd);
+        ~Connection();
+    };
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        uint32_t id;
+        uint8_t type;
+        std::vector<char> payload;
+    };
+
+    const GraphStore* store;                   // null when serving a fixed graph
+    std::shared_ptr<const Graph> fixed_graph;   // non-owning
+    QueryServerOptions options;
+    std::string socket_path;
+    int listen_fd;
+
+    std::atomic<bool> running;
+    std::thread accept_thread;
+    std::vector<std::thread> workers;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_ready;
+    std::condition_variable queue_space;
+    std::deque<Request> queue;
+
+    std::mutex connections_mutex;
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    std::atomic<uint64_t> connection_count;
+    std::atomic<uint64_t> request_count;
+    std::atomic<uint64_t> error_count;
+    std::atomic<uint64_t> batch_count;
+    std::atomic<uint64_t> search_count;
+
+    // The cache serves one graph version; a batch on a newer snapshot starts a fresh one
+    mutable std::mutex cache_mutex;
+    std::shared_ptr<const Graph> cache_graph;
+    std::shared_ptr<SSSPCache> cache;
+    uint64_t retired_cache_hits;
+    uint64_t retired_cache_misses;
+
+    void acceptLoop();
+    void readLoop(std::shared_ptr<Connection> connection);
+    void workerLoop();
+    std::shared_ptr<const Graph> currentGraph() const;
+    std::shared_ptr<SSSPCache> cacheFor(const std::shared_ptr<const Graph>& graph);
+    void processBatch(std::vector<Request>& batch, const Graph& graph, PointToPointQuery& point_query,
+                      SSSPCache* cache);
+    void respond(Request& request, uint8_t status, const std::vector<char>& payload);
+
+    public:
+    explicit QueryServer(const Graph& graph, const QueryServerOptions& options = QueryServerOptions());
+    // Serve the store's current snapshot; the store must outlive the server
+    explicit QueryServer(const GraphStore& store, const QueryServerOptions& options = QueryServerOptions());
+    ~QueryServer();
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // Bind socket_path (an existing socket file there is replaced) and start serving.
+    // Throws std::runtime_error when the socket cannot be set up or the server already runs.
+    void start(const std::string& socket_path);
+    // Stop accepting, close every connection, join the workers (requests still queued are
+    // dropped) and remove the socket file. Safe to call more than once; the destructor calls it.
+    void stop();
+    bool isRunning() const;
+
+    QueryServerStats stats() const;
+};
+
+// Blocking client for one connection: each call sends a request and waits for its answer.
+// Throws std::runtime_error on connection failure and with the server's message when a
+// request is rejected (e.g. an out-of-range vertex). Not thread-safe; open one per thread.
+class QueryClient {
+    private:
+    int fd;
+    uint32_t next_id;
+
+    std::vector<char> call(uint8_t type, const std::vector<char>& payload);
+
+    public:
+    explicit QueryClient(const std::string& socket_path);
+    ~QueryClient();
+    QueryClient(const QueryClient&) = delete;
+    QueryClient& operator=(const QueryClient&) = delete;
+
+    void info(int& num_vertices, int64_t& num_edges);
+    std::vector<double> sssp(int source, std::vector<int>* predecessors = nullptr);
+    // path, when given, receives source..target inclusive (empty when unreachable)
+    double pointToPoint(int source, int target, std::vector<int>* path = nullptr);
+    // Row-major |sources| x |targets| distances
+    std::vector<double> distanceTable(const std::vector<int>& sources, const std::vector<int>& targets);
+};
+
+#endif // QUERY_SERVER_H
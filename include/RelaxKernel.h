@@ -0,0 +1,83 @@
+#ifndef RELAX_KERNEL_H
+#define RELAX_KERNEL_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Instruction sets the relaxation kernel can run on, in increasing order
+enum class SimdLevel {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+// Best level the CPU supports (x86 only; SCALAR elsewhere)
+SimdLevel detectSimdLevel();
+// Level in use. Defaults to detectSimdLevel(), capped by the FASTDIJKSTRA_SIMD environment
+// variable (scalar, avx2 or avx512); setSimdLevel() caps it too, e.g. to compare paths in tests.
+SimdLevel getSimdLevel();
+void setSimdLevel(SimdLevel level);
+const char* simdLevelName(SimdLevel level);
+
+// Relax one adjacency list at once: candidates[i] = base + weights[i], and the indices i with
+// candidates[i] < distances[targets[i]] (<= when allow_equal) are written to improved in
+// ascending order. Returns how many were written. candidates and improved need room for
+// count entries. Comparisons use the distances as they were before the call, so with parallel
+// edges the caller must re-check before writing.
+size_t relaxCandidates(double base, const int* targets, const double* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved);
+size_t relaxCandidates(double base, const int* targets, const float* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved);
+size_t relaxCandidates(double base, const int* targets, const uint32_t* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved);
+
+// Below this out-degree the plain loop wins over the vector setup
+const size_t SIMD_RELAX_MIN_DEGREE = 8;
+
+// Per-thread scratch for relaxOutgoing, grown to the largest degree seen
+struct RelaxScratch {
+    std::vector<double> candidates;
+    std::vector<uint32_t> improved;
+
+    static RelaxScratch& threadLocal();
+};
+
+// Call visit(v, base + w) for the out-edges of u that may improve distances[v]. visit always
+// re-checks against the live distance before writing; this only filters.
+// Graph, CompressedGraph: every edge is visited, in order.
+template <typename GraphT, typename Visit>
+void relaxOutgoing(const GraphT& graph, int u, double base, const double* distances, bool allow_equal,
+                   Visit&& visit) {
+    (void)distances;
+    (void)allow_equal;
+    for (const auto& edge : graph.neighbors(u)) visit(edge.dest, base + edge.weight);
+}
+
+// CSRGraph: high-degree lists go through the vector kernel and only improving edges are
+// visited, in order; short lists take the plain loop.
+template <typename Weight, typename Visit>
+void relaxOutgoing(const CSRGraph<Weight>& graph, int u, double base, const double* distances,
+                   bool allow_equal, Visit&& visit) {
+    typename CSRGraph<Weight>::EdgeRange edges = graph.neighbors(u);
+    if (edges.size() < SIMD_RELAX_MIN_DEGREE) {
+        for (const auto& edge : edges) visit(edge.dest, base + edge.weight);
+        return;
+    }
+    RelaxScratch& scratch = RelaxScratch::threadLocal();
+    if (scratch.candidates.size() < edges.size()) {
+        scratch.candidates.resize(edges.size());
+        scratch.improved.resize(edges.size());
+    }
+    const int* targets = edges.targetData();
+    size_t found = relaxCandidates(base, targets, edges.weightData(), edges.size(), distances, allow_equal,
+                                   scratch.candidates.data(), scratch.improved.data());
+    for (size_t i = 0; i < found; ++i) {
+        uint32_t slot = scratch.improved[i];
+        visit(targets[slot], scratch.candidates[slot]);
+    }
+}
+
+#endif // RELAX_KERNEL_H
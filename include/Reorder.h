@@ -0,0 +1,42 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "Graph.h"
+#include "GraphGenerators.h"
+#include <vector>
+
+// Vertex relabelings that put vertices touched together close together in memory
+enum class ReorderStrategy {
+    BFS,        // breadth-first visit order over the undirected graph
+    RCM,        // Reverse Cuthill-McKee from a pseudo-peripheral start: small bandwidth
+    DEGREE,     // descending total degree, so hub data shares cache lines
+    HILBERT     // position along a Hilbert curve through the vertex coordinates
+};
+
+// A relabeled graph and the maps between the two numberings
+struct ReorderResult {
+    Graph graph;
+    std::vector<int> permutation;   // permutation[old_id] = new_id
+    std::vector<int> inverse;       // inverse[new_id] = old_id
+
+    int toNew(int old_id) const { return permutation[old_id]; }
+    int toOld(int new_id) const { return inverse[new_id]; }
+
+    // Per-vertex values computed on `graph`, put back in original vertex order
+    std::vector<double> mapBack(const std::vector<double>& values) const;
+    // Predecessor array computed on `graph`: reordered and relabeled to original ids (-1 kept)
+    std::vector<int> mapPredecessorsBack(const std::vector<int>& predecessors) const;
+};
+
+// Relabel the graph by strategy. Edge lists come out sorted by target and without tombstones;
+// removed vertices and reverse adjacency carry over. HILBERT needs one (x, y) per vertex and
+// throws std::invalid_argument without them; the other strategies ignore coordinates.
+ReorderResult reorder(const Graph& graph, ReorderStrategy strategy,
+                      const std::vector<double>& x = {}, const std::vector<double>& y = {});
+// Generator output, using its coordinates when it has them
+ReorderResult reorder(const GeneratedGraph& graph, ReorderStrategy strategy);
+
+// Largest |new(u) - new(v)| over the edges of graph: the bandwidth RCM minimizes
+int permutedBandwidth(const Graph& graph, const std::vector<int>& permutation);
+
+#endif // REORDER_H
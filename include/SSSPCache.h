@@ -0,0 +1,111 @@
+#ifndef SSSP_CACHE_H
+#define SSSP_CACHE_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Completed shortest-path tree from one source, as kept by SSSPCache. Immutable once built;
+// handed out by shared_ptr so readers keep it alive after it is evicted.
+struct SSSPTree {
+    int source = -1;
+    uint64_t graph_version = 0;        // Graph::getVersion() the tree was computed on
+    // Exactly one of the two is filled: full precision, or float32 when the cache was built
+    // with float_distances (unreachable vertices are +inf there, max() when read back)
+    std::vector<double> distances;
+    std::vector<float> compact_distances;
+    std::vector<int> predecessors;     // -1 for the source and unreached vertices
+
+    bool isExact() const { return compact_distances.empty(); }
+    double distance(int v) const;      // max() when unreachable
+    // Dense distances into out (resized to n); a memcpy for exact trees
+    void copyDistances(std::vector<double>& out) const;
+    // source..target inclusive; empty when target is unreachable
+    std::vector<int> getPath(int target) const;
+    size_t memoryUsage() const;
+};
+
+struct SSSPCacheOptions {
+    size_t capacity_bytes = size_t(256) << 20;   // trees are evicted least recently used first
+    // Store distances as float32: 8 instead of 12 bytes per vertex, relative error <= 2^-24
+    bool float_distances = false;
+};
+
+struct SSSPCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;          // searches run
+    uint64_t coalesced = 0;       // lookups that waited for another thread's search of the same source
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;   // flushes after the graph changed, or invalidate()
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hitRate() const {
+        uint64_t lookups = hits + misses + coalesced;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits + coalesced) / static_cast<double>(lookups);
+    }
+};
+
+// Memory-bounded LRU cache of full SSSP results keyed by source, for workloads where a few
+// sources (depots, hubs) are asked again and again. A hit is a hash lookup that returns the
+// shared tree; a miss runs runDijkstra once, and concurrent misses on the same
+// source wait for that one search instead of repeating it. Every lookup compares the graph's
+// version with the one the entries were built on and drops them all when the graph has
+// changed, so mutation through the Graph API never serves stale trees. Lookups go through
+// QueryScope as "SSSPCache::get" with cache_hits / cache_misses counters. Thread-safe; the
+// graph must outlive the cache and must not be mutated during a lookup.
+class SSSPCache {
+    private:
+    struct Entry {
+        std::shared_ptr<const SSSPTree> tree;
+        std::list<int>::iterator position;   // in lru
+    };
+    struct Search {
+        std::shared_future<std::shared_ptr<const SSSPTree>> result;
+        uint64_t epoch;
+    };
+
+    const Graph& graph;
+    SSSPCacheOptions options;
+
+    mutable std::mutex mutex;
+    std::unordered_map<int, Entry> entries;
+    std::list<int> lru;                      // most recently used first
+    std::unordered_map<int, Search> pending;   // searches in flight, joined by concurrent misses
+    uint64_t cached_version;
+    uint64_t epoch;                          // bumped by every flush; searches begun earlier are not kept
+    size_t bytes;
+    SSSPCacheStats counters;
+
+    std::shared_ptr<const SSSPTree> compute(int source, uint64_t version) const;
+    // Callers hold mutex
+    void dropStaleLocked();
+    void flushLocked();
+    void finishLocked(int source, uint64_t search_epoch);
+    void evictLocked(size_t capacity);
+
+    public:
+    explicit SSSPCache(const Graph& graph, const SSSPCacheOptions& options = SSSPCacheOptions());
+    SSSPCache(const SSSPCache&) = delete;
+    SSSPCache& operator=(const SSSPCache&) = delete;
+
+    // Tree for source, computed on a miss. Throws std::invalid_argument on an out-of-range
+    // source. Trees larger than the whole capacity are returned but not kept.
+    std::shared_ptr<const SSSPTree> get(int source);
+    // Whether a current tree for source is cached; does not count or reorder
+    bool contains(int source) const;
+
+    void invalidate();
+    // Shrinking evicts immediately
+    void setCapacity(size_t capacity_bytes);
+    SSSPCacheStats stats() const;
+    void resetStats();
+};
+
+#endif // SSSP_CACHE_H
@@ -0,0 +1,80 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include "IndexedHeap.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Reusable per-thread state for Dijkstra-style searches. Distances and predecessors are
+// epoch-stamped, so starting a new search is O(1) instead of O(n): an entry is valid only
+// if its stamp matches the current epoch. Only vertices reached by the current search are
+// recorded in the touched list.
+class SearchWorkspace {
+    private:
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::vector<uint32_t> stamps;
+    std::vector<uint32_t> settled_stamps;  // == epoch once the vertex's distance is final
+    uint32_t epoch;
+    std::vector<int> touched;
+    IndexedHeap queue;
+
+    public:
+    explicit SearchWorkspace(int num_vertices = 0);
+
+    // Per-thread workspace sized for num_vertices; reallocated only when the size changes
+    static SearchWorkspace& threadLocal(int num_vertices);
+
+    int getNumVertices() const;
+    void resize(int num_vertices);
+
+    // Begin a new search: forgets all distances, predecessors and queue contents
+    void reset();
+
+    bool isReached(int v) const { return stamps[v] == epoch; }
+    bool isSettled(int v) const { return settled_stamps[v] == epoch; }
+    // Record that v was popped with its final distance; searches call this as they go
+    void settle(int v) { settled_stamps[v] = epoch; }
+    double getDistance(int v) const;   // std::numeric_limits<double>::max() when unreached
+    int getPredecessor(int v) const;   // -1 when unreached or a source
+
+    // Lower v's tentative distance and (re)queue it if dist improves on the current value
+    bool relax(int v, double dist, int pred) {
+        if (stamps[v] != epoch) {
+            if (dist == std::numeric_limits<double>::infinity()) return false;   // removed edge
+            stamps[v] = epoch;
+            touched.push_back(v);
+        } else if (dist >= distances[v]) {
+            return false;
+        }
+        distances[v] = dist;
+        predecessors[v] = pred;
+        queue.pushOrDecrease(v, dist);
+        return true;
+    }
+
+    // Same, but queue v under key (dist + potential for goal-directed searches). With an
+    // inconsistent potential v may be requeued after being settled.
+    bool relax(int v, double dist, int pred, double key) {
+        if (stamps[v] != epoch) {
+            if (dist == std::numeric_limits<double>::infinity()) return false;   // removed edge
+            stamps[v] = epoch;
+            touched.push_back(v);
+        } else if (dist >= distances[v]) {
+            return false;
+        }
+        distances[v] = dist;
+        predecessors[v] = pred;
+        queue.pushOrDecrease(v, key);
+        return true;
+    }
+
+    const std::vector<int>& getTouched() const;
+    IndexedHeap& getQueue();
+
+    // Bytes held by the workspace and its queue, allocated capacity included
+    size_t memoryUsage() const;
+};
+
+#endif // SEARCH_WORKSPACE_H
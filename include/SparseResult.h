@@ -0,0 +1,57 @@
+#ifndef SPARSE_RESULT_H
+#define SPARSE_RESULT_H
+
+#include "Dijkstra.h"
+#include "SearchWorkspace.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Shortest-path result holding only the vertices a search reached: parallel arrays of
+// vertex, distance and predecessor in the order the engine emitted them, plus a hash index
+// for point lookups. Size is O(reached), so local queries on large graphs never write or
+// copy n-sized arrays; toDense() expands on demand. Unreached vertices read as distance
+// std::numeric_limits<double>::max() and predecessor -1, as in DijkstraResults.
+class SparseResult {
+    private:
+    int num_vertices;
+    std::vector<int> vertices;
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    std::unordered_map<int, int> slot;   // vertex -> index into the arrays
+
+    public:
+    explicit SparseResult(int num_vertices = 0);
+
+    // Dense engine output (runDijkstra, runMultiSourceDijkstra, DynamicSSSP, the arrays
+    // passed to runBMSSP): keeps the vertices with a distance below max()
+    static SparseResult fromDense(const std::vector<double>& distances, const std::vector<int>& predecessors);
+    // Same, restricted to the listed vertices (e.g. BMSSPResult::completed_vertices), O(|vertices|)
+    static SparseResult fromDense(const std::vector<double>& distances, const std::vector<int>& predecessors,
+                                  const std::vector<int>& vertices);
+
+    // Vertices of the workspace's current search: settled ones only (final distances), or
+    // every reached one with its tentative distance. O(reached).
+    static SparseResult fromWorkspace(const SearchWorkspace& workspace, bool settled_only = true);
+
+    // Record v; a vertex added twice keeps its latest distance and predecessor
+    void add(int v, double distance, int predecessor);
+    void reserve(size_t count);
+
+    int getNumVertices() const;   // size of the graph the result belongs to
+    size_t size() const;          // reached vertices
+    bool empty() const;
+    bool contains(int v) const;
+    double getDistance(int v) const;
+    int getPredecessor(int v) const;
+    // source..target along the stored predecessors; empty unless target was reached
+    std::vector<int> getPath(int target) const;
+
+    const std::vector<int>& getVertices() const;
+    const std::vector<double>& getDistances() const;
+    const std::vector<int>& getPredecessors() const;
+
+    DijkstraResults toDense() const;
+};
+
+#endif // SPARSE_RESULT_H
@@ -0,0 +1,84 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One finished span: a Chrome trace "complete" event
+struct TraceEvent {
+    static const int MAX_ARGS = 4;
+
+    const char* name;        // string literals only; events outlive the spans that made them
+    const char* category;
+    int64_t start_ns;        // since TraceRecorder::start()
+    int64_t duration_ns;
+    int thread;              // small per-thread id in order of first event
+    int num_args;
+    const char* arg_names[MAX_ARGS];
+    double arg_values[MAX_ARGS];
+};
+
+// Optional recorder of timed spans, written in the Chrome trace-event JSON format that
+// chrome://tracing and Perfetto load. Off by default; while off a span costs one relaxed
+// atomic load. Instrumented: each runBMSSP level, runBaseCase, findPivots and
+// BatchHeap::pull/batchPrepend, with the sizes each one sees. Thread-safe.
+class TraceRecorder {
+    private:
+    mutable std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::chrono::steady_clock::time_point origin;
+    size_t max_events;
+
+    public:
+    TraceRecorder();
+
+    static TraceRecorder& global();
+    static bool isEnabled();
+
+    // Drop earlier events and record from now on, keeping at most max_events (later ones
+    // are dropped so a long run cannot exhaust memory)
+    void start(size_t max_events = 1 << 22);
+    void stop();
+    void clear();
+
+    // event.start_ns is taken as steady_clock time and stored relative to start()
+    void record(TraceEvent event);
+
+    std::vector<TraceEvent> getEvents() const;
+    size_t eventCount() const;
+
+    // {"traceEvents": [{"name", "cat", "ph": "X", "ts", "dur", "pid", "tid", "args"}],
+    //  "displayTimeUnit": "ns"}; times in microseconds as the format requires
+    std::string toJson() const;
+    // Throws std::runtime_error if the file cannot be written
+    void writeJson(const std::string& path) const;
+};
+
+// Records the enclosing scope as one event when tracing is on
+class TraceSpan {
+    private:
+    bool active;
+    std::chrono::steady_clock::time_point start;
+    TraceEvent event;
+
+    public:
+    TraceSpan(const char* name, const char* category);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    bool isActive() const { return active; }
+    // Attach a numeric argument (name must be a literal); beyond MAX_ARGS they are ignored
+    void arg(const char* name, double value) {
+        if (active && event.num_args < TraceEvent::MAX_ARGS) {
+            event.arg_names[event.num_args] = name;
+            event.arg_values[event.num_args++] = value;
+        }
+    }
+};
+
+#endif // TRACE_H
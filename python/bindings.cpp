@@ -6,17 +6,118 @@
 #include "BMSSP.h"
 #include "BatchHeap.h"
 #include "FindPivot.h"
+#include "DistanceTable.h"
+#include "NearestFacilities.h"
+#include "BoundedSSSP.h"
+#include "SparseResult.h"
+#include "Cancellation.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "MemoryTracker.h"
+#include "PointToPoint.h"
+#include "SSSPCache.h"
+#include "BidirectionalDijkstra.h"
+#include "ContractionHierarchy.h"
+#include "Landmarks.h"
+#include "DynamicSSSP.h"
+#include "Reorder.h"
+#include "CSRGraph.h"
+#include "RelaxKernel.h"
+#include "CompressedGraph.h"
 
 namespace py = pybind11;
 
+// Frozen SoA graph with the given weight type, plus the algorithm overloads that accept it
+template <typename Weight>
+void bindCSRGraph(py::module& m, const char* name) {
+    using GraphT = CSRGraph<Weight>;
+    py::class_<GraphT>(m, name)
+        .def_static("fromGraph", &GraphT::fromGraph, "Freeze the live edges of a Graph",
+                    py::arg("graph"), py::arg("weight_scale") = 1.0)
+        .def_static("fromGenerated", &GraphT::fromGenerated, "Adopt generator output",
+                    py::arg("graph"), py::arg("weight_scale") = 1.0)
+        .def("getNumVertices", &GraphT::getNumVertices)
+        .def("getNumEdges", &GraphT::getNumEdges)
+        .def("getWeightScale", &GraphT::getWeightScale)
+        .def("getOffsets", &GraphT::getOffsets)
+        .def("getTargets", &GraphT::getTargets)
+        .def("getWeights", &GraphT::getWeights)
+        .def("edgeBytes", &GraphT::edgeBytes, "Bytes of edge data streamed by a full scan")
+        .def("memoryUsage", &GraphT::memoryUsage, "Bytes held by the graph, allocated capacity included");
+
+    m.def("runDijkstra", &runDijkstra<GraphT>, py::arg("graph"), py::arg("source"),
+          py::arg("cancel") = static_cast<const CancellationToken*>(nullptr), py::call_guard<py::gil_scoped_release>());
+    m.def("runBMSSP", &runBMSSP<GraphT>, py::arg("graph"), py::arg("distances"), py::arg("predecessors"),
+          py::arg("level"), py::arg("B"), py::arg("S"), py::arg("cancel") = static_cast<const CancellationToken*>(nullptr));
+    m.def("labelGraph", [](const GraphT& graph, const std::string& label) {
+              MetricsRegistry::global().labelGraph(&graph, label);
+          }, py::arg("graph"), py::arg("label"));
+}
+
 PYBIND11_MODULE(_fastdijkstra, m) {
     m.doc() = "Fast Dijkstra and BMSSP algorithms for shortest path computation achieving O(m log^(2/3) n) complexity";
 
+    // Cooperative cancellation: cancel() from another thread, or a deadline set up front
+    py::class_<CancellationToken>(m, "CancellationToken")
+        .def(py::init<>())
+        .def(py::init([](double timeout_ms) {
+                 return new CancellationToken(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::duration<double, std::milli>(timeout_ms)));
+             }),
+             "Token that expires timeout_ms after construction", py::arg("timeout_ms"))
+        .def("cancel", &CancellationToken::cancel)
+        .def("setTimeout", [](CancellationToken& token, double timeout_ms) {
+                 token.setTimeout(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::duration<double, std::milli>(timeout_ms)));
+             }, py::arg("timeout_ms"))
+        .def("clearDeadline", &CancellationToken::clearDeadline)
+        .def("isCancelled", &CancellationToken::isCancelled)
+        .def("isExpired", &CancellationToken::isExpired)
+        .def("shouldStop", &CancellationToken::shouldStop);
+
+    // Process-wide query metrics; disabled until setMetricsEnabled(True)
+    m.def("setMetricsEnabled", &MetricsRegistry::setEnabled, py::arg("enabled"));
+    m.def("labelGraph", [](const Graph& graph, const std::string& label) {
+              MetricsRegistry::global().labelGraph(&graph, label);
+          }, "Name a graph in histograms and slow-query captures", py::arg("graph"), py::arg("label"));
+    m.def("isMetricsEnabled", &MetricsRegistry::isEnabled);
+    m.def("setSlowQueryCapacity", [](size_t capacity) { MetricsRegistry::global().setSlowQueryCapacity(capacity); },
+          py::arg("capacity"));
+    m.def("metricsJson", []() { return MetricsRegistry::global().toJson(); },
+          "Latency histograms per engine and graph plus the slowest queries, as JSON");
+    m.def("resetMetrics", []() { MetricsRegistry::global().reset(); });
+
+    // Chrome trace of the BMSSP recursion (runBMSSP levels, findPivots, BatchHeap, base cases)
+    m.def("startTrace", [](size_t max_events) { TraceRecorder::global().start(max_events); },
+          "Clear earlier events and start recording spans", py::arg("max_events") = size_t(1) << 22);
+    m.def("stopTrace", []() { TraceRecorder::global().stop(); });
+    m.def("traceJson", []() { return TraceRecorder::global().toJson(); },
+          "Recorded spans in the Chrome trace-event format (chrome://tracing, Perfetto)");
+    m.def("writeTrace", [](const std::string& path) { TraceRecorder::global().writeJson(path); }, py::arg("path"));
+
+    // Bytes held by the algorithms' internal containers (BatchHeap, base cases, findPivots);
+    // counted process-wide only after setMemoryTracking(True)
+    m.def("setMemoryTracking", &MemoryTracker::setEnabled, py::arg("enabled"),
+          "Turn the process-wide tracked-memory counts on or off (restarting them from zero)");
+    m.def("isMemoryTrackingEnabled", &MemoryTracker::isEnabled);
+    m.def("trackedMemoryBytes", &MemoryTracker::currentBytes);
+    m.def("trackedMemoryPeakBytes", &MemoryTracker::peakBytes, "High-water mark since resetTrackedMemoryPeak()");
+    m.def("resetTrackedMemoryPeak", &MemoryTracker::resetPeak);
+
     // Edge struct
     py::class_<Edge>(m, "Edge")
         .def(py::init<>())
         .def_readwrite("dest", &Edge::dest)
-        .def_readwrite("weight", &Edge::weight);
+        .def_readwrite("weight", &Edge::weight)
+        .def("isRemoved", &Edge::isRemoved, "Whether the edge is a tombstone awaiting compaction");
+
+    // Stable edge reference returned by Graph.addEdge / Graph.findEdge
+    py::class_<EdgeHandle>(m, "EdgeHandle")
+        .def(py::init<>())
+        .def_readonly("src", &EdgeHandle::src)
+        .def_readonly("slot", &EdgeHandle::slot)
+        .def_readonly("generation", &EdgeHandle::generation)
+        .def("isValid", &EdgeHandle::isValid, "Whether the handle refers to an edge at all");
 
     // Graph class
     py::class_<Graph>(m, "Graph")
@@ -31,13 +132,52 @@ PYBIND11_MODULE(_fastdijkstra, m) {
         .def("calcT", &Graph::calcT, "Calculate T parameter for BMSSP algorithm")
         .def("getT", &Graph::getT, "Get T parameter")
         .def("getK", &Graph::getK, "Get K parameter")
+        .def("memoryUsage", &Graph::memoryUsage, "Bytes held by the graph, allocated capacity included")
+        .def("enableReverseEdges", &Graph::enableReverseEdges, "Build the incoming adjacency used by backward searches")
+        .def("disableReverseEdges", &Graph::disableReverseEdges, "Drop the incoming adjacency")
+        .def("hasReverseEdges", &Graph::hasReverseEdges, "Whether incoming edges are maintained")
+        .def("reverseNeighbors", &Graph::reverseNeighbors, "Incoming edges of a vertex (Edge.dest is the source)",
+             py::arg("dest"))
+        .def("setEdgeWeight", &Graph::setEdgeWeight, "Change the weight of the first src -> dest edge",
+             py::arg("src"), py::arg("dest"), py::arg("weight"))
+        .def("removeEdge", py::overload_cast<int, int>(&Graph::removeEdge), "Remove the first src -> dest edge",
+             py::arg("src"), py::arg("dest"))
+        .def("getEdgeWeight", &Graph::getEdgeWeight, "Weight of the first src -> dest edge",
+             py::arg("src"), py::arg("dest"))
+        .def("findEdge", &Graph::findEdge, "Handle of the first live src -> dest edge",
+             py::arg("src"), py::arg("dest"))
+        .def("isLive", &Graph::isLive, "Whether a handle refers to a live edge of the current layout",
+             py::arg("handle"))
+        .def("getEdge", &Graph::getEdge, "Edge referenced by a handle", py::arg("handle"))
+        .def("updateWeight", &Graph::updateWeight, "Change the weight of the edge behind a handle in O(1)",
+             py::arg("handle"), py::arg("weight"))
+        .def("removeEdge", py::overload_cast<const EdgeHandle&>(&Graph::removeEdge),
+             "Remove the edge behind a handle in O(1)", py::arg("handle"))
+        .def("removeVertex", &Graph::removeVertex, "Remove every edge into and out of a vertex",
+             py::arg("v"))
+        .def("isVertexRemoved", &Graph::isVertexRemoved, "Whether a vertex was removed", py::arg("v"))
+        .def("getNumEdges", &Graph::getNumEdges, "Number of live edges")
+        .def("getVersion", &Graph::getVersion, "Stamp of the current edge set; changes on every mutation")
+        .def("getNumTombstones", &Graph::getNumTombstones, "Number of removed edges awaiting compaction")
+        .def("needsCompaction", &Graph::needsCompaction, "Whether tombstones take up a quarter of the edges")
+        .def("compact", &Graph::compact, "Drop tombstones in place; invalidates all handles",
+             py::call_guard<py::gil_scoped_release>())
+        .def("compacted", &Graph::compacted, "Compacted copy of the graph",
+             py::call_guard<py::gil_scoped_release>())
         .def("printAdjacencyList", &Graph::printAdjacencyList, "Print the adjacency list");
 
     // DijkstraResults struct
     py::class_<DijkstraResults>(m, "DijkstraResults")
         .def(py::init<>())
         .def_readwrite("predecessors", &DijkstraResults::predecessors)
-        .def_readwrite("distances", &DijkstraResults::distances);
+        .def_readwrite("distances", &DijkstraResults::distances)
+        .def_readwrite("complete", &DijkstraResults::complete);
+
+    py::class_<MultiSourceResults>(m, "MultiSourceResults")
+        .def(py::init<>())
+        .def_readwrite("distances", &MultiSourceResults::distances)
+        .def_readwrite("predecessors", &MultiSourceResults::predecessors)
+        .def_readwrite("origins", &MultiSourceResults::origins);
 
     // BaseCaseResults struct for BMSSP base case
     py::class_<BaseCaseResults>(m, "BaseCaseResults")
@@ -49,7 +189,8 @@ PYBIND11_MODULE(_fastdijkstra, m) {
     py::class_<BMSSPResult>(m, "BMSSPResult")
         .def(py::init<>())
         .def_readwrite("new_bound", &BMSSPResult::new_bound)
-        .def_readwrite("completed_vertices", &BMSSPResult::completed_vertices);
+        .def_readwrite("completed_vertices", &BMSSPResult::completed_vertices)
+        .def_readwrite("complete", &BMSSPResult::complete);
 
     // FindPivotResult struct for pivot selection
     py::class_<FindPivotResult>(m, "FindPivotResult")
@@ -69,16 +210,194 @@ PYBIND11_MODULE(_fastdijkstra, m) {
         .def_readwrite("vertices", &PullResults::vertices)
         .def_readwrite("new_bound", &PullResults::new_bound);
 
+    // DistanceTable struct for many-to-many queries (row-major |S| x |T|)
+    py::class_<DistanceTable>(m, "DistanceTable")
+        .def(py::init<>())
+        .def_readwrite("num_sources", &DistanceTable::num_sources)
+        .def_readwrite("num_targets", &DistanceTable::num_targets)
+        .def_readwrite("distances", &DistanceTable::distances)
+        .def("at", &DistanceTable::at, py::arg("source_idx"), py::arg("target_idx"));
+
+    // Point-to-point query options and engine
+    py::class_<QueryOptions>(m, "QueryOptions")
+        .def(py::init<>())
+        .def_readwrite("distance_cap", &QueryOptions::distance_cap)
+        .def_readwrite("stop_at_first_target", &QueryOptions::stop_at_first_target);
+
+    py::class_<PointToPointResult>(m, "PointToPointResult")
+        .def(py::init<>())
+        .def_readwrite("distances", &PointToPointResult::distances)
+        .def_readwrite("settled_vertices", &PointToPointResult::settled_vertices)
+        .def_readwrite("complete", &PointToPointResult::complete);
+
+    py::class_<PointToPointQuery>(m, "PointToPointQuery")
+        .def(py::init<const Graph&>(), py::arg("graph"), py::keep_alive<1, 2>())
+        .def("run", py::overload_cast<int, int, const QueryOptions&>(&PointToPointQuery::run),
+             py::arg("source"), py::arg("target"), py::arg("options") = QueryOptions())
+        .def("run", py::overload_cast<int, const std::vector<int>&, const QueryOptions&>(&PointToPointQuery::run),
+             py::arg("source"), py::arg("targets"), py::arg("options") = QueryOptions())
+        .def("isSettled", &PointToPointQuery::isSettled, py::arg("v"))
+        .def("getDistance", &PointToPointQuery::getDistance, py::arg("v"))
+        .def("getPath", &PointToPointQuery::getPath, py::arg("target"))
+        .def("getSparseResult", &PointToPointQuery::getSparseResult, "Settled vertices of the last run");
+
+    // LRU cache of shortest-path trees keyed by source
+    py::class_<SSSPTree, std::shared_ptr<SSSPTree>>(m, "SSSPTree")
+        .def_readonly("source", &SSSPTree::source)
+        .def_readonly("graph_version", &SSSPTree::graph_version)
+        .def_readonly("predecessors", &SSSPTree::predecessors)
+        .def("isExact", &SSSPTree::isExact)
+        .def("distance", &SSSPTree::distance, py::arg("v"))
+        .def("getDistances", [](const SSSPTree& tree) {
+            std::vector<double> distances;
+            tree.copyDistances(distances);
+            return distances;
+        })
+        .def("getPath", &SSSPTree::getPath, py::arg("target"))
+        .def("memoryUsage", &SSSPTree::memoryUsage);
+
+    py::class_<SSSPCacheOptions>(m, "SSSPCacheOptions")
+        .def(py::init<>())
+        .def_readwrite("capacity_bytes", &SSSPCacheOptions::capacity_bytes)
+        .def_readwrite("float_distances", &SSSPCacheOptions::float_distances);
+
+    py::class_<SSSPCacheStats>(m, "SSSPCacheStats")
+        .def_readonly("hits", &SSSPCacheStats::hits)
+        .def_readonly("misses", &SSSPCacheStats::misses)
+        .def_readonly("coalesced", &SSSPCacheStats::coalesced)
+        .def_readonly("evictions", &SSSPCacheStats::evictions)
+        .def_readonly("invalidations", &SSSPCacheStats::invalidations)
+        .def_readonly("entries", &SSSPCacheStats::entries)
+        .def_readonly("bytes", &SSSPCacheStats::bytes)
+        .def("hitRate", &SSSPCacheStats::hitRate);
+
+    py::class_<SSSPCache>(m, "SSSPCache")
+        .def(py::init<const Graph&, const SSSPCacheOptions&>(), py::arg("graph"),
+             py::arg("options") = SSSPCacheOptions(), py::keep_alive<1, 2>())
+        .def("get", [](SSSPCache& cache, int source) { return std::const_pointer_cast<SSSPTree>(cache.get(source)); },
+             py::arg("source"), py::call_guard<py::gil_scoped_release>())
+        .def("contains", &SSSPCache::contains, py::arg("source"))
+        .def("invalidate", &SSSPCache::invalidate)
+        .def("setCapacity", &SSSPCache::setCapacity, py::arg("capacity_bytes"))
+        .def("stats", &SSSPCache::stats)
+        .def("resetStats", &SSSPCache::resetStats);
+
+    py::class_<BidirectionalQuery>(m, "BidirectionalQuery")
+        .def(py::init<const Graph&>(), py::arg("graph"), py::keep_alive<1, 2>())
+        .def("run", &BidirectionalQuery::run,
+             py::arg("source"), py::arg("target"), py::arg("options") = QueryOptions())
+        .def("getPath", &BidirectionalQuery::getPath)
+        .def("getMeetingVertex", &BidirectionalQuery::getMeetingVertex)
+        .def("getSettledCount", &BidirectionalQuery::getSettledCount);
+
+    // Contraction Hierarchies: preprocessing, file round trip and query engine
+    py::class_<CHParams>(m, "CHParams")
+        .def(py::init<>())
+        .def_readwrite("witness_settle_limit", &CHParams::witness_settle_limit)
+        .def_readwrite("edge_difference_weight", &CHParams::edge_difference_weight)
+        .def_readwrite("contracted_neighbors_weight", &CHParams::contracted_neighbors_weight)
+        .def_readwrite("level_weight", &CHParams::level_weight);
+
+    py::class_<ContractionHierarchy>(m, "ContractionHierarchy")
+        .def_static("build", &ContractionHierarchy::build, py::arg("graph"), py::arg("params") = CHParams(),
+                    py::call_guard<py::gil_scoped_release>())
+        .def_static("load", &ContractionHierarchy::load, py::arg("path"))
+        .def("save", &ContractionHierarchy::save, py::arg("path"))
+        .def("getNumVertices", &ContractionHierarchy::getNumVertices)
+        .def("getNumShortcuts", &ContractionHierarchy::getNumShortcuts)
+        .def("getNumArcs", &ContractionHierarchy::getNumArcs)
+        .def("getRank", &ContractionHierarchy::getRank, py::arg("v"));
+
+    py::class_<CHQuery>(m, "CHQuery")
+        .def(py::init<const ContractionHierarchy&>(), py::arg("hierarchy"), py::keep_alive<1, 2>())
+        .def("run", &CHQuery::run, py::arg("source"), py::arg("target"))
+        .def("getPath", &CHQuery::getPath)
+        .def("getSettledCount", &CHQuery::getSettledCount);
+
+    // ALT landmarks and A* query
+    py::enum_<LandmarkStrategy>(m, "LandmarkStrategy")
+        .value("FARTHEST", LandmarkStrategy::FARTHEST)
+        .value("AVOID", LandmarkStrategy::AVOID);
+
+    py::enum_<LandmarkPrecision>(m, "LandmarkPrecision")
+        .value("FLOAT32", LandmarkPrecision::FLOAT32)
+        .value("FLOAT16", LandmarkPrecision::FLOAT16);
+
+    py::class_<LandmarkParams>(m, "LandmarkParams")
+        .def(py::init<>())
+        .def_readwrite("num_landmarks", &LandmarkParams::num_landmarks)
+        .def_readwrite("strategy", &LandmarkParams::strategy)
+        .def_readwrite("precision", &LandmarkParams::precision)
+        .def_readwrite("seed", &LandmarkParams::seed);
+
+    py::class_<LandmarkIndex>(m, "LandmarkIndex")
+        .def_static("build", &LandmarkIndex::build, py::arg("graph"), py::arg("params") = LandmarkParams(),
+                    py::call_guard<py::gil_scoped_release>())
+        .def("getNumLandmarks", &LandmarkIndex::getNumLandmarks)
+        .def("getLandmarks", &LandmarkIndex::getLandmarks)
+        .def("tableBytes", &LandmarkIndex::tableBytes)
+        .def("lowerBound", py::overload_cast<int, int>(&LandmarkIndex::lowerBound, py::const_),
+             py::arg("v"), py::arg("target"));
+
+    py::class_<ALTQuery>(m, "ALTQuery")
+        .def(py::init<const Graph&, const LandmarkIndex&, int>(), py::arg("graph"), py::arg("index"),
+             py::arg("max_active") = 4, py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("run", &ALTQuery::run, py::arg("source"), py::arg("target"))
+        .def("getPath", &ALTQuery::getPath)
+        .def("getSettledCount", &ALTQuery::getSettledCount);
+
+    // Incremental SSSP under edge updates
+    py::class_<EdgeUpdate>(m, "EdgeUpdate")
+        .def(py::init<int, int, double>(), py::arg("src"), py::arg("dest"), py::arg("weight"))
+        .def_readwrite("src", &EdgeUpdate::src)
+        .def_readwrite("dest", &EdgeUpdate::dest)
+        .def_readwrite("weight", &EdgeUpdate::weight);
+
+    py::class_<DynamicSSSP>(m, "DynamicSSSP")
+        .def(py::init<Graph&, int>(), py::arg("graph"), py::arg("source"), py::keep_alive<1, 2>())
+        .def("applyUpdates", &DynamicSSSP::applyUpdates, py::arg("updates"))
+        .def("recompute", &DynamicSSSP::recompute)
+        .def("getSource", &DynamicSSSP::getSource)
+        .def("getDistances", &DynamicSSSP::getDistances)
+        .def("getPredecessors", &DynamicSSSP::getPredecessors)
+        .def("getLastAffectedCount", &DynamicSSSP::getLastAffectedCount);
+
+    // Cache-friendly vertex relabeling
+    py::enum_<ReorderStrategy>(m, "ReorderStrategy")
+        .value("BFS", ReorderStrategy::BFS)
+        .value("RCM", ReorderStrategy::RCM)
+        .value("DEGREE", ReorderStrategy::DEGREE)
+        .value("HILBERT", ReorderStrategy::HILBERT);
+
+    py::class_<ReorderResult>(m, "ReorderResult")
+        .def_readonly("graph", &ReorderResult::graph)
+        .def_readonly("permutation", &ReorderResult::permutation)
+        .def_readonly("inverse", &ReorderResult::inverse)
+        .def("toNew", &ReorderResult::toNew, py::arg("old_id"))
+        .def("toOld", &ReorderResult::toOld, py::arg("new_id"))
+        .def("mapBack", &ReorderResult::mapBack, "Per-vertex values in original vertex order",
+             py::arg("values"))
+        .def("mapPredecessorsBack", &ReorderResult::mapPredecessorsBack,
+             "Predecessor array in original vertex order and ids", py::arg("predecessors"));
+
     // Main algorithm functions
-    m.def("runDijkstra", &runDijkstra,
-          "Run Dijkstra's algorithm for single-source shortest paths",
-          py::arg("graph"), py::arg("source"));
+    m.def("runDijkstra", &runDijkstra<Graph>,
+          "Run Dijkstra's algorithm for single-source shortest paths.\n"
+          "With a CancellationToken the search may stop early; check DijkstraResults.complete.",
+          py::arg("graph"), py::arg("source"), py::arg("cancel") = static_cast<const CancellationToken*>(nullptr),
+          py::call_guard<py::gil_scoped_release>());
 
-    m.def("runBaseCase", &runBaseCase,
+    m.def("runMultiSourceDijkstra", &runMultiSourceDijkstra<Graph>,
+          "Dijkstra from several sources at once, each starting at its offset.\n"
+          "With track_origins, origins[v] is the index of the source whose cell holds v.",
+          py::arg("graph"), py::arg("sources"), py::arg("offsets") = std::vector<double>(),
+          py::arg("track_origins") = false);
+
+    m.def("runBaseCase", &runBaseCase<Graph>,
           "Run base case for BMSSP algorithm using Bellman-Ford-like method",
           py::arg("graph"), py::arg("src"), py::arg("B"));
 
-    m.def("runBMSSP", &runBMSSP,
+    m.def("runBMSSP", &runBMSSP<Graph>,
           "Run BMSSP recursive algorithm achieving O(m log^(2/3) n) complexity.\n"
           "Main algorithm calls this with parameters:\n"
           "- level = ⌈(log n)/t⌉\n"
@@ -86,13 +405,122 @@ PYBIND11_MODULE(_fastdijkstra, m) {
           "- B = ∞ (infinite bound)\n"
           "The algorithm uses FindPivots and partial sorting for optimal performance.",
           py::arg("graph"), py::arg("distances"), py::arg("predecessors"),
-          py::arg("level"), py::arg("B"), py::arg("S"));
+          py::arg("level"), py::arg("B"), py::arg("S"), py::arg("cancel") = static_cast<const CancellationToken*>(nullptr));
 
-    m.def("findPivots", &findPivots,
+    m.def("findPivots", &findPivots<Graph>,
           "FindPivots procedure (Algorithm 1) - crucial for BMSSP efficiency.\n"
           "Shows that only at most |U|/k vertices of S are useful in recursive calls.",
           py::arg("graph"), py::arg("B"), py::arg("S"), py::arg("d_hat"));
 
+    // Structure-of-arrays storage with compact weights
+    bindCSRGraph<float>(m, "FloatGraph");
+    bindCSRGraph<uint32_t>(m, "UInt32Graph");
+    bindCSRGraph<double>(m, "DoubleGraph");
+
+    // Gap/varint-encoded adjacency with quantized weights
+    py::class_<CompressedGraph>(m, "CompressedGraph")
+        .def_static("fromGraph", &CompressedGraph::fromGraph, "Encode the live edges of a Graph",
+                    py::arg("graph"), py::arg("weight_quantum") = 1.0)
+        .def_static("fromGenerated", &CompressedGraph::fromGenerated, "Encode generator output",
+                    py::arg("graph"), py::arg("weight_quantum") = 1.0)
+        .def("getNumVertices", &CompressedGraph::getNumVertices)
+        .def("getNumEdges", &CompressedGraph::getNumEdges)
+        .def("getWeightQuantum", &CompressedGraph::getWeightQuantum)
+        .def("toGraph", &CompressedGraph::toGraph, "Decoded copy with the quantized weights")
+        .def("edgeBytes", &CompressedGraph::edgeBytes, "Bytes of encoded edge data")
+        .def("memoryBytes", &CompressedGraph::memoryBytes, "Edge data plus per-vertex offsets")
+        .def("memoryUsage", &CompressedGraph::memoryUsage, "Bytes held by the graph, allocated capacity included");
+
+    m.def("runDijkstra", &runDijkstra<CompressedGraph>, py::arg("graph"), py::arg("source"),
+          py::arg("cancel") = static_cast<const CancellationToken*>(nullptr), py::call_guard<py::gil_scoped_release>());
+    m.def("runBMSSP", &runBMSSP<CompressedGraph>, py::arg("graph"), py::arg("distances"), py::arg("predecessors"),
+          py::arg("level"), py::arg("B"), py::arg("S"), py::arg("cancel") = static_cast<const CancellationToken*>(nullptr));
+    m.def("labelGraph", [](const CompressedGraph& graph, const std::string& label) {
+              MetricsRegistry::global().labelGraph(&graph, label);
+          }, py::arg("graph"), py::arg("label"));
+
+    // Relaxation kernel instruction set (runtime-dispatched)
+    py::enum_<SimdLevel>(m, "SimdLevel")
+        .value("SCALAR", SimdLevel::SCALAR)
+        .value("AVX2", SimdLevel::AVX2)
+        .value("AVX512", SimdLevel::AVX512);
+
+    m.def("detectSimdLevel", &detectSimdLevel, "Best relaxation kernel the CPU supports");
+    m.def("getSimdLevel", &getSimdLevel, "Relaxation kernel in use");
+    m.def("setSimdLevel", &setSimdLevel, "Select the relaxation kernel, capped at detectSimdLevel()",
+          py::arg("level"));
+
+    m.def("distanceTable", &distanceTable,
+          "Many-to-many shortest-path distances between every source and every target.\n"
+          "Runs one target-pruned search per distinct source in parallel.",
+          py::arg("graph"), py::arg("sources"), py::arg("targets"),
+          py::call_guard<py::gil_scoped_release>());
+
+    py::class_<ReachedVertex>(m, "ReachedVertex")
+        .def_readonly("vertex", &ReachedVertex::vertex)
+        .def_readonly("distance", &ReachedVertex::distance)
+        .def_readonly("predecessor", &ReachedVertex::predecessor);
+
+    // Sparse results: only reached vertices cross the Python boundary
+    py::class_<SparseResult>(m, "SparseResult")
+        .def(py::init<int>(), py::arg("num_vertices") = 0)
+        .def_static("fromDense",
+                    py::overload_cast<const std::vector<double>&, const std::vector<int>&>(&SparseResult::fromDense),
+                    py::arg("distances"), py::arg("predecessors"))
+        .def_static("fromDense",
+                    py::overload_cast<const std::vector<double>&, const std::vector<int>&, const std::vector<int>&>(
+                        &SparseResult::fromDense),
+                    py::arg("distances"), py::arg("predecessors"), py::arg("vertices"))
+        .def("getNumVertices", &SparseResult::getNumVertices)
+        .def("__len__", &SparseResult::size)
+        .def("contains", &SparseResult::contains, py::arg("v"))
+        .def("getDistance", &SparseResult::getDistance, py::arg("v"))
+        .def("getPredecessor", &SparseResult::getPredecessor, py::arg("v"))
+        .def("getPath", &SparseResult::getPath, py::arg("target"))
+        .def("getVertices", [](const SparseResult& r) { return py::array_t<int>(r.size(), r.getVertices().data()); })
+        .def("getDistances", [](const SparseResult& r) { return py::array_t<double>(r.size(), r.getDistances().data()); })
+        .def("getPredecessors",
+             [](const SparseResult& r) { return py::array_t<int>(r.size(), r.getPredecessors().data()); })
+        .def("toDense", &SparseResult::toDense);
+
+    m.def("boundedSSSPSparse", &boundedSSSPSparse<Graph>,
+          "boundedSSSP as a SparseResult", py::arg("graph"), py::arg("sources"), py::arg("radius"));
+
+    m.def("boundedSSSP", &boundedSSSP<Graph>,
+          "Vertices closer than radius to the nearest source, as a sparse list in distance order.\n"
+          "Costs O(explored vertices), not O(n).",
+          py::arg("graph"), py::arg("sources"), py::arg("radius"));
+
+    py::class_<FacilityHit>(m, "FacilityHit")
+        .def_readonly("facility", &FacilityHit::facility)
+        .def_readonly("distance", &FacilityHit::distance);
+
+    py::class_<NearestFacilityTable>(m, "NearestFacilityTable")
+        .def_readonly("num_vertices", &NearestFacilityTable::num_vertices)
+        .def_readonly("k", &NearestFacilityTable::k)
+        .def_readonly("hits", &NearestFacilityTable::hits)
+        .def("at", &NearestFacilityTable::at, py::arg("v"), py::arg("rank"));
+
+    py::class_<NearestFacilityQuery>(m, "NearestFacilityQuery")
+        .def(py::init<const Graph&, const std::vector<int>&>(), py::arg("graph"), py::arg("facilities"),
+             py::keep_alive<1, 2>())
+        .def("run", &NearestFacilityQuery::run, "Up to k nearest facilities of source, nearest first",
+             py::arg("source"), py::arg("k"))
+        .def("runAll", &NearestFacilityQuery::runAll, "k nearest facilities of every vertex, in one backward sweep",
+             py::arg("k"), py::call_guard<py::gil_scoped_release>())
+        .def("getNumFacilities", &NearestFacilityQuery::getNumFacilities);
+
+    m.def("reorder", py::overload_cast<const Graph&, ReorderStrategy, const std::vector<double>&,
+                                       const std::vector<double>&>(&reorder),
+          "Relabel vertices (BFS, RCM, degree or Hilbert order) for memory locality.\n"
+          "HILBERT needs one (x, y) coordinate pair per vertex.",
+          py::arg("graph"), py::arg("strategy"), py::arg("x") = std::vector<double>(),
+          py::arg("y") = std::vector<double>(), py::call_guard<py::gil_scoped_release>());
+
+    m.def("permutedBandwidth", &permutedBandwidth,
+          "Largest label distance across an edge under the given permutation",
+          py::arg("graph"), py::arg("permutation"));
+
     // Version info
     m.attr("__version__") = "0.1.0";
 }
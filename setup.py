@@ -19,6 +19,28 @@ ext_modules = [
             "src/BMSSP.cpp",
             "src/BMSSPTestFramework.cpp",
             "src/Debug.cpp",
+            "src/Parallel.cpp",
+            "src/GraphGenerators.cpp",
+            "src/IndexedHeap.cpp",
+            "src/SearchWorkspace.cpp",
+            "src/DistanceTable.cpp",
+            "src/PointToPoint.cpp",
+            "src/BidirectionalDijkstra.cpp",
+            "src/ContractionHierarchy.cpp",
+            "src/Landmarks.cpp",
+            "src/DynamicSSSP.cpp",
+            "src/Reorder.cpp",
+            "src/RelaxKernel.cpp",
+            "src/CompressedGraph.cpp",
+            "src/NearestFacilities.cpp",
+            "src/BoundedSSSP.cpp",
+            "src/SparseResult.cpp",
+            "src/Cancellation.cpp",
+            "src/Metrics.cpp",
+            "src/Trace.cpp",
+            "src/QueryServer.cpp",
+            "src/SSSPCache.cpp",
+            "src/GraphStore.cpp",
         ],
         include_dirs=[
             "include",
@@ -2,16 +2,23 @@
 #include "Graph.h"
 #include "FindPivot.h"
 #include "BatchHeap.h"
+#include "RelaxKernel.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "MemoryTracker.h"
 #include "Debug.h"
 #include <queue>
 #include <vector>
-#include <unordered_set>
 #include <limits>
 #include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <utility>
 
-BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
+template <typename GraphT>
+BaseCaseResults runBaseCase(const GraphT& graph, int src, double B) {
     DEBUG_FUNCTION_ENTRY("runBaseCase", "src=" << src << ", B=" << B);
+    TraceSpan span("runBaseCase", "bmssp");
 
     int numVertices = graph.getNumVertices();
     int k = graph.getK();
@@ -19,20 +26,21 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
     DEBUG_PRINT("numVertices=" << numVertices << ", k=" << k);
     DEBUG_BOUNDS_CHECK(src, numVertices, "src");
 
-    std::vector<double> distances(numVertices, std::numeric_limits<double>::max());
-    std::vector<int> predecessors(numVertices , -1);
-    std::unordered_set<int> U;
+    TrackedVector<double> distances(numVertices, std::numeric_limits<double>::max());
+    TrackedVector<int> predecessors(numVertices , -1);
+    TrackedUnorderedSet<int> U;
 
     DEBUG_MEMORY("Allocated distances vector size=" << distances.size() << ", predecessors size=" << predecessors.size());
 
     // define pq
     using State = std::pair<double, int>;
-    std::priority_queue<State, std::vector<State>, std::greater<State>> pq;
+    std::priority_queue<State, TrackedVector<State>, std::greater<State>> pq;
 
     distances[src] = 0.0;
     pq.push({0.0, src});
 
     int settled_nodes = 0;
+    uint64_t relaxed_edges = 0;
 
     DEBUG_PRINT("Starting Dijkstra loop, target settled_nodes=" << (k + 1));
 
@@ -60,12 +68,9 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
         DEBUG_PRINT("Settled vertex=" << vertex << ", settled_nodes=" << settled_nodes);
 
         // Relax neighbors
-        for (const auto& edge : graph.getConnections(vertex)) {
-            double altWeight = edge.weight + distance;
-            int neighbor = edge.dest;
-
+        relaxOutgoing(graph, vertex, distance, distances.data(), true, [&](int neighbor, double altWeight) {
             DEBUG_BOUNDS_CHECK(neighbor, numVertices, "neighbor");
-            DEBUG_PRINT("Relaxing edge " << vertex << "->" << neighbor << ", weight=" << edge.weight << ", altWeight=" << altWeight);
+            DEBUG_PRINT("Relaxing edge " << vertex << "->" << neighbor << ", altWeight=" << altWeight);
 
             if (altWeight <= distances[neighbor] && altWeight < B) {
                 distances[neighbor] = altWeight;
@@ -73,12 +78,17 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
                 distances[neighbor] = altWeight;
                 predecessors[neighbor] = vertex;
                 pq.push({altWeight, neighbor});
+                ++relaxed_edges;
                 DEBUG_PRINT("Updated distance[" << neighbor << "]=" << altWeight);
             }
-        }
+        });
     }
 
     DEBUG_PRINT("Dijkstra loop completed. U.size()=" << U.size() << ", settled_nodes=" << settled_nodes);
+    QueryScope::count("base_cases", 1);
+    span.arg("settled", settled_nodes);
+    span.arg("relaxed", static_cast<double>(relaxed_edges));
+    QueryScope::count("relaxed_edges", relaxed_edges);
 
     // Prepare results
     BaseCaseResults results;
@@ -92,7 +102,7 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
 
         // According to the paper, we need to find the k-th smallest distance
         // among the settled vertices to get the new bound B'
-        std::vector<double> settled_distances;
+        TrackedVector<double> settled_distances;
         settled_distances.reserve(U.size());
 
         for (int v : U) {
@@ -110,7 +120,7 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
             DEBUG_PRINT("Found B_prime=" << B_prime << " as " << k << "-th smallest distance");
 
             // Create new U with vertices having distance <= B_prime
-            std::unordered_set<int> new_U;
+            TrackedUnorderedSet<int> new_U;
             for (int v : U) {
                 DEBUG_BOUNDS_CHECK(v, numVertices, "vertex in U for new_U");
                 if (distances[v] <= B_prime) {
@@ -120,7 +130,7 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
 
             DEBUG_PRINT("Created new_U with size=" << new_U.size());
             results.B = B_prime;
-            results.U = new_U;
+            results.U = std::move(new_U);
         } else {
             DEBUG_PRINT("ERROR: Invalid k=" << k << " for settled_distances.size()=" << settled_distances.size());
             results.B = B;
@@ -132,15 +142,85 @@ BaseCaseResults runBaseCase(Graph& graph, int src, double B) {
     return results;
 }
 
+namespace {
+    // The base case inside the recursion (Algorithm 2 of the paper): a Dijkstra from src that
+    // starts at its current distance and relaxes the shared distances/predecessors in place,
+    // so the vertices it returns carry their final distance for the callers above to relax
+    // from and to report. runBaseCase() above is the standalone variant on private arrays.
+    template <typename GraphT>
+    BaseCaseResults runBaseCaseInPlace(const GraphT& graph, int src, double B,
+                                       std::vector<double>& distances, std::vector<int>& predecessors) {
+        TraceSpan span("runBaseCase", "bmssp");
+        int k = graph.getK();
+
+        using State = std::pair<double, int>;
+        std::priority_queue<State, TrackedVector<State>, std::greater<State>> pq;
+        TrackedVector<int> settled;
+        TrackedUnorderedSet<int> settled_set;
+        uint64_t relaxed_edges = 0;
+
+        pq.push({distances[src], src});
+        while (!pq.empty() && static_cast<int>(settled.size()) < k + 1) {
+            double distance = pq.top().first;
+            int vertex = pq.top().second;
+            pq.pop();
+            if (distance > distances[vertex] || !settled_set.insert(vertex).second) continue;
+            settled.push_back(vertex);
+
+            relaxOutgoing(graph, vertex, distance, distances.data(), true, [&](int neighbor, double alt) {
+                if (alt <= distances[neighbor] && alt < B) {
+                    distances[neighbor] = alt;
+                    predecessors[neighbor] = vertex;
+                    pq.push({alt, neighbor});
+                    ++relaxed_edges;
+                }
+            });
+        }
+
+        QueryScope::count("base_cases", 1);
+        QueryScope::count("relaxed_edges", relaxed_edges);
+        span.arg("settled", static_cast<double>(settled.size()));
+        span.arg("relaxed", static_cast<double>(relaxed_edges));
+
+        // Up to k vertices: all complete below B. Otherwise the farthest settled distance
+        // becomes the new bound and only what lies strictly below it is complete.
+        BaseCaseResults results;
+        results.B = B;
+        if (static_cast<int>(settled.size()) <= k) {
+            results.U.insert(settled.begin(), settled.end());
+            return results;
+        }
+        double B_prime = 0.0;
+        for (int v : settled) B_prime = std::max(B_prime, distances[v]);
+        results.B = B_prime;
+        for (int v : settled) {
+            if (distances[v] < B_prime) results.U.insert(v);
+        }
+        return results;
+    }
+}
+
+template <typename GraphT>
 BMSSPResult runBMSSP(
-    Graph& graph,
+    const GraphT& graph,
     std::vector<double>& distances,
     std::vector<int>& predecessors,
     int level,
     double B,
-    const std::vector<int>& S
+    const std::vector<int>& S,
+    const CancellationToken* cancel
 ) {
     DEBUG_FUNCTION_ENTRY("runBMSSP", "level=" << level << ", B=" << B << ", S.size()=" << S.size() << ", S=" << vectorToString(S));
+    // Active only for the top-level call; the recursion adds its counters to it
+    QueryScope scope("runBMSSP", &graph);
+    TraceSpan span("runBMSSP", "bmssp");
+    span.arg("level", level);
+    span.arg("sources", static_cast<double>(S.size()));
+    if (scope.isActive()) {
+        std::ostringstream parameters;
+        parameters << "level=" << level << ", B=" << B << ", sources=" << S.size();
+        scope.setParameters(parameters.str());
+    }
 
     int k = graph.getK();
     int t = graph.getT();
@@ -166,19 +246,16 @@ BMSSPResult runBMSSP(
     if (level == 0) {
         DEBUG_PRINT("Base case: level=0, running base case for each source");
 
-        // Convert S to unordered_set for compatibility with existing base case
-        std::unordered_set<int> S_set(S.begin(), S.end());
-
         // Run base case on each source separately and combine results
         BMSSPResult result;
         result.new_bound = B;
         result.completed_vertices.clear();
 
-        std::unordered_set<int> completed_set; // Track unique completed vertices
+        TrackedUnorderedSet<int> completed_set; // Track unique completed vertices
 
         for (int src : S) {
             DEBUG_PRINT("Running base case for source=" << src);
-            BaseCaseResults base_result = runBaseCase(graph, src, B);
+            BaseCaseResults base_result = runBaseCaseInPlace(graph, src, B, distances, predecessors);
 
             DEBUG_PRINT("Base case result: B=" << base_result.B << ", U.size()=" << base_result.U.size());
 
@@ -198,6 +275,8 @@ BMSSPResult runBMSSP(
             }
         }
 
+        if (scope.isActive()) QueryScope::count("settled_vertices", result.completed_vertices.size());
+        span.arg("completed", static_cast<double>(result.completed_vertices.size()));
         DEBUG_FUNCTION_EXIT("runBMSSP [base case]", "B=" << result.new_bound << ", completed.size()=" << result.completed_vertices.size());
         return result;
     }
@@ -205,12 +284,13 @@ BMSSPResult runBMSSP(
     DEBUG_PRINT("Recursive case: level=" << level);
 
     // Find pivots (line 4)
-    std::unordered_set<int> S_set(S.begin(), S.end());
+    TrackedUnorderedSet<int> S_set(S.begin(), S.end());
     DEBUG_PRINT("Calling findPivots with B=" << B << ", S_set.size()=" << S_set.size());
 
     FindPivotResult pivot_result = findPivots(graph, B, S_set, distances);
-    std::unordered_set<int> P = pivot_result.pivots;
-    std::unordered_set<int> W = pivot_result.nearby;
+    QueryScope::count("find_pivots", 1);
+    const TrackedUnorderedSet<int>& P = pivot_result.pivots;
+    const TrackedUnorderedSet<int>& W = pivot_result.nearby;
 
     DEBUG_PRINT("findPivots result: P.size()=" << P.size() << ", W.size()=" << W.size());
     DEBUG_PRINT("P=" << setToString(P));
@@ -245,7 +325,7 @@ BMSSPResult runBMSSP(
 
     DEBUG_PRINT("Initialized B_prime_0=" << B_prime_0);
 
-    std::vector<int> U; // Will accumulate completed vertices
+    TrackedVector<int> U; // Will accumulate completed vertices
     DEBUG_MEMORY("Initialized U vector");
 
     // Main loop (line 8)
@@ -259,9 +339,18 @@ BMSSPResult runBMSSP(
 
     DEBUG_PRINT("Starting main loop with target_size=" << target_size);
 
+    bool cancelled = false;
     while (static_cast<int>(U.size()) < target_size) {
         DEBUG_LOOP(i, "U.size()=" << U.size() << ", target_size=" << target_size);
 
+        // Cooperative cancellation, once per pull: a pull plus its recursion is coarse
+        // enough that reading the clock here costs nothing measurable
+        if (cancelled || (cancel && cancel->shouldStop())) {
+            DEBUG_PRINT("Cancelled at level=" << level << " after " << i << " pulls");
+            cancelled = true;
+            break;
+        }
+
         // Check if D is empty
         PullResults pull_result;
         try {
@@ -281,8 +370,9 @@ BMSSPResult runBMSSP(
         }
 
         i++;
+        QueryScope::count("pulls", 1);
         double B_i = pull_result.new_bound;
-        std::vector<int> S_i = pull_result.vertices;
+        const std::vector<int>& S_i = pull_result.vertices;
 
         DEBUG_PRINT("Iteration " << i << ": B_i=" << B_i << ", S_i.size()=" << S_i.size());
         DEBUG_PRINT("S_i=" << vectorToString(S_i));
@@ -295,9 +385,11 @@ BMSSPResult runBMSSP(
         // Recursive call (line 11)
         DEBUG_PRINT("Making recursive call with level=" << (level-1) << ", B_i=" << B_i);
         BMSSPResult recursive_result = runBMSSP(graph, distances, predecessors,
-                                               level - 1, B_i, S_i);
+                                               level - 1, B_i, S_i, cancel);
+        // Still relax what the child finished, then stop at the top of the next iteration
+        cancelled = !recursive_result.complete;
         double B_prime_i = recursive_result.new_bound;
-        std::vector<int> U_i = recursive_result.completed_vertices;
+        const std::vector<int>& U_i = recursive_result.completed_vertices;
 
         DEBUG_PRINT("Recursive result: B_prime_i=" << B_prime_i << ", U_i.size()=" << U_i.size());
 
@@ -307,24 +399,23 @@ BMSSPResult runBMSSP(
         DEBUG_PRINT("Updated U from size " << old_U_size << " to " << U.size());
 
         // Edge relaxation and data structure updates (lines 13-21)
-        std::list<std::pair<int, double>> K;
+        TrackedList<std::pair<int, double>> K;
+        uint64_t relaxed_edges = 0;
         DEBUG_PRINT("Starting edge relaxation for " << U_i.size() << " vertices");
 
         for (int u : U_i) {
             DEBUG_BOUNDS_CHECK(u, numVertices, "vertex u in U_i");
 
-            for (const auto& edge : graph.getConnections(u)) {
-                int v = edge.dest;
-                double new_dist = distances[u] + edge.weight;
-
+            relaxOutgoing(graph, u, distances[u], distances.data(), false, [&](int v, double new_dist) {
                 DEBUG_BOUNDS_CHECK(v, numVertices, "edge destination");
-                DEBUG_PRINT("Considering edge " << u << "->" << v << ", weight=" << edge.weight << ", new_dist=" << new_dist);
+                DEBUG_PRINT("Considering edge " << u << "->" << v << ", new_dist=" << new_dist);
 
                 // Relaxation (lines 15-16)
                 if (new_dist < distances[v]) {
                     DEBUG_PRINT("Relaxing: distances[" << v << "] from " << distances[v] << " to " << new_dist);
                     distances[v] = new_dist;
                     predecessors[v] = u;
+                    ++relaxed_edges;
 
                     // Check intervals for insertion (lines 17-20)
                     if (new_dist >= B_i && new_dist < B) {
@@ -337,9 +428,11 @@ BMSSPResult runBMSSP(
                         K.push_back({v, new_dist});
                     }
                 }
-            }
+            });
         }
 
+        QueryScope::count("relaxed_edges", relaxed_edges);
+
         // Batch prepend (line 21)
         // Add vertices from S_i that are in [B'_i, B_i)
         DEBUG_PRINT("Adding vertices from S_i to K for [B_prime_i, B_i) interval");
@@ -353,7 +446,8 @@ BMSSPResult runBMSSP(
 
         if (!K.empty()) {
             DEBUG_DATASTRUCTURE("BATCHPREPEND", "K.size()=" << K.size());
-            D.batchPrepend(K);
+            D.batchPrepend(std::move(K));
+            QueryScope::count("batch_prepends", 1);
         } else {
             DEBUG_PRINT("K is empty, skipping batchPrepend");
         }
@@ -389,22 +483,48 @@ BMSSPResult runBMSSP(
     DEBUG_PRINT("Final bound computed: " << final_bound);
 
     result.new_bound = final_bound;
-    result.completed_vertices = U;
-
-    // Add vertices from W with distance <= final_bound (avoid duplicates)
-    std::unordered_set<int> completed_set(U.begin(), U.end());
-    size_t vertices_before_W = result.completed_vertices.size();
-
-    for (int x : W) {
-        DEBUG_BOUNDS_CHECK(x, numVertices, "vertex x in W");
-        if (distances[x] <= final_bound && completed_set.find(x) == completed_set.end()) {
-            result.completed_vertices.push_back(x);
-            completed_set.insert(x);
+    result.completed_vertices.assign(U.begin(), U.end());
+    result.complete = !cancelled;
+    scope.setComplete(result.complete);
+
+    // Add vertices from W with distance <= final_bound (avoid duplicates). After a cancel,
+    // final_bound comes from a partial U and W may still hold tentative distances, so only
+    // what the recursion finished is reported.
+    if (!cancelled) {
+        TrackedUnorderedSet<int> completed_set(U.begin(), U.end());
+        size_t vertices_before_W = result.completed_vertices.size();
+
+        for (int x : W) {
+            DEBUG_BOUNDS_CHECK(x, numVertices, "vertex x in W");
+            if (distances[x] <= final_bound && completed_set.find(x) == completed_set.end()) {
+                result.completed_vertices.push_back(x);
+                completed_set.insert(x);
+            }
         }
-    }
 
-    DEBUG_PRINT("Added " << (result.completed_vertices.size() - vertices_before_W) << " vertices from W");
+        DEBUG_PRINT("Added " << (result.completed_vertices.size() - vertices_before_W) << " vertices from W");
+    }
+    if (scope.isActive()) QueryScope::count("settled_vertices", result.completed_vertices.size());
+    span.arg("completed", static_cast<double>(result.completed_vertices.size()));
+    span.arg("pulls", i);
 
     DEBUG_FUNCTION_EXIT("runBMSSP", "B=" << result.new_bound << ", completed.size()=" << result.completed_vertices.size());
     return result;
-}
\ No newline at end of file
+}
+
+template BaseCaseResults runBaseCase<Graph>(const Graph&, int, double);
+template BaseCaseResults runBaseCase<FloatGraph>(const FloatGraph&, int, double);
+template BaseCaseResults runBaseCase<UInt32Graph>(const UInt32Graph&, int, double);
+template BaseCaseResults runBaseCase<DoubleGraph>(const DoubleGraph&, int, double);
+template BaseCaseResults runBaseCase<CompressedGraph>(const CompressedGraph&, int, double);
+
+template BMSSPResult runBMSSP<Graph>(const Graph&, std::vector<double>&, std::vector<int>&,
+                                     int, double, const std::vector<int>&, const CancellationToken*);
+template BMSSPResult runBMSSP<FloatGraph>(const FloatGraph&, std::vector<double>&, std::vector<int>&,
+                                          int, double, const std::vector<int>&, const CancellationToken*);
+template BMSSPResult runBMSSP<UInt32Graph>(const UInt32Graph&, std::vector<double>&, std::vector<int>&,
+                                           int, double, const std::vector<int>&, const CancellationToken*);
+template BMSSPResult runBMSSP<DoubleGraph>(const DoubleGraph&, std::vector<double>&, std::vector<int>&,
+                                           int, double, const std::vector<int>&, const CancellationToken*);
+template BMSSPResult runBMSSP<CompressedGraph>(const CompressedGraph&, std::vector<double>&, std::vector<int>&,
+                                               int, double, const std::vector<int>&, const CancellationToken*);
@@ -1,11 +1,15 @@
 #include "BMSSPTestFramework.h"
 #include "Dijkstra.h"
+#include "GraphGenerators.h"
+#include "MemoryTracker.h"
+#include "Parallel.h"
 #include "Debug.h"
 #include <iostream>
 #include <algorithm>
 #include <queue>
 #include <limits>
 #include <cmath>
+#include <ctime>
 #include <iomanip>
 #include <numeric>
 #include <random>
@@ -495,6 +499,27 @@ BMSSPTestCase BMSSPTestFramework::generateTestCase(const TestParameters& params)
             case GraphType::COMPLETE:
                 test_case.graph = generateCompleteGraph(params.num_vertices, params.weight_dist);
                 break;
+            case GraphType::RMAT: {
+                // R-MAT weights carry no structure, so they follow weight_dist like the classic types
+                GeneratedGraph rmat = generateRMAT(params.num_vertices, params.num_edges, rng());
+                for (double& weight : rmat.weights) weight = generateWeight(params.weight_dist);
+                test_case.graph = rmat.toGraph();
+                break;
+            }
+            case GraphType::RANDOM_GEOMETRIC: {
+                // Radius chosen so the expected out-degree matches num_edges / num_vertices; with
+                // no edges requested, one so small that no pair falls within it
+                double avg_degree = static_cast<double>(params.num_edges) / std::max(1, params.num_vertices);
+                double radius = std::sqrt(avg_degree / (std::acos(-1.0) * std::max(1, params.num_vertices)));
+                radius = std::max(radius, 1e-9);
+                test_case.graph = generateRandomGeometric(params.num_vertices, radius, rng()).toGraph();
+                break;
+            }
+            case GraphType::ROAD_GRID: {
+                int side = static_cast<int>(std::sqrt(params.num_vertices));
+                test_case.graph = generateRoadGrid(side, side, rng()).toGraph();
+                break;
+            }
             default:
                 test_case.graph = generateRandomGraph(params.num_vertices, params.num_edges, params.weight_dist);
         }
@@ -528,6 +553,22 @@ BMSSPTestCase BMSSPTestFramework::generateTestCase(const TestParameters& params)
     return test_case;
 }
 
+std::vector<BMSSPTestCase> BMSSPTestFramework::generateTestCases(const std::vector<TestParameters>& params) {
+    DEBUG_FUNCTION_ENTRY("generateTestCases", "params.size()=" << params.size());
+
+    std::vector<unsigned int> seeds(params.size());
+    for (auto& seed : seeds) seed = rng();
+
+    std::vector<BMSSPTestCase> cases(params.size());
+    parallelFor(0, params.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            BMSSPTestFramework generator(seeds[i]);
+            cases[i] = generator.generateTestCase(params[i]);
+        }
+    });
+    return cases;
+}
+
 // Test execution
 BMSSPTestOutput BMSSPTestFramework::executeBMSSP(const BMSSPTestCase& test_case) {
     DEBUG_FUNCTION_ENTRY("executeBMSSP", "graph.vertices=" << test_case.graph.getNumVertices() << ", sources.size=" << test_case.sources.size() << ", bound=" << test_case.bound);
@@ -586,8 +627,11 @@ BMSSPTestOutput BMSSPTestFramework::executeBMSSP(const BMSSPTestCase& test_case)
 
         DEBUG_PRINT("Calling runBMSSP with level=" << level << ", bound=" << test_case.bound << ", sources=" << vectorToString(test_case.sources));
 
+        MemoryScope memory;
         BMSSPResult result = runBMSSP(graph_copy, distances, predecessors,
                                      level, test_case.bound, test_case.sources);
+        size_t arrays_bytes = distances.capacity() * sizeof(double) + predecessors.capacity() * sizeof(int);
+        output.memory_peak_kb = (memory.peakBytes() + arrays_bytes + 1023) / 1024;
 
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
@@ -622,6 +666,21 @@ BMSSPTestOutput BMSSPTestFramework::executeBMSSP(const BMSSPTestCase& test_case)
     return output;
 }
 
+PerformanceMeasurement BMSSPTestFramework::measurePerformance(const BMSSPTestCase& test_case) {
+    PerformanceMeasurement perf = {};
+    std::clock_t cpu_start = std::clock();
+    BMSSPTestOutput output = executeBMSSP(test_case);
+    std::clock_t cpu_end = std::clock();
+
+    perf.wall_clock_time_ms = output.execution_time_ms;
+    perf.cpu_time_ms = 1000.0 * static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+    if (output.execution_success) {
+        perf.memory_peak_kb = output.memory_peak_kb;
+        perf.recursive_call_count = output.recursive_calls;
+    }
+    return perf;
+}
+
 // Verification methods
 VerificationResult BMSSPTestFramework::verifyCorrectness(const BMSSPTestCase& test_case, const BMSSPTestOutput& output) {
     VerificationResult result;
@@ -681,8 +740,6 @@ VerificationResult BMSSPTestFramework::verifyCorrectness(const BMSSPTestCase& te
 
 // Test suite generators
 std::vector<BMSSPTestCase> BMSSPTestFramework::generateCorrectnessTests() {
-    std::vector<BMSSPTestCase> tests;
-
     // Small graph tests with known solutions
     TestParameters params;
     params.num_vertices = 10;
@@ -696,24 +753,23 @@ std::vector<BMSSPTestCase> BMSSPTestFramework::generateCorrectnessTests() {
     params.t_param = 2;
     params.test_name = "Small random graph with unit weights";
 
-    tests.push_back(generateTestCase(params));
+    std::vector<TestParameters> suite;
+    suite.push_back(params);
 
     // Tree test
     params.graph_type = GraphType::TREE;
     params.test_name = "Tree graph test";
-    tests.push_back(generateTestCase(params));
+    suite.push_back(params);
 
     // Cycle test
     params.graph_type = GraphType::CYCLE;
     params.test_name = "Cycle graph test";
-    tests.push_back(generateTestCase(params));
+    suite.push_back(params);
 
-    return tests;
+    return generateTestCases(suite);
 }
 
 std::vector<BMSSPTestCase> BMSSPTestFramework::generateEdgeCaseTests() {
-    std::vector<BMSSPTestCase> tests;
-
     // Single vertex test
     TestParameters params;
     params.num_vertices = 1;
@@ -727,16 +783,17 @@ std::vector<BMSSPTestCase> BMSSPTestFramework::generateEdgeCaseTests() {
     params.t_param = 1;
     params.test_name = "Single vertex graph";
 
-    tests.push_back(generateTestCase(params));
+    std::vector<TestParameters> suite;
+    suite.push_back(params);
 
     // Zero bound test
     params.num_vertices = 5;
     params.num_edges = 8;
     params.bound_type = BoundType::ZERO;
     params.test_name = "Zero bound test";
-    tests.push_back(generateTestCase(params));
+    suite.push_back(params);
 
-    return tests;
+    return generateTestCases(suite);
 }
 
 // Simple test execution
@@ -1,4 +1,5 @@
 #include <BatchHeap.h>
+#include "Trace.h"
 #include "Debug.h"
 #include <vector>
 #include <iterator>
@@ -134,7 +135,7 @@ void BatchHeap::insert(int key, double value) {
     }
 }
 
-void BatchHeap::split(std::list<Block>::iterator block_it) {
+void BatchHeap::split(TrackedList<Block>::iterator block_it) {
     DEBUG_FUNCTION_ENTRY("BatchHeap::split", "splitting block");
 
     Block& block = *(block_it);
@@ -143,7 +144,7 @@ void BatchHeap::split(std::list<Block>::iterator block_it) {
     DEBUG_PRINT("D1.size() before split=" << D1.size() << ", D1_bound.size()=" << D1_bound.size());
 
     // copy the list to a vector for splitting
-    std::vector<std::pair<int, double>> tmp(block.block.begin(), block.block.end());
+    TrackedVector<std::pair<int, double>> tmp(block.block.begin(), block.block.end());
     auto middle_it = tmp.begin() + tmp.size() / 2;
 
     DEBUG_MEMORY("Created temporary vector for splitting, size=" << tmp.size());
@@ -206,9 +207,11 @@ void BatchHeap::split(std::list<Block>::iterator block_it) {
     DEBUG_PRINT("Split operation completed successfully");
 }
 
-void BatchHeap::batchPrepend(std::list<std::pair<int, double>> items) {
+void BatchHeap::batchPrepend(TrackedList<std::pair<int, double>> items) {
     int L = items.size();
     DEBUG_FUNCTION_ENTRY("BatchHeap::batchPrepend", "prepending " << L << " items");
+    TraceSpan span("BatchHeap::batchPrepend", "batchheap");
+    span.arg("items", L);
     DEBUG_PRINT("Current D0.size()=" << D0.size() << ", M=" << this->M << ", B=" << this->B);
 
     // Log details of first few items being prepended
@@ -228,7 +231,7 @@ void BatchHeap::batchPrepend(std::list<std::pair<int, double>> items) {
         DEBUG_PRINT("Simple case: L=" << L << " <= M=" << this->M << ", creating single block in D0");
         // Simple case: create a new block and add to beginning of D0
         Block newBlock;
-        newBlock.block = items;
+        newBlock.block.assign(items.begin(), items.end());
         newBlock.upper_bound = this->B; // Set to maximum bound for D0
         DEBUG_PRINT("Creating new block with size=" << newBlock.block.size() << ", upper_bound=" << newBlock.upper_bound);
 
@@ -250,22 +253,22 @@ void BatchHeap::batchPrepend(std::list<std::pair<int, double>> items) {
         DEBUG_PRINT("Complex case: L=" << L << " > M=" << this->M << ", need to split into multiple blocks");
         // Complex case: create O(L/M) blocks, each with at most ⌈M/2⌉ elements
         // Convert list to vector for efficient median finding
-        std::vector<std::pair<int, double>> tmp(items.begin(), items.end());
+        TrackedVector<std::pair<int, double>> tmp(items.begin(), items.end());
         DEBUG_MEMORY("Converted " << items.size() << " items to vector for splitting");
 
         int max_block_size = (this->M + 1) / 2; // ⌈M/2⌉
         DEBUG_PRINT("Max block size calculated as ⌈M/2⌉ = " << max_block_size);
 
         // Recursively split using medians until all chunks are small enough
-        std::vector<std::vector<std::pair<int, double>>> blocks_to_create;
-        std::vector<std::vector<std::pair<int, double>>> current_level;
+        TrackedVector<TrackedVector<std::pair<int, double>>> blocks_to_create;
+        TrackedVector<TrackedVector<std::pair<int, double>>> current_level;
         current_level.push_back(tmp);
         DEBUG_PRINT("Starting recursive splitting with initial chunk of size " << tmp.size());
 
         int level = 0;
         while (!current_level.empty()) {
             DEBUG_PRINT("Processing level " << level << " with " << current_level.size() << " chunks");
-            std::vector<std::vector<std::pair<int, double>>> next_level;
+            TrackedVector<TrackedVector<std::pair<int, double>>> next_level;
 
             for (size_t i = 0; i < current_level.size(); ++i) {
                 auto& chunk = current_level[i];
@@ -288,8 +291,8 @@ void BatchHeap::batchPrepend(std::list<std::pair<int, double>> items) {
                         });
 
                     // Create two sub-chunks
-                    std::vector<std::pair<int, double>> left_chunk(chunk.begin(), middle_it);
-                    std::vector<std::pair<int, double>> right_chunk(middle_it, chunk.end());
+                    TrackedVector<std::pair<int, double>> left_chunk(chunk.begin(), middle_it);
+                    TrackedVector<std::pair<int, double>> right_chunk(middle_it, chunk.end());
 
                     DEBUG_PRINT("    Split into left_chunk size=" << left_chunk.size() << ", right_chunk size=" << right_chunk.size());
 
@@ -330,12 +333,13 @@ void BatchHeap::batchPrepend(std::list<std::pair<int, double>> items) {
 
 PullResults BatchHeap::pull() {
     DEBUG_FUNCTION_ENTRY("BatchHeap::pull", "starting pull operation");
+    TraceSpan span("BatchHeap::pull", "batchheap");
     DEBUG_PRINT("Current state: D0.size()=" << D0.size() << ", D1.size()=" << D1.size() << ", M=" << this->M << ", B=" << this->B);
 
     PullResults result;
 
     // Step 1: Collect sufficient prefix of blocks from D0 and D1
-    std::vector<std::pair<int, double>> S0_prime, S1_prime;
+    TrackedVector<std::pair<int, double>> S0_prime, S1_prime;
     DEBUG_PRINT("Step 1: Collecting prefixes from D0 and D1");
 
     // Collect from D0 until we have M elements or exhaust D0
@@ -418,7 +422,7 @@ PullResults BatchHeap::pull() {
         DEBUG_PRINT("Case 2: Total collected (" << total_collected << ") > M (" << this->M << "), finding " << this->M << " smallest elements");
         // Case 2: We need to find the smallest M elements from S'0 ∪ S'1
         // Combine S'0 and S'1
-        std::vector<std::pair<int, double>> combined;
+        TrackedVector<std::pair<int, double>> combined;
         combined.reserve(total_collected);
         combined.insert(combined.end(), S0_prime.begin(), S0_prime.end());
         combined.insert(combined.end(), S1_prime.begin(), S1_prime.end());
@@ -498,5 +502,31 @@ PullResults BatchHeap::pull() {
     }
 
     DEBUG_PRINT("Pull completed: returning " << result.vertices.size() << " vertices, new_bound=" << result.new_bound);
+    span.arg("pulled", static_cast<double>(result.vertices.size()));
+    span.arg("bound", result.new_bound);
     return result;
-}
\ No newline at end of file
+}
+namespace {
+    // Node sizes of the libstdc++ containers: list nodes carry two links, tree nodes three
+    // links and a colour, hash nodes one link (std::hash<int> does not cache the hash)
+    template <typename T>
+    size_t listNodeBytes() { return 2 * sizeof(void*) + sizeof(T); }
+    template <typename T>
+    size_t treeNodeBytes() { return 4 * sizeof(void*) + sizeof(T); }
+    template <typename Map>
+    size_t hashTableBytes(const Map& map) {
+        return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(void*) + sizeof(typename Map::value_type));
+    }
+}
+
+size_t BatchHeap::memoryUsage() const {
+    size_t bytes = sizeof(*this);
+    size_t items = 0;
+    for (const Block& block : D0) items += block.block.size();
+    for (const Block& block : D1) items += block.block.size();
+    bytes += (D0.size() + D1.size()) * listNodeBytes<Block>();
+    bytes += items * listNodeBytes<std::pair<int, double>>();
+    bytes += hashTableBytes(address_book_l1_D0) + hashTableBytes(address_book_l1_D1) + hashTableBytes(address_book_l2);
+    bytes += D1_bound.size() * treeNodeBytes<std::pair<const double, TrackedList<Block>::iterator>>();
+    return bytes;
+}
@@ -0,0 +1,130 @@
+#include "BidirectionalDijkstra.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+BidirectionalQuery::BidirectionalQuery(const Graph& graph)
+    : graph(graph), forward(graph.getNumVertices()), backward(graph.getNumVertices()),
+      source(-1), target(-1), meeting_vertex(-1),
+      distance(std::numeric_limits<double>::max()), settled_vertices(0) {
+    if (!graph.hasReverseEdges()) {
+        throw std::invalid_argument("BidirectionalQuery: graph needs enableReverseEdges()");
+    }
+}
+
+double BidirectionalQuery::run(int source, int target, const QueryOptions& options) {
+    DEBUG_FUNCTION_ENTRY("BidirectionalQuery::run", "source=" << source << ", target=" << target
+                         << ", cap=" << options.distance_cap);
+
+    const double INF = std::numeric_limits<double>::max();
+    int n = graph.getNumVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("BidirectionalQuery: vertex pair (" + std::to_string(source) + ", " +
+                                    std::to_string(target) + ") out of range");
+    }
+    if (!graph.hasReverseEdges()) {
+        throw std::invalid_argument("BidirectionalQuery: reverse edges were disabled on the graph");
+    }
+
+    QueryScope scope("BidirectionalQuery::run", &graph);
+    if (scope.isActive()) {
+        scope.setParameters("source=" + std::to_string(source) + ", target=" + std::to_string(target) +
+                            ", cap=" + std::to_string(options.distance_cap));
+    }
+    uint64_t relaxed = 0;
+
+    if (forward.getNumVertices() != n) forward.resize(n);
+    if (backward.getNumVertices() != n) backward.resize(n);
+    forward.reset();
+    backward.reset();
+    this->source = source;
+    this->target = target;
+    meeting_vertex = -1;
+    distance = INF;
+    settled_vertices = 0;
+
+    if (options.distance_cap <= 0.0) return INF;
+
+    IndexedHeap& forward_queue = forward.getQueue();
+    IndexedHeap& backward_queue = backward.getQueue();
+    forward.relax(source, 0.0, -1);
+    backward.relax(target, 0.0, -1);
+
+    // best: shortest complete path seen so far (its length, not yet proven optimal)
+    double best = source == target ? 0.0 : INF;
+    if (source == target) meeting_vertex = source;
+
+    while (!forward_queue.empty() || !backward_queue.empty()) {
+        double forward_top = forward_queue.empty() ? INF : forward_queue.top().second;
+        double backward_top = backward_queue.empty() ? INF : backward_queue.top().second;
+
+        // Any path not yet seen is at least forward_top + backward_top long
+        if (forward_top == INF || backward_top == INF ||
+            forward_top + backward_top >= std::min(best, options.distance_cap)) {
+            break;
+        }
+
+        bool expand_forward = forward_top <= backward_top;
+        SearchWorkspace& self = expand_forward ? forward : backward;
+        SearchWorkspace& other = expand_forward ? backward : forward;
+
+        std::pair<int, double> top = self.getQueue().pop();
+        int u = top.first;
+        double dist = top.second;
+        self.settle(u);
+        settled_vertices++;
+
+        const std::vector<Edge>& edges = expand_forward ? graph.neighbors(u) : graph.reverseNeighbors(u);
+        for (const auto& edge : edges) {
+            double alt = dist + edge.weight;
+            if (alt >= options.distance_cap) continue;
+            if (self.relax(edge.dest, alt, u)) ++relaxed;
+
+            if (other.isReached(edge.dest)) {
+                double candidate = alt + other.getDistance(edge.dest);
+                if (candidate < best) {
+                    best = candidate;
+                    meeting_vertex = edge.dest;
+                }
+            }
+        }
+    }
+
+    if (best < options.distance_cap) {
+        distance = best;
+    } else {
+        meeting_vertex = -1;
+    }
+
+    QueryScope::count("settled_vertices", settled_vertices);
+    QueryScope::count("relaxed_edges", relaxed);
+    DEBUG_FUNCTION_EXIT("BidirectionalQuery::run", "distance=" << distance << ", meeting=" << meeting_vertex
+                        << ", settled=" << settled_vertices);
+    return distance;
+}
+
+std::vector<int> BidirectionalQuery::getPath() const {
+    std::vector<int> path;
+    if (meeting_vertex < 0) return path;
+
+    // Forward predecessors lead back to the source, backward ones on to the target
+    for (int v = meeting_vertex; v != -1; v = forward.getPredecessor(v)) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    for (int v = backward.getPredecessor(meeting_vertex); v != -1; v = backward.getPredecessor(v)) {
+        path.push_back(v);
+    }
+    return path;
+}
+
+int BidirectionalQuery::getMeetingVertex() const {
+    return meeting_vertex;
+}
+
+int BidirectionalQuery::getSettledCount() const {
+    return settled_vertices;
+}
@@ -0,0 +1,79 @@
+#include "BoundedSSSP.h"
+#include "SearchWorkspace.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Run the bounded search on the per-thread workspace and call emit(v, dist, pred) for
+    // each vertex as it is settled
+    template <typename GraphT, typename Emit>
+    void searchWithin(const GraphT& graph, const std::vector<int>& sources, double radius, Emit&& emit) {
+        int n = graph.getNumVertices();
+        if (std::isnan(radius)) throw std::invalid_argument("boundedSSSP: radius is NaN");
+        for (int s : sources) {
+            if (s < 0 || s >= n) {
+                throw std::invalid_argument("boundedSSSP: source vertex " + std::to_string(s) + " out of range");
+            }
+        }
+        DEBUG_FUNCTION_ENTRY("boundedSSSP", "sources.size()=" << sources.size() << ", radius=" << radius);
+        QueryScope scope("boundedSSSP", &graph);
+        if (scope.isActive()) {
+            scope.setParameters("sources=" + std::to_string(sources.size()) + ", radius=" + std::to_string(radius));
+        }
+        if (sources.empty() || !(radius > 0.0)) return;
+
+        SearchWorkspace& ws = SearchWorkspace::threadLocal(n);
+        IndexedHeap& queue = ws.getQueue();
+        ws.reset();
+        for (int s : sources) ws.relax(s, 0.0, -1);
+
+        // Vertices are emitted as they are settled, which is already distance order
+        uint64_t settled = 0, relaxed = 0;
+        while (!queue.empty()) {
+            std::pair<int, double> top = queue.pop();
+            int u = top.first;
+            double dist = top.second;
+            ws.settle(u);
+            ++settled;
+            emit(u, dist, ws.getPredecessor(u));
+
+            for (const auto& edge : graph.neighbors(u)) {
+                double alt = dist + edge.weight;
+                if (alt < radius && ws.relax(edge.dest, alt, u)) ++relaxed;
+            }
+        }
+        QueryScope::count("settled_vertices", settled);
+        QueryScope::count("relaxed_edges", relaxed);
+        DEBUG_FUNCTION_EXIT("boundedSSSP", "reached=" << ws.getTouched().size());
+    }
+}
+
+template <typename GraphT>
+std::vector<ReachedVertex> boundedSSSP(const GraphT& graph, const std::vector<int>& sources, double radius) {
+    std::vector<ReachedVertex> reached;
+    searchWithin(graph, sources, radius, [&](int v, double dist, int pred) { reached.push_back({v, dist, pred}); });
+    return reached;
+}
+
+template <typename GraphT>
+SparseResult boundedSSSPSparse(const GraphT& graph, const std::vector<int>& sources, double radius) {
+    SparseResult result(graph.getNumVertices());
+    searchWithin(graph, sources, radius, [&](int v, double dist, int pred) { result.add(v, dist, pred); });
+    return result;
+}
+
+template std::vector<ReachedVertex> boundedSSSP<Graph>(const Graph&, const std::vector<int>&, double);
+template std::vector<ReachedVertex> boundedSSSP<FloatGraph>(const FloatGraph&, const std::vector<int>&, double);
+template std::vector<ReachedVertex> boundedSSSP<UInt32Graph>(const UInt32Graph&, const std::vector<int>&, double);
+template std::vector<ReachedVertex> boundedSSSP<DoubleGraph>(const DoubleGraph&, const std::vector<int>&, double);
+template std::vector<ReachedVertex> boundedSSSP<CompressedGraph>(const CompressedGraph&, const std::vector<int>&,
+                                                                 double);
+
+template SparseResult boundedSSSPSparse<Graph>(const Graph&, const std::vector<int>&, double);
+template SparseResult boundedSSSPSparse<FloatGraph>(const FloatGraph&, const std::vector<int>&, double);
+template SparseResult boundedSSSPSparse<UInt32Graph>(const UInt32Graph&, const std::vector<int>&, double);
+template SparseResult boundedSSSPSparse<DoubleGraph>(const DoubleGraph&, const std::vector<int>&, double);
+template SparseResult boundedSSSPSparse<CompressedGraph>(const CompressedGraph&, const std::vector<int>&, double);
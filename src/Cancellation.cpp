@@ -0,0 +1,43 @@
+#include "Cancellation.h"
+
+namespace {
+    int64_t toTicks(std::chrono::steady_clock::time_point when) {
+        int64_t ticks = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+        return ticks != 0 ? ticks : 1;   // 0 is reserved for "no deadline"
+    }
+}
+
+CancellationToken::CancellationToken() : cancelled(false), deadline_ns(0) {}
+
+CancellationToken::CancellationToken(std::chrono::nanoseconds timeout) : CancellationToken() {
+    setTimeout(timeout);
+}
+
+void CancellationToken::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+void CancellationToken::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    deadline_ns.store(toTicks(deadline), std::memory_order_relaxed);
+}
+
+void CancellationToken::setTimeout(std::chrono::nanoseconds timeout) {
+    setDeadline(std::chrono::steady_clock::now() + timeout);
+}
+
+void CancellationToken::clearDeadline() {
+    deadline_ns.store(0, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return cancelled.load(std::memory_order_relaxed);
+}
+
+bool CancellationToken::isExpired() const {
+    int64_t deadline = deadline_ns.load(std::memory_order_relaxed);
+    return deadline != 0 && toTicks(std::chrono::steady_clock::now()) >= deadline;
+}
+
+bool CancellationToken::shouldStop() const {
+    return isCancelled() || isExpired();
+}
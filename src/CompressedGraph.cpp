@@ -0,0 +1,121 @@
+#include "CompressedGraph.h"
+#include "Parallel.h"
+#include "Debug.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    const size_t ENCODE_GRAIN = 4096;   // vertices per parallel chunk
+    // Largest quantized weight; beyond this q * quantum no longer round-trips exactly
+    const double MAX_QUANTIZED = 9007199254740992.0;   // 2^53
+
+    void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint64_t quantize(double weight, double quantum) {
+        double q = std::round(weight / quantum);
+        if (!(q >= 0.0) || q > MAX_QUANTIZED) {
+            throw std::invalid_argument("CompressedGraph: weight " + std::to_string(weight) +
+                                        " cannot be quantized with quantum " + std::to_string(quantum));
+        }
+        return static_cast<uint64_t>(q);
+    }
+}
+
+CompressedGraph::CompressedGraph()
+    : num_vertices(0), num_edges(0), offsets(1, 0), weight_quantum(1.0), k(0), t(0) {}
+
+template <typename EdgesOf>
+CompressedGraph CompressedGraph::build(int n, double weight_quantum, const EdgesOf& edgesOf) {
+    if (!(weight_quantum > 0.0)) {
+        throw std::invalid_argument("CompressedGraph: weight_quantum must be positive, got " +
+                                    std::to_string(weight_quantum));
+    }
+    DEBUG_FUNCTION_ENTRY("CompressedGraph::build", "n=" << n << ", quantum=" << weight_quantum);
+
+    CompressedGraph result;
+    result.num_vertices = n;
+    result.weight_quantum = weight_quantum;
+    result.offsets.assign(n + 1, 0);
+
+    // Each chunk encodes into its own buffer and records list lengths in offsets[u + 1];
+    // the buffers are concatenated afterwards in chunk order, so the layout is deterministic
+    size_t num_chunks = (static_cast<size_t>(n) + ENCODE_GRAIN - 1) / ENCODE_GRAIN;
+    std::vector<std::vector<uint8_t>> chunks(num_chunks);
+    std::atomic<int64_t> edges(0);
+    parallelFor(0, n, ENCODE_GRAIN, [&](size_t lo, size_t hi) {
+        std::vector<uint8_t>& out = chunks[lo / ENCODE_GRAIN];
+        std::vector<std::pair<int, uint64_t>> list;
+        int64_t chunk_edges = 0;
+        for (size_t u = lo; u < hi; ++u) {
+            list.clear();
+            edgesOf(static_cast<int>(u), list, weight_quantum);
+            std::sort(list.begin(), list.end());
+            size_t before = out.size();
+            int64_t previous = static_cast<int64_t>(u);
+            for (size_t i = 0; i < list.size(); ++i) {
+                int64_t delta = list[i].first - previous;
+                uint64_t gap = i == 0 ? (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63)
+                                      : static_cast<uint64_t>(delta);
+                writeVarint(out, gap);
+                writeVarint(out, list[i].second);
+                previous = list[i].first;
+            }
+            result.offsets[u + 1] = out.size() - before;
+            chunk_edges += static_cast<int64_t>(list.size());
+        }
+        edges.fetch_add(chunk_edges, std::memory_order_relaxed);
+    });
+
+    for (int u = 0; u < n; ++u) result.offsets[u + 1] += result.offsets[u];
+    result.data.reserve(result.offsets[n]);
+    for (std::vector<uint8_t>& chunk : chunks) {
+        result.data.insert(result.data.end(), chunk.begin(), chunk.end());
+        std::vector<uint8_t>().swap(chunk);
+    }
+    result.num_edges = edges.load();
+
+    if (n > 0) {
+        double tmp = std::cbrt(std::log(static_cast<double>(n)));
+        result.k = static_cast<int>(std::floor(tmp));
+        result.t = static_cast<int>(std::floor(tmp * tmp));
+    }
+
+    DEBUG_FUNCTION_EXIT("CompressedGraph::build", "edges=" << result.num_edges << ", bytes=" << result.data.size());
+    return result;
+}
+
+CompressedGraph CompressedGraph::fromGraph(const Graph& graph, double weight_quantum) {
+    return build(graph.getNumVertices(), weight_quantum,
+                 [&](int u, std::vector<std::pair<int, uint64_t>>& out, double quantum) {
+                     for (const auto& edge : graph.neighbors(u)) {
+                         if (!edge.isRemoved()) out.push_back({edge.dest, quantize(edge.weight, quantum)});
+                     }
+                 });
+}
+
+CompressedGraph CompressedGraph::fromGenerated(const GeneratedGraph& graph, double weight_quantum) {
+    return build(graph.num_vertices, weight_quantum,
+                 [&](int u, std::vector<std::pair<int, uint64_t>>& out, double quantum) {
+                     for (int64_t e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+                         out.push_back({graph.targets[e], quantize(graph.weights[e], quantum)});
+                     }
+                 });
+}
+
+Graph CompressedGraph::toGraph() const {
+    std::vector<std::vector<Edge>> adjacency(num_vertices);
+    for (int u = 0; u < num_vertices; ++u) {
+        for (const auto& edge : neighbors(u)) adjacency[u].push_back(Edge{edge.dest, edge.weight});
+    }
+    return Graph(num_vertices, std::move(adjacency));
+}
@@ -0,0 +1,588 @@
+#include "ContractionHierarchy.h"
+#include "Parallel.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    const char CH_MAGIC[4] = {'F', 'D', 'C', 'H'};
+    const uint32_t CH_FORMAT_VERSION = 1;
+
+    // Mutable graph used during contraction. in[v] holds arcs u -> v with target = u.
+    struct Overlay {
+        std::vector<std::vector<CHArc>> out;
+        std::vector<std::vector<CHArc>> in;
+    };
+
+    struct PendingShortcut {
+        int from;
+        CHArc arc;
+    };
+
+    // Insert from -> arc.target, or lower the existing arc's weight (parallel arcs are merged)
+    void addOrImprove(std::vector<CHArc>& arcs, const CHArc& arc) {
+        for (auto& existing : arcs) {
+            if (existing.target == arc.target) {
+                if (arc.weight < existing.weight) {
+                    existing.weight = arc.weight;
+                    existing.middle = arc.middle;
+                }
+                return;
+            }
+        }
+        arcs.push_back(arc);
+    }
+
+    void removeTarget(std::vector<CHArc>& arcs, int target) {
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].target == target) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Bounded Dijkstra from u that never enters `skip` or a vertex whose round_order is below
+    // `order` (a vertex contracted earlier in the same round)
+    void witnessSearch(const Overlay& overlay, SearchWorkspace& ws, int u, const std::vector<int>& round_order,
+                       int order, int skip, double bound, int settle_limit) {
+        ws.reset();
+        ws.relax(u, 0.0, -1);
+        IndexedHeap& queue = ws.getQueue();
+        int settled = 0;
+
+        while (!queue.empty()) {
+            std::pair<int, double> top = queue.pop();
+            if (top.second > bound || ++settled > settle_limit) break;
+
+            for (const auto& arc : overlay.out[top.first]) {
+                if (arc.target == skip || round_order[arc.target] < order) continue;
+                double alt = top.second + arc.weight;
+                if (alt <= bound) ws.relax(arc.target, alt, top.first);
+            }
+        }
+    }
+
+    // Shortcuts required to contract v: u -> v -> x needs one unless a witness path no longer
+    // than it avoids v and the vertices contracted before v in the same round (order). Returns
+    // the count; appends the shortcuts themselves when `shortcuts` is non-null.
+    int computeShortcuts(const Overlay& overlay, int v, const std::vector<int>& round_order, int order,
+                         const CHParams& params, SearchWorkspace& ws, std::vector<PendingShortcut>* shortcuts) {
+        const std::vector<CHArc>& incoming = overlay.in[v];
+        const std::vector<CHArc>& outgoing = overlay.out[v];
+        if (incoming.empty() || outgoing.empty()) return 0;
+
+        double max_out = 0.0;
+        for (const auto& arc : outgoing) max_out = std::max(max_out, arc.weight);
+
+        int count = 0;
+        for (const auto& in_arc : incoming) {
+            int u = in_arc.target;
+            witnessSearch(overlay, ws, u, round_order, order, v, in_arc.weight + max_out, params.witness_settle_limit);
+
+            for (const auto& out_arc : outgoing) {
+                int x = out_arc.target;
+                if (x == u) continue;
+                double via = in_arc.weight + out_arc.weight;
+                if (ws.getDistance(x) <= via) continue;
+
+                count++;
+                if (shortcuts) shortcuts->push_back(PendingShortcut{u, CHArc{x, via, v}});
+            }
+        }
+        return count;
+    }
+
+    int64_t computePriority(const Overlay& overlay, int v, const std::vector<int>& round_order,
+                            const std::vector<int>& contracted_neighbors, const std::vector<int>& levels,
+                            const CHParams& params, SearchWorkspace& ws) {
+        // Simulated contraction on the current overlay: nothing else is being contracted
+        int64_t added = computeShortcuts(overlay, v, round_order, 0, params, ws, nullptr);
+        int64_t removed = static_cast<int64_t>(overlay.in[v].size() + overlay.out[v].size());
+        return params.edge_difference_weight * (added - removed) +
+               params.contracted_neighbors_weight * static_cast<int64_t>(contracted_neighbors[v]) +
+               params.level_weight * static_cast<int64_t>(levels[v]);
+    }
+
+    void flatten(const std::vector<std::vector<CHArc>>& lists, std::vector<int64_t>& offsets,
+                 std::vector<CHArc>& arcs) {
+        offsets.assign(lists.size() + 1, 0);
+        for (size_t v = 0; v < lists.size(); ++v) {
+            offsets[v + 1] = offsets[v] + static_cast<int64_t>(lists[v].size());
+        }
+        arcs.clear();
+        arcs.reserve(offsets.back());
+        for (const auto& list : lists) {
+            arcs.insert(arcs.end(), list.begin(), list.end());
+        }
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(std::ofstream& out, const std::vector<T>& values) {
+        if (!values.empty()) {
+            out.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+        }
+    }
+
+    template <typename T>
+    void readValue(std::ifstream& in, T& value, const std::string& path) {
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("ContractionHierarchy::load: truncated file " + path);
+        }
+    }
+
+    // Bytes between the read position and the end of the file
+    uint64_t remainingBytes(std::ifstream& in) {
+        std::streampos here = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(here);
+        return end > here ? static_cast<uint64_t>(end - here) : 0;
+    }
+
+    template <typename T>
+    void readArray(std::ifstream& in, std::vector<T>& values, size_t count, const std::string& path) {
+        // Counts come from the file; check them against its size before allocating
+        if (count > remainingBytes(in) / sizeof(T)) {
+            throw std::runtime_error("ContractionHierarchy::load: truncated file " + path);
+        }
+        values.resize(count);
+        if (count > 0 && !in.read(reinterpret_cast<char*>(values.data()), sizeof(T) * count)) {
+            throw std::runtime_error("ContractionHierarchy::load: truncated file " + path);
+        }
+    }
+
+    // Arcs are written field by field so the file does not depend on struct padding
+    void writeArcs(std::ofstream& out, const std::vector<int64_t>& offsets, const std::vector<CHArc>& arcs) {
+        std::vector<int32_t> targets(arcs.size()), middles(arcs.size());
+        std::vector<double> weights(arcs.size());
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            targets[i] = arcs[i].target;
+            weights[i] = arcs[i].weight;
+            middles[i] = arcs[i].middle;
+        }
+        writeArray(out, offsets);
+        writeArray(out, targets);
+        writeArray(out, weights);
+        writeArray(out, middles);
+    }
+
+    void readArcs(std::ifstream& in, int n, std::vector<int64_t>& offsets, std::vector<CHArc>& arcs,
+                  const std::string& path) {
+        readArray(in, offsets, static_cast<size_t>(n) + 1, path);
+        if (offsets[0] != 0) {
+            throw std::runtime_error("ContractionHierarchy::load: corrupt arc offsets in " + path);
+        }
+        for (int v = 0; v < n; ++v) {
+            if (offsets[v + 1] < offsets[v]) {
+                throw std::runtime_error("ContractionHierarchy::load: corrupt arc offsets in " + path);
+            }
+        }
+
+        size_t count = static_cast<size_t>(offsets[n]);
+        std::vector<int32_t> targets, middles;
+        std::vector<double> weights;
+        readArray(in, targets, count, path);
+        readArray(in, weights, count, path);
+        readArray(in, middles, count, path);
+
+        arcs.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (targets[i] < 0 || targets[i] >= n || middles[i] < -1 || middles[i] >= n) {
+                throw std::runtime_error("ContractionHierarchy::load: arc out of range in " + path);
+            }
+            if (!(weights[i] >= 0.0)) {
+                throw std::runtime_error("ContractionHierarchy::load: negative or NaN arc weight in " + path);
+            }
+            arcs[i] = CHArc{targets[i], weights[i], middles[i]};
+        }
+    }
+
+    // Arcs stored at v must lead to a higher rank and a shortcut's middle must rank below both
+    // endpoints. Queries rely on the first; unpackArc recurses through middles and terminates
+    // only because of the second.
+    void checkRankOrder(const std::vector<int>& ranks, const std::vector<int64_t>& offsets,
+                        const std::vector<CHArc>& arcs, const std::string& path) {
+        int n = static_cast<int>(ranks.size());
+        for (int v = 0; v < n; ++v) {
+            for (int64_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                const CHArc& arc = arcs[i];
+                int low = std::min(ranks[v], ranks[arc.target]);
+                if (ranks[arc.target] <= ranks[v] || (arc.middle >= 0 && ranks[arc.middle] >= low)) {
+                    throw std::runtime_error("ContractionHierarchy::load: arc " + std::to_string(v) + " - " +
+                                             std::to_string(arc.target) + " breaks the rank order in " + path);
+                }
+            }
+        }
+    }
+}
+
+ContractionHierarchy::ContractionHierarchy() : num_vertices(0), num_shortcuts(0) {
+    forward_offsets.assign(1, 0);
+    backward_offsets.assign(1, 0);
+}
+
+ContractionHierarchy ContractionHierarchy::build(const Graph& graph, const CHParams& params) {
+    int n = graph.getNumVertices();
+    DEBUG_FUNCTION_ENTRY("ContractionHierarchy::build", "n=" << n << ", witness_settle_limit=" << params.witness_settle_limit);
+
+    // Overlay starts as the input graph without self-loops or removed edges, parallel edges
+    // merged to the lightest
+    Overlay overlay;
+    overlay.out.resize(n);
+    overlay.in.resize(n);
+    parallelFor(0, n, 1024, [&](size_t lo, size_t hi) {
+        for (size_t u = lo; u < hi; ++u) {
+            std::vector<CHArc>& arcs = overlay.out[u];
+            for (const auto& edge : graph.neighbors(static_cast<int>(u))) {
+                if (edge.dest != static_cast<int>(u) && !edge.isRemoved()) arcs.push_back(CHArc{edge.dest, edge.weight, -1});
+            }
+            std::sort(arcs.begin(), arcs.end(), [](const CHArc& a, const CHArc& b) {
+                return a.target != b.target ? a.target < b.target : a.weight < b.weight;
+            });
+            arcs.erase(std::unique(arcs.begin(), arcs.end(), [](const CHArc& a, const CHArc& b) {
+                return a.target == b.target;
+            }), arcs.end());
+        }
+    });
+    for (int u = 0; u < n; ++u) {
+        for (const auto& arc : overlay.out[u]) {
+            overlay.in[arc.target].push_back(CHArc{u, arc.weight, arc.middle});
+        }
+    }
+
+    // 1-based position within the current round's independent set, INT_MAX for every other
+    // vertex; priority simulations pass order 0 and so exclude nothing
+    std::vector<int> round_order(n, std::numeric_limits<int>::max());
+    std::vector<int> contracted_neighbors(n, 0);
+    std::vector<int> levels(n, 0);
+    std::vector<int64_t> priority(n, 0);
+    std::vector<int> ranks(n, -1);
+    std::vector<std::vector<CHArc>> upward_out(n), upward_in(n);
+
+    std::vector<int> remaining(n);
+    for (int v = 0; v < n; ++v) remaining[v] = v;
+
+    parallelFor(0, n, 64, [&](size_t lo, size_t hi) {
+        SearchWorkspace& ws = SearchWorkspace::threadLocal(n);
+        for (size_t v = lo; v < hi; ++v) {
+            priority[v] = computePriority(overlay, static_cast<int>(v), round_order, contracted_neighbors, levels, params, ws);
+        }
+    });
+
+    auto before = [&](int a, int b) {
+        return priority[a] != priority[b] ? priority[a] < priority[b] : a < b;
+    };
+
+    int next_rank = 0;
+    int rounds = 0;
+    std::vector<int> selected;
+    std::vector<int> dirty;
+    std::vector<char> is_dirty(n, 0);
+
+    while (!remaining.empty()) {
+        rounds++;
+
+        // Independent set: vertices that come before every uncontracted neighbour
+        selected.clear();
+        for (int v : remaining) {
+            bool local_min = true;
+            for (const auto& arc : overlay.out[v]) {
+                if (before(arc.target, v)) { local_min = false; break; }
+            }
+            if (local_min) {
+                for (const auto& arc : overlay.in[v]) {
+                    if (before(arc.target, v)) { local_min = false; break; }
+                }
+            }
+            if (local_min) selected.push_back(v);
+        }
+        // The set is contracted as if one vertex at a time in `selected` order: a witness may
+        // pass through vertices later in the order (still present at that point) but not
+        // earlier ones, otherwise two vertices could each rely on the other for the same
+        // u -> x connection. Missing the earlier vertices' shortcuts only adds shortcuts.
+        for (size_t i = 0; i < selected.size(); ++i) round_order[selected[i]] = static_cast<int>(i) + 1;
+        std::vector<std::vector<PendingShortcut>> shortcuts(selected.size());
+        parallelFor(0, selected.size(), 16, [&](size_t lo, size_t hi) {
+            SearchWorkspace& ws = SearchWorkspace::threadLocal(n);
+            for (size_t i = lo; i < hi; ++i) {
+                computeShortcuts(overlay, selected[i], round_order, static_cast<int>(i) + 1, params, ws, &shortcuts[i]);
+            }
+        });
+
+        dirty.clear();
+        for (int v : selected) {
+            ranks[v] = next_rank++;
+            upward_out[v] = std::move(overlay.out[v]);
+            upward_in[v] = std::move(overlay.in[v]);
+            overlay.out[v].clear();
+            overlay.in[v].clear();
+
+            for (const auto& arc : upward_out[v]) {
+                removeTarget(overlay.in[arc.target], v);
+                contracted_neighbors[arc.target]++;
+                levels[arc.target] = std::max(levels[arc.target], levels[v] + 1);
+                if (!is_dirty[arc.target]) { is_dirty[arc.target] = 1; dirty.push_back(arc.target); }
+            }
+            for (const auto& arc : upward_in[v]) {
+                removeTarget(overlay.out[arc.target], v);
+                contracted_neighbors[arc.target]++;
+                levels[arc.target] = std::max(levels[arc.target], levels[v] + 1);
+                if (!is_dirty[arc.target]) { is_dirty[arc.target] = 1; dirty.push_back(arc.target); }
+            }
+        }
+
+        for (int v : selected) round_order[v] = std::numeric_limits<int>::max();
+
+        size_t added = 0;
+        for (const auto& list : shortcuts) {
+            for (const auto& shortcut : list) {
+                addOrImprove(overlay.out[shortcut.from], shortcut.arc);
+                addOrImprove(overlay.in[shortcut.arc.target], CHArc{shortcut.from, shortcut.arc.weight, shortcut.arc.middle});
+                added++;
+            }
+        }
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&](int v) { return ranks[v] >= 0; }), remaining.end());
+
+        parallelFor(0, dirty.size(), 64, [&](size_t lo, size_t hi) {
+            SearchWorkspace& ws = SearchWorkspace::threadLocal(n);
+            for (size_t i = lo; i < hi; ++i) {
+                int v = dirty[i];
+                priority[v] = computePriority(overlay, v, round_order, contracted_neighbors, levels, params, ws);
+            }
+        });
+        for (int v : dirty) is_dirty[v] = 0;
+
+        DEBUG_LOOP(rounds, "contracted=" << selected.size() << ", shortcuts=" << added
+                   << ", remaining=" << remaining.size());
+    }
+
+    ContractionHierarchy hierarchy;
+    hierarchy.num_vertices = n;
+    hierarchy.ranks = std::move(ranks);
+    flatten(upward_out, hierarchy.forward_offsets, hierarchy.forward_arcs);
+    flatten(upward_in, hierarchy.backward_offsets, hierarchy.backward_arcs);
+    hierarchy.num_shortcuts = 0;
+    for (const auto& arc : hierarchy.forward_arcs) hierarchy.num_shortcuts += arc.middle >= 0;
+    for (const auto& arc : hierarchy.backward_arcs) hierarchy.num_shortcuts += arc.middle >= 0;
+
+    DEBUG_FUNCTION_EXIT("ContractionHierarchy::build", "rounds=" << rounds << ", arcs=" << hierarchy.getNumArcs()
+                        << ", shortcuts=" << hierarchy.num_shortcuts);
+    return hierarchy;
+}
+
+void ContractionHierarchy::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("ContractionHierarchy::save: cannot open " + path);
+    }
+
+    out.write(CH_MAGIC, sizeof(CH_MAGIC));
+    writeValue(out, CH_FORMAT_VERSION);
+    writeValue(out, static_cast<int32_t>(num_vertices));
+    writeValue(out, num_shortcuts);
+    writeArray(out, ranks);
+    writeArcs(out, forward_offsets, forward_arcs);
+    writeArcs(out, backward_offsets, backward_arcs);
+
+    if (!out) {
+        throw std::runtime_error("ContractionHierarchy::save: write failed for " + path);
+    }
+}
+
+ContractionHierarchy ContractionHierarchy::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("ContractionHierarchy::load: cannot open " + path);
+    }
+
+    char magic[sizeof(CH_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CH_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("ContractionHierarchy::load: " + path + " is not a hierarchy file");
+    }
+    uint32_t version = 0;
+    readValue(in, version, path);
+    if (version != CH_FORMAT_VERSION) {
+        throw std::runtime_error("ContractionHierarchy::load: unsupported format version " +
+                                 std::to_string(version) + " in " + path);
+    }
+
+    int32_t n = 0;
+    readValue(in, n, path);
+    if (n < 0) {
+        throw std::runtime_error("ContractionHierarchy::load: negative vertex count in " + path);
+    }
+
+    ContractionHierarchy hierarchy;
+    hierarchy.num_vertices = n;
+    readValue(in, hierarchy.num_shortcuts, path);
+    readArray(in, hierarchy.ranks, static_cast<size_t>(n), path);
+    readArcs(in, n, hierarchy.forward_offsets, hierarchy.forward_arcs, path);
+    readArcs(in, n, hierarchy.backward_offsets, hierarchy.backward_arcs, path);
+
+    std::vector<char> rank_taken(n, 0);
+    for (int rank : hierarchy.ranks) {
+        if (rank < 0 || rank >= n || rank_taken[rank]) {
+            throw std::runtime_error("ContractionHierarchy::load: ranks are not a permutation in " + path);
+        }
+        rank_taken[rank] = 1;
+    }
+    checkRankOrder(hierarchy.ranks, hierarchy.forward_offsets, hierarchy.forward_arcs, path);
+    checkRankOrder(hierarchy.ranks, hierarchy.backward_offsets, hierarchy.backward_arcs, path);
+
+    int64_t shortcuts = 0;
+    for (const auto& arc : hierarchy.forward_arcs) shortcuts += arc.middle >= 0;
+    for (const auto& arc : hierarchy.backward_arcs) shortcuts += arc.middle >= 0;
+    if (shortcuts != hierarchy.num_shortcuts) {
+        throw std::runtime_error("ContractionHierarchy::load: shortcut count mismatch in " + path);
+    }
+
+    DEBUG_PRINT("Loaded hierarchy from " << path << ": n=" << n << ", arcs=" << hierarchy.getNumArcs());
+    return hierarchy;
+}
+
+int ContractionHierarchy::getNumVertices() const {
+    return num_vertices;
+}
+
+int64_t ContractionHierarchy::getNumShortcuts() const {
+    return num_shortcuts;
+}
+
+int64_t ContractionHierarchy::getNumArcs() const {
+    return static_cast<int64_t>(forward_arcs.size() + backward_arcs.size());
+}
+
+int ContractionHierarchy::getRank(int v) const {
+    return ranks[v];
+}
+
+void ContractionHierarchy::unpackArc(int from, int to, std::vector<int>& path) const {
+    // Upward arcs live at their lower-ranked endpoint
+    const CHArc* found = nullptr;
+    if (ranks[from] < ranks[to]) {
+        for (const CHArc* arc = forwardBegin(from); arc != forwardEnd(from); ++arc) {
+            if (arc->target == to) { found = arc; break; }
+        }
+    } else {
+        for (const CHArc* arc = backwardBegin(to); arc != backwardEnd(to); ++arc) {
+            if (arc->target == from) { found = arc; break; }
+        }
+    }
+
+    if (!found) {
+        throw std::logic_error("ContractionHierarchy::unpackArc: no arc " + std::to_string(from) +
+                               " -> " + std::to_string(to));
+    }
+    if (found->middle < 0) {
+        path.push_back(to);
+        return;
+    }
+    int middle = found->middle;
+    unpackArc(from, middle, path);
+    unpackArc(middle, to, path);
+}
+
+CHQuery::CHQuery(const ContractionHierarchy& hierarchy)
+    : hierarchy(hierarchy), forward(hierarchy.getNumVertices()), backward(hierarchy.getNumVertices()),
+      source(-1), target(-1), meeting_vertex(-1),
+      distance(std::numeric_limits<double>::max()), settled_vertices(0) {
+}
+
+double CHQuery::run(int source, int target) {
+    const double INF = std::numeric_limits<double>::max();
+    int n = hierarchy.getNumVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("CHQuery: vertex pair (" + std::to_string(source) + ", " +
+                                    std::to_string(target) + ") out of range");
+    }
+
+    QueryScope scope("CHQuery::run", &hierarchy);
+    if (scope.isActive()) {
+        scope.setParameters("source=" + std::to_string(source) + ", target=" + std::to_string(target));
+    }
+    uint64_t relaxed = 0;
+
+    forward.reset();
+    backward.reset();
+    this->source = source;
+    this->target = target;
+    meeting_vertex = -1;
+    distance = INF;
+    settled_vertices = 0;
+
+    IndexedHeap& forward_queue = forward.getQueue();
+    IndexedHeap& backward_queue = backward.getQueue();
+    forward.relax(source, 0.0, -1);
+    backward.relax(target, 0.0, -1);
+
+    // Both searches only climb in rank, so neither can stop at the first meeting; each side
+    // runs until its queue head can no longer improve the best distance
+    while (true) {
+        double forward_top = forward_queue.empty() ? INF : forward_queue.top().second;
+        double backward_top = backward_queue.empty() ? INF : backward_queue.top().second;
+        if (std::min(forward_top, backward_top) >= distance) break;
+
+        bool expand_forward = forward_top <= backward_top;
+        SearchWorkspace& self = expand_forward ? forward : backward;
+        SearchWorkspace& other = expand_forward ? backward : forward;
+
+        std::pair<int, double> top = self.getQueue().pop();
+        int u = top.first;
+        double dist = top.second;
+        self.settle(u);
+        settled_vertices++;
+
+        if (other.isReached(u) && dist + other.getDistance(u) < distance) {
+            distance = dist + other.getDistance(u);
+            meeting_vertex = u;
+        }
+
+        const CHArc* begin = expand_forward ? hierarchy.forwardBegin(u) : hierarchy.backwardBegin(u);
+        const CHArc* end = expand_forward ? hierarchy.forwardEnd(u) : hierarchy.backwardEnd(u);
+        for (const CHArc* arc = begin; arc != end; ++arc) {
+            if (self.relax(arc->target, dist + arc->weight, u)) ++relaxed;
+        }
+    }
+
+    QueryScope::count("settled_vertices", settled_vertices);
+    QueryScope::count("relaxed_edges", relaxed);
+    DEBUG_PRINT("CHQuery " << source << " -> " << target << ": distance=" << distance
+                << ", settled=" << settled_vertices);
+    return distance;
+}
+
+std::vector<int> CHQuery::getPath() const {
+    std::vector<int> path;
+    if (meeting_vertex < 0) return path;
+
+    // Hierarchy-level path: source .. meeting (forward predecessors), meeting .. target
+    std::vector<int> up;
+    for (int v = meeting_vertex; v != -1; v = forward.getPredecessor(v)) up.push_back(v);
+    std::reverse(up.begin(), up.end());
+    for (int v = backward.getPredecessor(meeting_vertex); v != -1; v = backward.getPredecessor(v)) up.push_back(v);
+
+    path.push_back(up[0]);
+    for (size_t i = 0; i + 1 < up.size(); ++i) {
+        hierarchy.unpackArc(up[i], up[i + 1], path);
+    }
+    return path;
+}
+
+int CHQuery::getSettledCount() const {
+    return settled_vertices;
+}
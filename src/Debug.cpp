@@ -35,7 +35,7 @@ std::string vectorToString(const std::vector<double>& vec) {
     return oss.str();
 }
 
-std::string setToString(const std::unordered_set<int>& set) {
+std::string setToString(const TrackedUnorderedSet<int>& set) {
     std::ostringstream oss;
     oss << "{";
     size_t count = 0;
@@ -1,9 +1,17 @@
 #include "Dijkstra.h"
+#include "RelaxKernel.h"
+#include "SearchWorkspace.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <cmath>
 #include <queue>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <limits>
 
-DijkstraResults runDijkstra(Graph& graph, int source) {
+template <typename GraphT>
+DijkstraResults runDijkstra(const GraphT& graph, int source, const CancellationToken* cancel) {
     int numVertices = graph.getNumVertices();
     std::vector<double> distances(numVertices, std::numeric_limits<double>::max());
     std::vector<int> predecessors(numVertices , -1);
@@ -12,24 +20,115 @@ DijkstraResults runDijkstra(Graph& graph, int source) {
     using State = std::pair<double, int>;
     std::priority_queue<State, std::vector<State>, std::greater<State>> pq;
 
+    QueryScope scope("runDijkstra", &graph);
+    if (scope.isActive()) scope.setParameters("source=" + std::to_string(source));
+    uint64_t settled = 0, relaxed = 0;
+
     distances[source] = 0.0;
     pq.push({0.0, source});
+    StopCheck stop(cancel);
 
     while (!pq.empty()) {
-        int d = pq.top().first; int v = pq.top().second; // src vertex
+        double d = pq.top().first; int v = pq.top().second; // src vertex
         pq.pop();
+        if (d > distances[v]) continue; // stale entry, v already settled with a shorter distance
+        if (stop.tick()) break;
+        ++settled;
 
-        for (const auto& edge : graph.getConnections(v)) {
-            double altWeight = edge.weight + d; int u = edge.dest;
+        relaxOutgoing(graph, v, d, distances.data(), false, [&](int u, double altWeight) {
             if (altWeight < distances[u]) {
                 distances[u] = altWeight;
                 predecessors[u] = v;
                 pq.push({altWeight, u});
+                ++relaxed;
             }
-        }
+        });
     }
+    QueryScope::count("settled_vertices", settled);
+    QueryScope::count("relaxed_edges", relaxed);
+    scope.setComplete(!stop.isStopped());
     DijkstraResults result;
     result.distances = distances;
     result.predecessors = predecessors;
+    result.complete = !stop.isStopped();
     return result;
-}
\ No newline at end of file
+}
+
+template <typename GraphT>
+MultiSourceResults runMultiSourceDijkstra(const GraphT& graph, const std::vector<int>& sources,
+                                          const std::vector<double>& offsets, bool track_origins) {
+    int numVertices = graph.getNumVertices();
+    if (!offsets.empty() && offsets.size() != sources.size()) {
+        throw std::invalid_argument("runMultiSourceDijkstra: " + std::to_string(offsets.size()) + " offsets for " +
+                                    std::to_string(sources.size()) + " sources");
+    }
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0 || sources[i] >= numVertices) {
+            throw std::invalid_argument("runMultiSourceDijkstra: source vertex " + std::to_string(sources[i]) +
+                                        " out of range");
+        }
+        if (!offsets.empty() && !std::isfinite(offsets[i])) {
+            throw std::invalid_argument("runMultiSourceDijkstra: offset of source " + std::to_string(sources[i]) +
+                                        " is not finite");
+        }
+    }
+    DEBUG_FUNCTION_ENTRY("runMultiSourceDijkstra", "sources.size()=" << sources.size() << ", origins=" << track_origins);
+    QueryScope scope("runMultiSourceDijkstra", &graph);
+    if (scope.isActive()) scope.setParameters("sources=" + std::to_string(sources.size()));
+    uint64_t settled = 0, relaxed = 0;
+
+    MultiSourceResults result;
+    result.distances.assign(numVertices, std::numeric_limits<double>::max());
+    result.predecessors.assign(numVertices, -1);
+    if (track_origins) result.origins.assign(numVertices, -1);
+
+    SearchWorkspace& workspace = SearchWorkspace::threadLocal(numVertices);
+    workspace.reset();
+    IndexedHeap& queue = workspace.getQueue();
+    for (size_t i = 0; i < sources.size(); ++i) {
+        double offset = offsets.empty() ? 0.0 : offsets[i];
+        if (workspace.relax(sources[i], offset, -1)) {
+            result.distances[sources[i]] = offset;
+            if (track_origins) result.origins[sources[i]] = static_cast<int>(i);
+        }
+    }
+
+    while (!queue.empty()) {
+        std::pair<int, double> top = queue.pop();
+        int v = top.first;
+        double d = top.second;
+        workspace.settle(v);
+        ++settled;
+        // result.distances mirrors the workspace so the vector kernel can filter against it
+        relaxOutgoing(graph, v, d, result.distances.data(), false, [&](int u, double altWeight) {
+            if (workspace.relax(u, altWeight, v)) {
+                result.distances[u] = altWeight;
+                if (track_origins) result.origins[u] = result.origins[v];
+                ++relaxed;
+            }
+        });
+    }
+    QueryScope::count("settled_vertices", settled);
+    QueryScope::count("relaxed_edges", relaxed);
+
+    for (int v : workspace.getTouched()) result.predecessors[v] = workspace.getPredecessor(v);
+    DEBUG_FUNCTION_EXIT("runMultiSourceDijkstra", "reached=" << workspace.getTouched().size());
+    return result;
+}
+
+template DijkstraResults runDijkstra<Graph>(const Graph&, int, const CancellationToken*);
+template DijkstraResults runDijkstra<FloatGraph>(const FloatGraph&, int, const CancellationToken*);
+template DijkstraResults runDijkstra<UInt32Graph>(const UInt32Graph&, int, const CancellationToken*);
+template DijkstraResults runDijkstra<DoubleGraph>(const DoubleGraph&, int, const CancellationToken*);
+template DijkstraResults runDijkstra<CompressedGraph>(const CompressedGraph&, int, const CancellationToken*);
+
+template MultiSourceResults runMultiSourceDijkstra<Graph>(const Graph&, const std::vector<int>&,
+                                                         const std::vector<double>&, bool);
+template MultiSourceResults runMultiSourceDijkstra<FloatGraph>(const FloatGraph&, const std::vector<int>&,
+                                                              const std::vector<double>&, bool);
+template MultiSourceResults runMultiSourceDijkstra<UInt32Graph>(const UInt32Graph&, const std::vector<int>&,
+                                                               const std::vector<double>&, bool);
+template MultiSourceResults runMultiSourceDijkstra<DoubleGraph>(const DoubleGraph&, const std::vector<int>&,
+                                                               const std::vector<double>&, bool);
+template MultiSourceResults runMultiSourceDijkstra<CompressedGraph>(const CompressedGraph&, const std::vector<int>&,
+                                                                   const std::vector<double>&, bool);
@@ -0,0 +1,122 @@
+#include "DistanceTable.h"
+#include "SearchWorkspace.h"
+#include "Parallel.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    void validateVertices(const std::vector<int>& vertices, int n, const char* what) {
+        for (int v : vertices) {
+            if (v < 0 || v >= n) {
+                throw std::invalid_argument(std::string("distanceTable: ") + what + " vertex " +
+                                            std::to_string(v) + " out of range");
+            }
+        }
+    }
+
+    // Collapse repeated vertices: returns the distinct list and, for every input position,
+    // the index of its distinct representative
+    std::vector<int> dedupe(const std::vector<int>& vertices, std::vector<int>& slot_of) {
+        std::unordered_map<int, int> first;
+        std::vector<int> distinct;
+        slot_of.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            auto inserted = first.emplace(vertices[i], static_cast<int>(distinct.size()));
+            if (inserted.second) distinct.push_back(vertices[i]);
+            slot_of[i] = inserted.first->second;
+        }
+        return distinct;
+    }
+}
+
+DistanceTable distanceTable(const Graph& graph, const std::vector<int>& sources,
+                            const std::vector<int>& targets) {
+    DEBUG_FUNCTION_ENTRY("distanceTable", "sources.size()=" << sources.size() << ", targets.size()=" << targets.size());
+
+    int n = graph.getNumVertices();
+    validateVertices(sources, n, "source");
+    validateVertices(targets, n, "target");
+
+    QueryScope scope("distanceTable", &graph);
+    if (scope.isActive()) {
+        scope.setParameters("sources=" + std::to_string(sources.size()) + ", targets=" + std::to_string(targets.size()));
+    }
+
+    DistanceTable table;
+    table.num_sources = static_cast<int>(sources.size());
+    table.num_targets = static_cast<int>(targets.size());
+    table.distances.assign(sources.size() * targets.size(), std::numeric_limits<double>::max());
+    if (sources.empty() || targets.empty()) return table;
+
+    std::vector<int> source_slot, target_slot;
+    std::vector<int> distinct_sources = dedupe(sources, source_slot);
+    std::vector<int> distinct_targets = dedupe(targets, target_slot);
+    int num_distinct_targets = static_cast<int>(distinct_targets.size());
+
+    // One O(n) lookup array per call, shared read-only by all searches
+    std::vector<int> target_column(n, -1);
+    for (int j = 0; j < num_distinct_targets; ++j) {
+        target_column[distinct_targets[j]] = j;
+    }
+
+    DEBUG_PRINT("Distinct sources=" << distinct_sources.size() << ", distinct targets=" << num_distinct_targets);
+
+    // Distinct-source x distinct-target results, expanded to the caller's layout afterwards
+    std::vector<double> compact(distinct_sources.size() * num_distinct_targets, std::numeric_limits<double>::max());
+
+    // The searches run on pool threads, outside this thread's scope; their counts are
+    // gathered here and added once they are done
+    std::atomic<uint64_t> settled(0), relaxed(0);
+    parallelFor(0, distinct_sources.size(), 1, [&](size_t lo, size_t hi) {
+        SearchWorkspace& ws = SearchWorkspace::threadLocal(n);
+        IndexedHeap& queue = ws.getQueue();
+        uint64_t chunk_settled = 0, chunk_relaxed = 0;
+
+        for (size_t i = lo; i < hi; ++i) {
+            double* row = compact.data() + i * num_distinct_targets;
+            int remaining = num_distinct_targets;
+
+            ws.reset();
+            ws.relax(distinct_sources[i], 0.0, -1);
+
+            while (!queue.empty() && remaining > 0) {
+                std::pair<int, double> top = queue.pop();
+                int u = top.first;
+                double dist = top.second;
+                ++chunk_settled;
+
+                int column = target_column[u];
+                if (column >= 0) {
+                    row[column] = dist;
+                    remaining--;
+                }
+
+                for (const auto& edge : graph.neighbors(u)) {
+                    if (ws.relax(edge.dest, dist + edge.weight, u)) ++chunk_relaxed;
+                }
+            }
+        }
+        settled.fetch_add(chunk_settled, std::memory_order_relaxed);
+        relaxed.fetch_add(chunk_relaxed, std::memory_order_relaxed);
+    });
+    QueryScope::count("settled_vertices", settled.load());
+    QueryScope::count("relaxed_edges", relaxed.load());
+
+    for (int i = 0; i < table.num_sources; ++i) {
+        const double* src_row = compact.data() + static_cast<size_t>(source_slot[i]) * num_distinct_targets;
+        double* dst_row = table.distances.data() + static_cast<size_t>(i) * table.num_targets;
+        for (int j = 0; j < table.num_targets; ++j) {
+            dst_row[j] = src_row[target_slot[j]];
+        }
+    }
+
+    DEBUG_FUNCTION_EXIT("distanceTable", "rows=" << table.num_sources << ", cols=" << table.num_targets);
+    return table;
+}
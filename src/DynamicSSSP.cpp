@@ -0,0 +1,159 @@
+#include "DynamicSSSP.h"
+#include "Dijkstra.h"
+#include "Debug.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    const double INF = std::numeric_limits<double>::max();
+}
+
+DynamicSSSP::DynamicSSSP(Graph& graph, int source)
+    : graph(graph), source(source), last_affected(0) {
+    if (source < 0 || source >= graph.getNumVertices()) {
+        throw std::invalid_argument("DynamicSSSP: source " + std::to_string(source) + " out of range");
+    }
+    graph.enableReverseEdges();
+    recompute();
+}
+
+void DynamicSSSP::recompute() {
+    DEBUG_FUNCTION_ENTRY("DynamicSSSP::recompute", "source=" << source);
+
+    int n = graph.getNumVertices();
+    DijkstraResults result = runDijkstra(graph, source);
+    distances = std::move(result.distances);
+    predecessors = std::move(result.predecessors);
+    queue.resize(n);
+    affected.assign(n, 0);
+    last_affected = n;
+}
+
+void DynamicSSSP::applyUpdates(const std::vector<EdgeUpdate>& updates) {
+    DEBUG_FUNCTION_ENTRY("DynamicSSSP::applyUpdates", "updates.size()=" << updates.size());
+
+    int n = graph.getNumVertices();
+    for (const auto& update : updates) {
+        if (update.src < 0 || update.src >= n || update.dest < 0 || update.dest >= n) {
+            throw std::invalid_argument("DynamicSSSP: edge (" + std::to_string(update.src) + ", " +
+                                        std::to_string(update.dest) + ") out of range");
+        }
+        if (!(update.weight >= 0.0)) {
+            throw std::invalid_argument("DynamicSSSP: negative or NaN weight on edge (" +
+                                        std::to_string(update.src) + ", " + std::to_string(update.dest) + ")");
+        }
+    }
+
+    // Apply to the graph, remembering which tree edges got worse
+    std::vector<int> affected_list;
+    for (const auto& update : updates) {
+        double old_weight = graph.getEdgeWeight(update.src, update.dest);
+        if (update.weight >= INF) {
+            graph.removeEdge(update.src, update.dest);
+        } else if (old_weight == INF) {
+            graph.addEdge(update.src, update.dest, update.weight);
+        } else {
+            graph.setEdgeWeight(update.src, update.dest, update.weight);
+        }
+
+        if (update.weight > old_weight && predecessors[update.dest] == update.src && !affected[update.dest]) {
+            affected[update.dest] = 1;
+            affected_list.push_back(update.dest);
+        }
+    }
+
+    // Tree descendants of the seeds lose their support as well
+    for (size_t i = 0; i < affected_list.size(); ++i) {
+        int u = affected_list[i];
+        for (const auto& edge : graph.neighbors(u)) {
+            int v = edge.dest;
+            if (!affected[v] && predecessors[v] == u) {
+                affected[v] = 1;
+                affected_list.push_back(v);
+            }
+        }
+    }
+
+    // Affected vertices restart from the best unaffected in-neighbour. Everyone else keeps a
+    // distance that is still the length of a real path, so it is a valid upper bound.
+    queue.clear();
+    for (int v : affected_list) {
+        double best = INF;
+        int best_pred = -1;
+        for (const auto& edge : graph.reverseNeighbors(v)) {
+            int u = edge.dest;
+            if (affected[u] || distances[u] == INF) continue;
+            double candidate = distances[u] + edge.weight;
+            if (candidate < best) {
+                best = candidate;
+                best_pred = u;
+            }
+        }
+        distances[v] = best;
+        predecessors[v] = best_pred;
+        if (best != INF) queue.pushOrDecrease(v, best);
+    }
+
+    // Lighter or new edges can shorten paths anywhere downstream. Improved vertices are
+    // marked 2 in `affected` so each is counted once.
+    std::vector<int> improved_list;
+    auto markImproved = [&](int v) {
+        if (!affected[v]) {
+            affected[v] = 2;
+            improved_list.push_back(v);
+        }
+    };
+
+    for (const auto& update : updates) {
+        int u = update.src, v = update.dest;
+        if (update.weight >= INF || distances[u] == INF) continue;
+        double candidate = distances[u] + graph.getEdgeWeight(u, v);
+        if (candidate < distances[v]) {
+            distances[v] = candidate;
+            predecessors[v] = u;
+            queue.pushOrDecrease(v, candidate);
+            markImproved(v);
+        }
+    }
+
+    while (!queue.empty()) {
+        std::pair<int, double> top = queue.pop();
+        int u = top.first;
+        double dist = top.second;
+        if (dist > distances[u]) continue;
+
+        for (const auto& edge : graph.neighbors(u)) {
+            double alt = dist + edge.weight;
+            if (alt < distances[edge.dest]) {
+                distances[edge.dest] = alt;
+                predecessors[edge.dest] = u;
+                queue.pushOrDecrease(edge.dest, alt);
+                markImproved(edge.dest);
+            }
+        }
+    }
+
+    last_affected = static_cast<int>(affected_list.size() + improved_list.size());
+    for (int v : affected_list) affected[v] = 0;
+    for (int v : improved_list) affected[v] = 0;
+
+    DEBUG_FUNCTION_EXIT("DynamicSSSP::applyUpdates", "affected=" << affected_list.size()
+                        << ", improved=" << improved_list.size());
+}
+
+int DynamicSSSP::getSource() const {
+    return source;
+}
+
+const std::vector<double>& DynamicSSSP::getDistances() const {
+    return distances;
+}
+
+const std::vector<int>& DynamicSSSP::getPredecessors() const {
+    return predecessors;
+}
+
+int DynamicSSSP::getLastAffectedCount() const {
+    return last_affected;
+}
@@ -1,16 +1,21 @@
 #include "FindPivot.h"
 #include "Graph.h"
+#include "RelaxKernel.h"
+#include "Trace.h"
+#include "MemoryTracker.h"
 #include "Debug.h"
 #include <vector>
-#include <unordered_set>
-#include <unordered_map>
+#include <utility>
 
-FindPivotResult findPivots(Graph& graph,
+template <typename GraphT>
+FindPivotResult findPivots(const GraphT& graph,
     double B,  //upper bound
-    std::unordered_set<int>& S, // frontier set
+    TrackedUnorderedSet<int>& S, // frontier set
     std::vector<double>& d_hat) {//current best distance
 
     DEBUG_FUNCTION_ENTRY("findPivots", "B=" << B << ", S.size()=" << S.size() << ", S=" << setToString(S));
+    TraceSpan span("findPivots", "bmssp");
+    span.arg("sources", static_cast<double>(S.size()));
 
     int k = graph.getK();
     int numVertices = graph.getNumVertices();
@@ -28,10 +33,10 @@ FindPivotResult findPivots(Graph& graph,
         DEBUG_BOUNDS_CHECK(v, numVertices, "vertex in S");
     }
 
-    std::unordered_set<int> W = S;
-    std::vector<std::unordered_set<int>> W_steps(k + 1);
-    std::vector<int> predecessors(numVertices, -1);
-    std::unordered_map<int, int> tree_sizes;
+    TrackedUnorderedSet<int> W = S;
+    TrackedVector<TrackedUnorderedSet<int>> W_steps(k + 1);
+    TrackedVector<int> predecessors(numVertices, -1);
+    TrackedUnorderedMap<int, int> tree_sizes;
 
     DEBUG_MEMORY("Allocated W_steps with size=" << W_steps.size() << ", predecessors size=" << predecessors.size());
 
@@ -47,12 +52,9 @@ FindPivotResult findPivots(Graph& graph,
         for (int u : W_steps[idx - 1]) {
             DEBUG_BOUNDS_CHECK(u, numVertices, "vertex u in W_steps");
 
-            for (const auto& e : graph.getConnections(u)) {
-                int dest = e.dest;
-                double new_dist = d_hat[u] + e.weight;
-
+            relaxOutgoing(graph, u, d_hat[u], d_hat.data(), true, [&](int dest, double new_dist) {
                 DEBUG_BOUNDS_CHECK(dest, numVertices, "edge destination");
-                DEBUG_PRINT("Considering edge " << u << "->" << dest << ", weight=" << e.weight << ", new_dist=" << new_dist << ", current_dist=" << d_hat[dest]);
+                DEBUG_PRINT("Considering edge " << u << "->" << dest << ", new_dist=" << new_dist << ", current_dist=" << d_hat[dest]);
 
                 if (new_dist <= d_hat[dest]) {
                     DEBUG_PRINT("Relaxing: d_hat[" << dest << "] from " << d_hat[dest] << " to " << new_dist);
@@ -63,7 +65,7 @@ FindPivotResult findPivots(Graph& graph,
                         W_steps[idx].insert(dest);
                     }
                 }
-            }
+            });
         }
         W.insert(W_steps[idx].begin(), W_steps[idx].end());
         DEBUG_PRINT("After step " << idx << ": W_steps[" << idx << "].size()=" << W_steps[idx].size() << ", W.size()=" << W.size());
@@ -71,7 +73,9 @@ FindPivotResult findPivots(Graph& graph,
         if (W.size() > k * S.size()) {
             DEBUG_PRINT("Early termination: W.size()=" << W.size() << " > k*S.size()=" << (k * S.size()));
             results.pivots = S;
-            results.nearby = W;
+            results.nearby = std::move(W);
+            span.arg("pivots", static_cast<double>(results.pivots.size()));
+            span.arg("nearby", static_cast<double>(results.nearby.size()));
             DEBUG_FUNCTION_EXIT("findPivots [early]", "pivots.size()=" << results.pivots.size() << ", nearby.size()=" << results.nearby.size());
             return results;
         }
@@ -97,7 +101,7 @@ FindPivotResult findPivots(Graph& graph,
 
     DEBUG_PRINT("Computed tree sizes for " << tree_sizes.size() << " roots");
 
-    std::unordered_set<int> P;
+    TrackedUnorderedSet<int> P;
 
     DEBUG_PRINT("Selecting pivots from trees with size >= k=" << k);
     for (const auto& pair: tree_sizes) {
@@ -112,10 +116,17 @@ FindPivotResult findPivots(Graph& graph,
 
     DEBUG_PRINT("Selected " << P.size() << " pivots: " << setToString(P));
 
-    results.pivots = P;
-    results.nearby = W;
+    results.pivots = std::move(P);
+    results.nearby = std::move(W);
+    span.arg("pivots", static_cast<double>(results.pivots.size()));
+    span.arg("nearby", static_cast<double>(results.nearby.size()));
 
     DEBUG_FUNCTION_EXIT("findPivots", "pivots.size()=" << results.pivots.size() << ", nearby.size()=" << results.nearby.size());
     return results;
-        // std::unordered_set
 };
+
+template FindPivotResult findPivots<Graph>(const Graph&, double, TrackedUnorderedSet<int>&, std::vector<double>&);
+template FindPivotResult findPivots<FloatGraph>(const FloatGraph&, double, TrackedUnorderedSet<int>&, std::vector<double>&);
+template FindPivotResult findPivots<UInt32Graph>(const UInt32Graph&, double, TrackedUnorderedSet<int>&, std::vector<double>&);
+template FindPivotResult findPivots<DoubleGraph>(const DoubleGraph&, double, TrackedUnorderedSet<int>&, std::vector<double>&);
+template FindPivotResult findPivots<CompressedGraph>(const CompressedGraph&, double, TrackedUnorderedSet<int>&, std::vector<double>&);
@@ -1,10 +1,33 @@
 #include "Graph.h"
 #include "Debug.h"
+#include "Parallel.h"
+#include <atomic>
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
-Graph::Graph (int n) {
+namespace {
+    const double REMOVED = std::numeric_limits<double>::infinity();
+
+    std::atomic<uint64_t> version_counter(0);
+
+    // Infinity marks a tombstone, so it must never come in as a real weight
+    void checkWeight(double weight, const char* where) {
+        if (!std::isfinite(weight)) {
+            throw std::invalid_argument(std::string(where) + ": weight must be finite, got " + std::to_string(weight));
+        }
+    }
+}
+
+uint64_t Graph::nextVersion() {
+    return version_counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+Graph::Graph (int n) : version(nextVersion()) {
     DEBUG_FUNCTION_ENTRY("Graph::Graph", "n=" << n);
 
     this->num_vertices = n;
@@ -33,9 +56,24 @@ Graph::Graph (int n, const std::vector<std::vector<int>>& edges, const std::vect
     }
 }
 
+Graph::Graph (int n, std::vector<std::vector<Edge>>&& adjacency) : Graph(n) {
+    DEBUG_PRINT("Adopting adjacency list with " << adjacency.size() << " rows for n=" << n);
+    this->adjList = std::move(adjacency);
+    this->adjList.resize(n);
+    for (const auto& edges : adjList) {
+        for (const auto& e : edges) {
+            if (e.isRemoved()) num_tombstones++; else num_edges++;
+        }
+    }
+}
+
 // Copy constructor
 Graph::Graph(const Graph& other)
-    : num_vertices(other.num_vertices), adjList(other.adjList), k(other.k), t(other.t) {
+    : num_vertices(other.num_vertices), adjList(other.adjList),
+      reverseAdjList(other.reverseAdjList), reverseSlot(other.reverseSlot), forwardSlot(other.forwardSlot),
+      reverseEnabled(other.reverseEnabled), num_edges(other.num_edges), num_tombstones(other.num_tombstones),
+      generation(other.generation), version(other.version), removedVertices(other.removedVertices), k(other.k),
+      t(other.t) {
 }
 
 // Assignment operator
@@ -43,26 +81,237 @@ Graph& Graph::operator=(const Graph& other) {
     if (this != &other) {
         num_vertices = other.num_vertices;
         adjList = other.adjList;
+        reverseAdjList = other.reverseAdjList;
+        reverseSlot = other.reverseSlot;
+        forwardSlot = other.forwardSlot;
+        reverseEnabled = other.reverseEnabled;
+        num_edges = other.num_edges;
+        num_tombstones = other.num_tombstones;
+        generation = other.generation;
+        version = other.version;
+        removedVertices = other.removedVertices;
         k = other.k;
         t = other.t;
     }
     return *this;
 }
 
-void Graph::addEdge(int src, int dest, double weight) {
+EdgeHandle Graph::addEdge(int src, int dest, double weight) {
     DEBUG_FUNCTION_ENTRY("Graph::addEdge", "src=" << src << ", dest=" << dest << ", weight=" << weight);
 
     DEBUG_BOUNDS_CHECK(src, num_vertices, "source vertex");
     DEBUG_BOUNDS_CHECK(dest, num_vertices, "destination vertex");
+    checkWeight(weight, "Graph::addEdge");
+    if (!removedVertices.empty() && (removedVertices[src] || removedVertices[dest])) {
+        throw std::invalid_argument("Graph::addEdge: edge (" + std::to_string(src) + ", " +
+                                    std::to_string(dest) + ") touches a removed vertex");
+    }
 
     Edge e;
     e.dest = dest;
     e.weight = weight;
 
     size_t old_size = this->adjList[src].size();
+    EdgeHandle handle{src, static_cast<int>(old_size), generation};
     this->adjList[src].push_back(e);
+    if (e.isRemoved()) num_tombstones++; else num_edges++;
+    version = nextVersion();
+    if (reverseEnabled) {
+        this->reverseSlot[src].push_back(static_cast<int>(reverseAdjList[dest].size()));
+        this->forwardSlot[dest].push_back(handle.slot);
+        this->reverseAdjList[dest].push_back(Edge{src, weight});
+    }
 
     DEBUG_DATASTRUCTURE("ADD_EDGE", "adjList[" << src << "] size: " << old_size << " -> " << adjList[src].size());
+    return handle;
+}
+
+void Graph::writeWeight(int src, int slot, double weight) {
+    Edge& e = adjList[src][slot];
+    bool was_removed = e.isRemoved();
+    e.weight = weight;
+    version = nextVersion();
+    if (was_removed != e.isRemoved()) {
+        if (was_removed) {
+            num_tombstones--;
+            num_edges++;
+        } else {
+            num_edges--;
+            num_tombstones++;
+        }
+    }
+    if (reverseEnabled) {
+        reverseAdjList[e.dest][reverseSlot[src][slot]].weight = weight;
+    }
+}
+
+bool Graph::setEdgeWeight(int src, int dest, double weight) {
+    DEBUG_FUNCTION_ENTRY("Graph::setEdgeWeight", "src=" << src << ", dest=" << dest << ", weight=" << weight);
+    checkWeight(weight, "Graph::setEdgeWeight");
+    EdgeHandle handle = findEdge(src, dest);
+    if (!handle.isValid()) return false;
+    writeWeight(src, handle.slot, weight);
+    return true;
+}
+
+bool Graph::removeEdge(int src, int dest) {
+    DEBUG_FUNCTION_ENTRY("Graph::removeEdge", "src=" << src << ", dest=" << dest);
+    EdgeHandle handle = findEdge(src, dest);
+    if (!handle.isValid()) return false;
+    writeWeight(src, handle.slot, REMOVED);
+    return true;
+}
+
+double Graph::getEdgeWeight(int src, int dest) const {
+    EdgeHandle handle = findEdge(src, dest);
+    return handle.isValid() ? adjList[src][handle.slot].weight : std::numeric_limits<double>::max();
+}
+
+EdgeHandle Graph::findEdge(int src, int dest) const {
+    DEBUG_BOUNDS_CHECK(src, num_vertices, "source vertex");
+    DEBUG_BOUNDS_CHECK(dest, num_vertices, "destination vertex");
+    const std::vector<Edge>& edges = adjList[src];
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].dest == dest && !edges[i].isRemoved()) {
+            return EdgeHandle{src, static_cast<int>(i), generation};
+        }
+    }
+    return EdgeHandle();
+}
+
+void Graph::checkHandle(const EdgeHandle& handle) const {
+    if (handle.generation != generation) {
+        throw std::invalid_argument("Graph: stale edge handle from layout generation " +
+                                    std::to_string(handle.generation) + ", graph is at " + std::to_string(generation));
+    }
+    if (handle.src < 0 || handle.src >= num_vertices || handle.slot < 0 ||
+        handle.slot >= static_cast<int>(adjList[handle.src].size())) {
+        throw std::invalid_argument("Graph: edge handle (" + std::to_string(handle.src) + ", slot " +
+                                    std::to_string(handle.slot) + ") out of range");
+    }
+}
+
+bool Graph::isLive(const EdgeHandle& handle) const {
+    return handle.generation == generation && handle.src >= 0 && handle.src < num_vertices &&
+           handle.slot >= 0 && handle.slot < static_cast<int>(adjList[handle.src].size()) &&
+           !adjList[handle.src][handle.slot].isRemoved();
+}
+
+const Edge& Graph::getEdge(const EdgeHandle& handle) const {
+    checkHandle(handle);
+    return adjList[handle.src][handle.slot];
+}
+
+void Graph::updateWeight(const EdgeHandle& handle, double weight) {
+    DEBUG_FUNCTION_ENTRY("Graph::updateWeight", "src=" << handle.src << ", slot=" << handle.slot << ", weight=" << weight);
+    checkHandle(handle);
+    checkWeight(weight, "Graph::updateWeight");
+    if (adjList[handle.src][handle.slot].isRemoved()) {
+        throw std::invalid_argument("Graph::updateWeight: edge was removed");
+    }
+    writeWeight(handle.src, handle.slot, weight);
+}
+
+void Graph::removeEdge(const EdgeHandle& handle) {
+    DEBUG_FUNCTION_ENTRY("Graph::removeEdge", "src=" << handle.src << ", slot=" << handle.slot);
+    checkHandle(handle);
+    if (adjList[handle.src][handle.slot].isRemoved()) {
+        throw std::invalid_argument("Graph::removeEdge: edge was already removed");
+    }
+    writeWeight(handle.src, handle.slot, REMOVED);
+}
+
+void Graph::removeVertex(int v) {
+    DEBUG_FUNCTION_ENTRY("Graph::removeVertex", "v=" << v);
+    if (v < 0 || v >= num_vertices) {
+        throw std::invalid_argument("Graph::removeVertex: vertex " + std::to_string(v) + " out of range");
+    }
+    if (removedVertices.empty()) removedVertices.assign(num_vertices, 0);
+    if (removedVertices[v]) return;
+    removedVertices[v] = 1;
+    version = nextVersion();
+
+    for (size_t i = 0; i < adjList[v].size(); ++i) {
+        if (!adjList[v][i].isRemoved()) writeWeight(v, static_cast<int>(i), REMOVED);
+    }
+    if (reverseEnabled) {
+        const std::vector<Edge>& incoming = reverseAdjList[v];
+        for (size_t j = 0; j < incoming.size(); ++j) {
+            if (!incoming[j].isRemoved()) writeWeight(incoming[j].dest, forwardSlot[v][j], REMOVED);
+        }
+    } else {
+        for (int u = 0; u < num_vertices; ++u) {
+            for (size_t i = 0; i < adjList[u].size(); ++i) {
+                if (adjList[u][i].dest == v && !adjList[u][i].isRemoved()) writeWeight(u, static_cast<int>(i), REMOVED);
+            }
+        }
+    }
+}
+
+bool Graph::isVertexRemoved(int v) const {
+    DEBUG_BOUNDS_CHECK(v, num_vertices, "vertex in isVertexRemoved");
+    return !removedVertices.empty() && removedVertices[v];
+}
+
+uint64_t Graph::getVersion() const {
+    return version;
+}
+
+size_t Graph::getNumEdges() const {
+    return num_edges;
+}
+
+size_t Graph::getNumTombstones() const {
+    return num_tombstones;
+}
+
+bool Graph::needsCompaction() const {
+    return num_tombstones > 0 && num_tombstones * 4 >= num_edges + num_tombstones;
+}
+
+void Graph::compact() {
+    DEBUG_FUNCTION_ENTRY("Graph::compact", "edges=" << num_edges << ", tombstones=" << num_tombstones);
+    *this = compacted();
+}
+
+Graph Graph::compacted() const {
+    Graph result(num_vertices);
+    for (int u = 0; u < num_vertices; ++u) {
+        std::vector<Edge>& edges = result.adjList[u];
+        edges.reserve(adjList[u].size());
+        for (const auto& e : adjList[u]) {
+            if (!e.isRemoved()) edges.push_back(e);
+        }
+        edges.shrink_to_fit();
+    }
+    result.num_edges = num_edges;
+    result.generation = generation + 1;
+    result.version = version;   // same live edges, so cached results stay valid
+    result.removedVertices = removedVertices;
+    if (reverseEnabled) result.enableReverseEdges();
+
+    DEBUG_MEMORY("Compacted " << num_tombstones << " tombstones, " << num_edges << " edges remain");
+    return result;
+}
+
+std::future<Graph> Graph::compactAsync(std::shared_ptr<const Graph> snapshot) {
+    if (!snapshot) {
+        throw std::invalid_argument("Graph::compactAsync: null snapshot");
+    }
+    auto task = std::make_shared<std::packaged_task<Graph()>>([snapshot]() { return snapshot->compacted(); });
+    std::future<Graph> result = task->get_future();
+    parallelSpawn([task]() { (*task)(); });
+    return result;
+}
+
+bool Graph::adoptCompacted(Graph&& compacted_snapshot) {
+    if (compacted_snapshot.version != version || compacted_snapshot.num_vertices != num_vertices) {
+        DEBUG_PRINT("Graph::adoptCompacted: graph moved on from version " << compacted_snapshot.version
+                    << " to " << version << ", keeping it");
+        return false;
+    }
+    *this = std::move(compacted_snapshot);
+    return true;
 }
 
 std::vector<Edge> Graph::getConnections(int src) const {
@@ -76,6 +325,76 @@ std::vector<Edge> Graph::getConnections(int src) const {
     }
 }
 
+const std::vector<Edge>& Graph::neighbors(int src) const {
+    DEBUG_BOUNDS_CHECK(src, num_vertices, "source vertex in neighbors");
+    return this->adjList[src];
+}
+
+void Graph::enableReverseEdges() {
+    DEBUG_FUNCTION_ENTRY("Graph::enableReverseEdges", "n=" << num_vertices);
+    if (reverseEnabled) return;
+
+    std::vector<size_t> in_degree(num_vertices, 0);
+    for (const auto& edges : adjList) {
+        for (const auto& e : edges) in_degree[e.dest]++;
+    }
+
+    reverseAdjList.assign(num_vertices, std::vector<Edge>());
+    forwardSlot.assign(num_vertices, std::vector<int>());
+    reverseSlot.assign(num_vertices, std::vector<int>());
+    for (int v = 0; v < num_vertices; ++v) {
+        reverseAdjList[v].reserve(in_degree[v]);
+        forwardSlot[v].reserve(in_degree[v]);
+        reverseSlot[v].reserve(adjList[v].size());
+    }
+    for (int src = 0; src < num_vertices; ++src) {
+        for (size_t i = 0; i < adjList[src].size(); ++i) {
+            const Edge& e = adjList[src][i];
+            reverseSlot[src].push_back(static_cast<int>(reverseAdjList[e.dest].size()));
+            forwardSlot[e.dest].push_back(static_cast<int>(i));
+            reverseAdjList[e.dest].push_back(Edge{src, e.weight});
+        }
+    }
+    reverseEnabled = true;
+
+    DEBUG_MEMORY("Built reverse adjacency list with size=" << reverseAdjList.size());
+}
+
+void Graph::disableReverseEdges() {
+    reverseEnabled = false;
+    std::vector<std::vector<Edge>>().swap(reverseAdjList);
+    std::vector<std::vector<int>>().swap(reverseSlot);
+    std::vector<std::vector<int>>().swap(forwardSlot);
+}
+
+bool Graph::hasReverseEdges() const {
+    return reverseEnabled;
+}
+
+namespace {
+    template <typename T>
+    size_t nestedCapacityBytes(const std::vector<std::vector<T>>& lists) {
+        size_t bytes = lists.capacity() * sizeof(std::vector<T>);
+        for (const auto& list : lists) bytes += list.capacity() * sizeof(T);
+        return bytes;
+    }
+}
+
+size_t Graph::memoryUsage() const {
+    return sizeof(*this) + nestedCapacityBytes(adjList) + nestedCapacityBytes(reverseAdjList) +
+           nestedCapacityBytes(reverseSlot) + nestedCapacityBytes(forwardSlot) + removedVertices.capacity();
+}
+
+const std::vector<Edge>& Graph::reverseNeighbors(int dest) const {
+    DEBUG_BOUNDS_CHECK(dest, num_vertices, "destination vertex in reverseNeighbors");
+    if (!reverseEnabled) {
+        DEBUG_PRINT("WARNING: reverseNeighbors(" << dest << ") called without enableReverseEdges(), returning empty list");
+        static const std::vector<Edge> empty;
+        return empty;
+    }
+    return this->reverseAdjList[dest];
+}
+
 int Graph::getNumVertices() const {
     return this->num_vertices;
 }
@@ -0,0 +1,603 @@
+#include "GraphGenerators.h"
+#include "Parallel.h"
+#include "Debug.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    const size_t EDGE_GRAIN = 1 << 16;
+    const size_t VERTEX_GRAIN = 1 << 12;
+
+    // Stream salts so independent decisions never share random bits
+    const uint64_t SALT_PERMUTATION = 0x5045524d55544531ULL;
+    const uint64_t SALT_DROP = 0x44524f5053454731ULL;
+    const uint64_t SALT_DIAGONAL = 0x444941474f4e4131ULL;
+    const uint64_t SALT_CONGESTION = 0x434f4e4745535431ULL;
+
+    uint64_t mix64(uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Counter-based generator: the stream for item i depends only on (seed, i), so items can be
+    // generated in any order, on any thread, and regenerated later without storing them.
+    class CounterRng {
+        uint64_t state;
+    public:
+        CounterRng(uint64_t seed, uint64_t stream) : state(mix64(seed ^ mix64(stream))) {}
+
+        uint64_t next() {
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        double uniform() {
+            return static_cast<double>(next() >> 11) * 0x1.0p-53;
+        }
+    };
+
+    // Deterministic uniform in [0, 1) attached to the unordered pair {u, v}
+    double pairUniform(uint64_t seed, uint64_t salt, int u, int v) {
+        uint64_t lo = static_cast<uint64_t>(std::min(u, v));
+        uint64_t hi = static_cast<uint64_t>(std::max(u, v));
+        return CounterRng(seed ^ salt, (hi << 32) | lo).uniform();
+    }
+
+    int ceilLog2(int n) {
+        int scale = 0;
+        while ((int64_t(1) << scale) < n) scale++;
+        return scale;
+    }
+
+    // Cumulative quadrant thresholds for one recursion level, as 32-bit fixed point so each
+    // level costs one integer compare chain on half of a 64-bit draw
+    struct RMATLevel {
+        uint32_t a, ab, abc;
+    };
+
+    // Noise is drawn once per level for the whole graph (as in PaRMAT), which keeps the
+    // per-edge cost at one random half-word per level
+    std::vector<RMATLevel> makeRMATLevels(int scale, uint64_t seed, const RMATParams& params) {
+        std::vector<RMATLevel> levels(scale);
+        double d = std::max(0.0, 1.0 - params.a - params.b - params.c);
+        CounterRng rng(seed, ~0ULL);
+        for (int level = 0; level < scale; ++level) {
+            double a = params.a, b = params.b, c = params.c, dd = d;
+            if (params.noise > 0.0) {
+                a *= 1.0 - params.noise + 2.0 * params.noise * rng.uniform();
+                b *= 1.0 - params.noise + 2.0 * params.noise * rng.uniform();
+                c *= 1.0 - params.noise + 2.0 * params.noise * rng.uniform();
+                dd *= 1.0 - params.noise + 2.0 * params.noise * rng.uniform();
+            }
+            double total = a + b + c + dd;
+            const double full = 4294967295.0;
+            levels[level].a = static_cast<uint32_t>(full * a / total);
+            levels[level].ab = static_cast<uint32_t>(full * (a + b) / total);
+            levels[level].abc = static_cast<uint32_t>(full * (a + b + c) / total);
+        }
+        return levels;
+    }
+
+    bool drawRMATEdge(CounterRng& rng, const std::vector<RMATLevel>& levels, int n,
+                      bool allow_self_loops, int& src, int& dst) {
+        // Out-of-range ids and self loops are redrawn from the same stream; the cap only guards
+        // against degenerate parameters where almost every draw is rejected
+        for (int attempt = 0; attempt < 1024; ++attempt) {
+            int64_t u = 0, v = 0;
+            uint64_t bits = 0;
+            for (size_t level = 0; level < levels.size(); ++level) {
+                if ((level & 1) == 0) bits = rng.next();
+                uint32_t r = static_cast<uint32_t>(bits >> ((level & 1) * 32));
+                const RMATLevel& t = levels[level];
+                int u_bit = r >= t.ab ? 1 : 0;
+                int v_bit = (r >= t.a && r < t.ab) || r >= t.abc ? 1 : 0;
+                u = (u << 1) | u_bit;
+                v = (v << 1) | v_bit;
+            }
+            if (u >= n || v >= n) continue;
+            if (!allow_self_loops && u == v) continue;
+            src = static_cast<int>(u);
+            dst = static_cast<int>(v);
+            return true;
+        }
+        return false;
+    }
+
+    // Sort every adjacency segment by (target, weight) so output is independent of scatter order
+    void sortSegments(GeneratedGraph& g) {
+        parallelFor(0, g.num_vertices, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+            std::vector<std::pair<int, double>> tmp;
+            for (size_t v = lo; v < hi; ++v) {
+                int64_t begin = g.offsets[v], end = g.offsets[v + 1];
+                if (end - begin < 2) continue;
+                tmp.clear();
+                for (int64_t e = begin; e < end; ++e) {
+                    tmp.emplace_back(g.targets[e], g.weights[e]);
+                }
+                std::sort(tmp.begin(), tmp.end());
+                for (int64_t e = begin; e < end; ++e) {
+                    g.targets[e] = tmp[e - begin].first;
+                    g.weights[e] = tmp[e - begin].second;
+                }
+            }
+        });
+    }
+
+    // Drop parallel edges, keeping the lightest (segments must already be sorted)
+    void removeDuplicateEdges(GeneratedGraph& g) {
+        int n = g.num_vertices;
+        std::vector<int64_t> kept(n, 0);
+        parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                int64_t begin = g.offsets[v], end = g.offsets[v + 1];
+                int64_t out = begin;
+                for (int64_t e = begin; e < end; ++e) {
+                    if (out > begin && g.targets[out - 1] == g.targets[e]) continue;
+                    g.targets[out] = g.targets[e];
+                    g.weights[out] = g.weights[e];
+                    out++;
+                }
+                kept[v] = out - begin;
+            }
+        });
+
+        int64_t write = 0;
+        for (int v = 0; v < n; ++v) {
+            int64_t begin = g.offsets[v];
+            g.offsets[v] = write;
+            if (write != begin) {
+                std::copy(g.targets.begin() + begin, g.targets.begin() + begin + kept[v], g.targets.begin() + write);
+                std::copy(g.weights.begin() + begin, g.weights.begin() + begin + kept[v], g.weights.begin() + write);
+            }
+            write += kept[v];
+        }
+        g.offsets[n] = write;
+        g.targets.resize(write);
+        g.weights.resize(write);
+        g.targets.shrink_to_fit();
+        g.weights.shrink_to_fit();
+    }
+
+    // Two-pass R-MAT: count degrees, then regenerate the identical edge stream and scatter it
+    // straight into its CSR slot. No intermediate edge list is ever materialized.
+    GeneratedGraph buildRMAT(int n, int64_t num_edges, uint64_t seed, const RMATParams& params,
+                             const std::vector<int>* relabel) {
+        GeneratedGraph g;
+        g.num_vertices = n;
+        g.offsets.assign(static_cast<size_t>(n) + 1, 0);
+        if (n <= 0) return g;
+        if (n < 2 && !params.allow_self_loops) num_edges = 0;
+
+        std::vector<RMATLevel> levels = makeRMATLevels(ceilLog2(n), seed, params);
+        double weight_span = params.max_weight - params.min_weight;
+
+        std::unique_ptr<std::atomic<int64_t>[]> cursor(new std::atomic<int64_t>[n]);
+        for (int v = 0; v < n; ++v) cursor[v].store(0, std::memory_order_relaxed);
+
+        auto forEachEdge = [&](auto&& emit) {
+            parallelFor(0, static_cast<size_t>(num_edges), EDGE_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    CounterRng rng(seed, i);
+                    int src, dst;
+                    if (!drawRMATEdge(rng, levels, n, params.allow_self_loops, src, dst)) continue;
+                    double weight = params.min_weight + weight_span * rng.uniform();
+                    if (relabel) {
+                        src = (*relabel)[src];
+                        dst = (*relabel)[dst];
+                    }
+                    emit(src, dst, weight);
+                }
+            });
+        };
+
+        forEachEdge([&](int src, int, double) {
+            cursor[src].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        for (int v = 0; v < n; ++v) {
+            g.offsets[v + 1] = g.offsets[v] + cursor[v].load(std::memory_order_relaxed);
+            cursor[v].store(g.offsets[v], std::memory_order_relaxed);
+        }
+        g.targets.resize(g.offsets[n]);
+        g.weights.resize(g.offsets[n]);
+
+        DEBUG_MEMORY("R-MAT CSR arrays allocated for " << g.offsets[n] << " edges");
+
+        forEachEdge([&](int src, int dst, double weight) {
+            int64_t slot = cursor[src].fetch_add(1, std::memory_order_relaxed);
+            g.targets[slot] = dst;
+            g.weights[slot] = weight;
+        });
+
+        sortSegments(g);
+        if (params.remove_duplicate_edges) {
+            removeDuplicateEdges(g);
+        }
+        return g;
+    }
+}
+
+int64_t GeneratedGraph::getNumEdges() const {
+    return offsets.empty() ? 0 : offsets.back();
+}
+
+bool GeneratedGraph::hasCoordinates() const {
+    return !x.empty() && x.size() == static_cast<size_t>(num_vertices) && y.size() == x.size();
+}
+
+Graph GeneratedGraph::toGraph() const {
+    DEBUG_FUNCTION_ENTRY("GeneratedGraph::toGraph", "n=" << num_vertices << ", m=" << getNumEdges());
+
+    std::vector<std::vector<Edge>> adjacency(num_vertices);
+    parallelFor(0, num_vertices, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            auto& row = adjacency[v];
+            row.reserve(offsets[v + 1] - offsets[v]);
+            for (int64_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                Edge edge;
+                edge.dest = targets[e];
+                edge.weight = weights[e];
+                row.push_back(edge);
+            }
+        }
+    });
+    return Graph(num_vertices, std::move(adjacency));
+}
+
+GeneratedGraph GeneratedGraph::fromGraph(const Graph& graph) {
+    GeneratedGraph result;
+    int n = graph.getNumVertices();
+    result.num_vertices = n;
+    result.offsets.assign(n + 1, 0);
+    std::vector<std::pair<int, double>> row;
+    for (int u = 0; u < n; ++u) {
+        row.clear();
+        for (const auto& edge : graph.neighbors(u)) {
+            if (!edge.isRemoved()) row.push_back({edge.dest, edge.weight});
+        }
+        std::sort(row.begin(), row.end());
+        for (const auto& edge : row) {
+            result.targets.push_back(edge.first);
+            result.weights.push_back(edge.second);
+        }
+        result.offsets[u + 1] = static_cast<int64_t>(result.targets.size());
+    }
+    return result;
+}
+
+namespace {
+    const char GRAPH_MAGIC[4] = {'F', 'D', 'G', 'R'};
+    const uint32_t GRAPH_FORMAT_VERSION = 1;
+
+    template <typename T>
+    void writeArray(std::ofstream& out, const std::vector<T>& values) {
+        if (!values.empty()) {
+            out.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+        }
+    }
+
+    template <typename T>
+    void readValue(std::ifstream& in, T& value, const std::string& path) {
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("GeneratedGraph::load: truncated file " + path);
+        }
+    }
+
+    uint64_t remainingBytes(std::ifstream& in) {
+        std::streampos here = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(here);
+        return end > here ? static_cast<uint64_t>(end - here) : 0;
+    }
+
+    template <typename T>
+    void readArray(std::ifstream& in, std::vector<T>& values, size_t count, const std::string& path) {
+        // Counts come from the file; check them against its size before allocating
+        if (count > remainingBytes(in) / sizeof(T)) {
+            throw std::runtime_error("GeneratedGraph::load: truncated file " + path);
+        }
+        values.resize(count);
+        if (count > 0 && !in.read(reinterpret_cast<char*>(values.data()), sizeof(T) * count)) {
+            throw std::runtime_error("GeneratedGraph::load: truncated file " + path);
+        }
+    }
+}
+
+void GeneratedGraph::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("GeneratedGraph::save: cannot open " + path);
+    }
+    int32_t n = num_vertices;
+    int64_t m = getNumEdges();
+    uint8_t coordinates = hasCoordinates() ? 1 : 0;
+    out.write(GRAPH_MAGIC, sizeof(GRAPH_MAGIC));
+    out.write(reinterpret_cast<const char*>(&GRAPH_FORMAT_VERSION), sizeof(GRAPH_FORMAT_VERSION));
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(&m), sizeof(m));
+    out.write(reinterpret_cast<const char*>(&coordinates), sizeof(coordinates));
+    writeArray(out, offsets);
+    writeArray(out, targets);
+    writeArray(out, weights);
+    if (coordinates) {
+        writeArray(out, x);
+        writeArray(out, y);
+    }
+    if (!out) {
+        throw std::runtime_error("GeneratedGraph::save: write failed for " + path);
+    }
+}
+
+GeneratedGraph GeneratedGraph::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("GeneratedGraph::load: cannot open " + path);
+    }
+    char magic[sizeof(GRAPH_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, GRAPH_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("GeneratedGraph::load: " + path + " is not a graph file");
+    }
+    uint32_t version = 0;
+    readValue(in, version, path);
+    if (version != GRAPH_FORMAT_VERSION) {
+        throw std::runtime_error("GeneratedGraph::load: unsupported format version " + std::to_string(version) +
+                                 " in " + path);
+    }
+    int32_t n = 0;
+    int64_t m = 0;
+    uint8_t coordinates = 0;
+    readValue(in, n, path);
+    readValue(in, m, path);
+    readValue(in, coordinates, path);
+    if (n < 0 || m < 0) {
+        throw std::runtime_error("GeneratedGraph::load: negative size in " + path);
+    }
+
+    GeneratedGraph graph;
+    graph.num_vertices = n;
+    readArray(in, graph.offsets, static_cast<size_t>(n) + 1, path);
+    if (graph.offsets[0] != 0 || graph.offsets[n] != m) {
+        throw std::runtime_error("GeneratedGraph::load: corrupt offsets in " + path);
+    }
+    for (int v = 0; v < n; ++v) {
+        if (graph.offsets[v + 1] < graph.offsets[v]) {
+            throw std::runtime_error("GeneratedGraph::load: corrupt offsets in " + path);
+        }
+    }
+    readArray(in, graph.targets, static_cast<size_t>(m), path);
+    readArray(in, graph.weights, static_cast<size_t>(m), path);
+    for (int target : graph.targets) {
+        if (target < 0 || target >= n) {
+            throw std::runtime_error("GeneratedGraph::load: edge target out of range in " + path);
+        }
+    }
+    for (double weight : graph.weights) {
+        // Graph would take inf for a deleted edge
+        if (!std::isfinite(weight) || weight < 0.0) {
+            throw std::runtime_error("GeneratedGraph::load: negative or non-finite edge weight in " + path);
+        }
+    }
+    if (coordinates) {
+        readArray(in, graph.x, static_cast<size_t>(n), path);
+        readArray(in, graph.y, static_cast<size_t>(n), path);
+    }
+    DEBUG_PRINT("Loaded graph from " << path << ": n=" << n << ", m=" << m);
+    return graph;
+}
+
+GeneratedGraph generateRMAT(int num_vertices, int64_t num_edges, uint64_t seed, const RMATParams& params) {
+    DEBUG_FUNCTION_ENTRY("generateRMAT", "n=" << num_vertices << ", m=" << num_edges << ", seed=" << seed);
+
+    GeneratedGraph g = buildRMAT(num_vertices, num_edges, seed, params, nullptr);
+
+    DEBUG_FUNCTION_EXIT("generateRMAT", "edges=" << g.getNumEdges());
+    return g;
+}
+
+GeneratedGraph generateKronecker(int scale, int edge_factor, uint64_t seed, const RMATParams& params) {
+    DEBUG_FUNCTION_ENTRY("generateKronecker", "scale=" << scale << ", edge_factor=" << edge_factor << ", seed=" << seed);
+
+    int n = 1 << scale;
+    int64_t num_edges = static_cast<int64_t>(edge_factor) * n;
+
+    // Graph500 scrambles labels so vertex id carries no information about degree
+    std::vector<int> relabel(n);
+    std::iota(relabel.begin(), relabel.end(), 0);
+    CounterRng rng(seed, SALT_PERMUTATION);
+    for (int i = n - 1; i > 0; --i) {
+        int j = static_cast<int>(rng.next() % static_cast<uint64_t>(i + 1));
+        std::swap(relabel[i], relabel[j]);
+    }
+
+    GeneratedGraph g = buildRMAT(n, num_edges, seed, params, &relabel);
+
+    DEBUG_FUNCTION_EXIT("generateKronecker", "edges=" << g.getNumEdges());
+    return g;
+}
+
+GeneratedGraph generateRandomGeometric(int num_vertices, double radius, uint64_t seed, const GeometricParams& params) {
+    DEBUG_FUNCTION_ENTRY("generateRandomGeometric", "n=" << num_vertices << ", radius=" << radius << ", seed=" << seed);
+    // A zero, negative or NaN radius would fall into the single-cell all-pairs scan below
+    if (!(radius > 0.0) || !std::isfinite(radius)) {
+        throw std::invalid_argument("generateRandomGeometric: radius must be finite and positive, got " +
+                                    std::to_string(radius));
+    }
+
+    GeneratedGraph g;
+    int n = std::max(0, num_vertices);
+    g.num_vertices = n;
+    g.offsets.assign(static_cast<size_t>(n) + 1, 0);
+    g.x.resize(n);
+    g.y.resize(n);
+    if (n == 0) return g;
+
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            CounterRng rng(seed, v);
+            g.x[v] = rng.uniform();
+            g.y[v] = rng.uniform();
+        }
+    });
+
+    // Bucket points into cells at least `radius` wide so only the 3x3 neighbourhood is scanned;
+    // the cell count is capped near n to keep the bucket array linear in size
+    double max_cells = std::floor(1.0 / radius);
+    double cap = std::ceil(std::sqrt(static_cast<double>(n)));
+    int cells = static_cast<int>(std::max(1.0, std::min(max_cells, cap)));
+    auto cellOf = [cells](double coord) {
+        return std::min(cells - 1, static_cast<int>(coord * cells));
+    };
+
+    std::vector<int64_t> cell_start(static_cast<size_t>(cells) * cells + 1, 0);
+    std::vector<int> cell_points(n);
+    for (int v = 0; v < n; ++v) {
+        cell_start[static_cast<size_t>(cellOf(g.y[v])) * cells + cellOf(g.x[v]) + 1]++;
+    }
+    for (size_t c = 1; c < cell_start.size(); ++c) cell_start[c] += cell_start[c - 1];
+    {
+        std::vector<int64_t> fill(cell_start.begin(), cell_start.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            cell_points[fill[static_cast<size_t>(cellOf(g.y[v])) * cells + cellOf(g.x[v])]++] = v;
+        }
+    }
+
+    double r2 = radius * radius;
+    auto visitNeighbours = [&](int v, auto&& visit) {
+        int cx = cellOf(g.x[v]), cy = cellOf(g.y[v]);
+        for (int ny = std::max(0, cy - 1); ny <= std::min(cells - 1, cy + 1); ++ny) {
+            for (int nx = std::max(0, cx - 1); nx <= std::min(cells - 1, cx + 1); ++nx) {
+                size_t cell = static_cast<size_t>(ny) * cells + nx;
+                for (int64_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+                    int u = cell_points[i];
+                    if (u == v) continue;
+                    double dx = g.x[u] - g.x[v], dy = g.y[u] - g.y[v];
+                    double d2 = dx * dx + dy * dy;
+                    if (d2 < r2) visit(u, std::sqrt(d2));
+                }
+            }
+        }
+    };
+
+    std::vector<int64_t> degree(n, 0);
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            visitNeighbours(static_cast<int>(v), [&](int, double) { degree[v]++; });
+        }
+    });
+    for (int v = 0; v < n; ++v) g.offsets[v + 1] = g.offsets[v] + degree[v];
+    g.targets.resize(g.offsets[n]);
+    g.weights.resize(g.offsets[n]);
+
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            int64_t slot = g.offsets[v];
+            visitNeighbours(static_cast<int>(v), [&](int u, double length) {
+                g.targets[slot] = u;
+                g.weights[slot] = std::max(length, 1e-12) * params.weight_scale;
+                slot++;
+            });
+        }
+    });
+
+    sortSegments(g);
+
+    DEBUG_FUNCTION_EXIT("generateRandomGeometric", "edges=" << g.getNumEdges());
+    return g;
+}
+
+GeneratedGraph generateRoadGrid(int rows, int cols, uint64_t seed, const RoadGridParams& params) {
+    DEBUG_FUNCTION_ENTRY("generateRoadGrid", "rows=" << rows << ", cols=" << cols << ", seed=" << seed);
+
+    GeneratedGraph g;
+    rows = std::max(0, rows);
+    cols = std::max(0, cols);
+    int n = rows * cols;
+    g.num_vertices = n;
+    g.offsets.assign(static_cast<size_t>(n) + 1, 0);
+    g.x.resize(n);
+    g.y.resize(n);
+    if (n == 0) return g;
+
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            CounterRng rng(seed, v);
+            g.x[v] = (v % cols) + params.jitter * (rng.uniform() - 0.5);
+            g.y[v] = (v / cols) + params.jitter * (rng.uniform() - 0.5);
+        }
+    });
+
+    auto isHighway = [&](int r1, int c1, int r2, int c2) {
+        if (params.highway_spacing <= 0) return false;
+        if (r1 == r2) return r1 % params.highway_spacing == 0;
+        if (c1 == c2) return c1 % params.highway_spacing == 0;
+        return false;
+    };
+
+    // Every decision is a function of the unordered vertex pair, so both directions agree
+    // and each vertex can fill its own CSR row independently
+    auto visitNeighbours = [&](int v, auto&& visit) {
+        int r = v / cols, c = v % cols;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if (dr == 0 && dc == 0) continue;
+                int nr = r + dr, nc = c + dc;
+                if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) continue;
+                int u = nr * cols + nc;
+
+                bool highway = isHighway(r, c, nr, nc);
+                if (dr != 0 && dc != 0) {
+                    if (pairUniform(seed, SALT_DIAGONAL, u, v) >= params.diagonal_probability) continue;
+                } else if (!highway && pairUniform(seed, SALT_DROP, u, v) < params.drop_probability) {
+                    continue;
+                }
+
+                double dx = g.x[u] - g.x[v], dy = g.y[u] - g.y[v];
+                double length = std::sqrt(dx * dx + dy * dy);
+                double speed = highway ? params.highway_speed : 1.0;
+                double congestion = 1.0 + params.congestion * pairUniform(seed, SALT_CONGESTION, u, v);
+                visit(u, std::max(length, 1e-9) * congestion * params.weight_scale / speed);
+            }
+        }
+    };
+
+    std::vector<int64_t> degree(n, 0);
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            visitNeighbours(static_cast<int>(v), [&](int, double) { degree[v]++; });
+        }
+    });
+    for (int v = 0; v < n; ++v) g.offsets[v + 1] = g.offsets[v] + degree[v];
+    g.targets.resize(g.offsets[n]);
+    g.weights.resize(g.offsets[n]);
+
+    // Neighbours are visited in increasing id order, so rows come out already sorted
+    parallelFor(0, n, VERTEX_GRAIN, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            int64_t slot = g.offsets[v];
+            visitNeighbours(static_cast<int>(v), [&](int u, double weight) {
+                g.targets[slot] = u;
+                g.weights[slot] = weight;
+                slot++;
+            });
+        }
+    });
+
+    DEBUG_FUNCTION_EXIT("generateRoadGrid", "edges=" << g.getNumEdges());
+    return g;
+}
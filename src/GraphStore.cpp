@@ -0,0 +1,69 @@
+#include "GraphStore.h"
+#include "Debug.h"
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+GraphStore::GraphStore(Graph initial) : GraphStore(std::make_shared<const Graph>(std::move(initial))) {}
+
+GraphStore::GraphStore(std::shared_ptr<const Graph> initial) : current(std::move(initial)), epoch(0) {
+    if (!current) {
+        throw std::invalid_argument("GraphStore: null initial graph");
+    }
+}
+
+std::shared_ptr<const Graph> GraphStore::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+uint64_t GraphStore::getEpoch() const {
+    return epoch.load();
+}
+
+uint64_t GraphStore::publishLocked(std::shared_ptr<const Graph> next) {
+    std::atomic_store(&current, std::move(next));
+    uint64_t published = epoch.fetch_add(1) + 1;
+    DEBUG_PRINT("GraphStore: published epoch " << published);
+    return published;
+}
+
+uint64_t GraphStore::publish(Graph next) {
+    auto version = std::make_shared<const Graph>(std::move(next));
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return publishLocked(std::move(version));
+}
+
+uint64_t GraphStore::update(const std::function<void(Graph&)>& mutate) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    auto next = std::make_shared<Graph>(*std::atomic_load(&current));
+    mutate(*next);
+    return publishLocked(std::move(next));
+}
+
+uint64_t GraphStore::applyUpdates(const std::vector<EdgeUpdate>& updates) {
+    DEBUG_FUNCTION_ENTRY("GraphStore::applyUpdates", "updates.size()=" << updates.size());
+    const double INF = std::numeric_limits<double>::max();
+
+    return update([&](Graph& graph) {
+        int n = graph.getNumVertices();
+        for (const auto& edge : updates) {
+            if (edge.src < 0 || edge.src >= n || edge.dest < 0 || edge.dest >= n) {
+                throw std::invalid_argument("GraphStore: edge (" + std::to_string(edge.src) + ", " +
+                                            std::to_string(edge.dest) + ") out of range");
+            }
+            if (!(edge.weight >= 0.0)) {
+                throw std::invalid_argument("GraphStore: negative or NaN weight on edge (" +
+                                            std::to_string(edge.src) + ", " + std::to_string(edge.dest) + ")");
+            }
+        }
+        for (const auto& edge : updates) {
+            if (edge.weight >= INF) {
+                graph.removeEdge(edge.src, edge.dest);
+            } else if (!graph.setEdgeWeight(edge.src, edge.dest, edge.weight)) {
+                graph.addEdge(edge.src, edge.dest, edge.weight);
+            }
+        }
+        if (graph.needsCompaction()) graph.compact();
+    });
+}
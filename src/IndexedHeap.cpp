@@ -0,0 +1,114 @@
+#include "IndexedHeap.h"
+#include "Debug.h"
+
+namespace {
+    const size_t ARITY = 4;
+}
+
+IndexedHeap::IndexedHeap(int capacity) {
+    resize(capacity);
+}
+
+void IndexedHeap::resize(int capacity) {
+    DEBUG_MEMORY("IndexedHeap resize to capacity=" << capacity);
+    heap.clear();
+    position.assign(capacity > 0 ? capacity : 0, -1);
+}
+
+int IndexedHeap::capacity() const {
+    return static_cast<int>(position.size());
+}
+
+bool IndexedHeap::empty() const {
+    return heap.empty();
+}
+
+size_t IndexedHeap::size() const {
+    return heap.size();
+}
+
+bool IndexedHeap::contains(int vertex) const {
+    return position[vertex] >= 0;
+}
+
+double IndexedHeap::getKey(int vertex) const {
+    return heap[position[vertex]].key;
+}
+
+bool IndexedHeap::pushOrDecrease(int vertex, double key) {
+    int idx = position[vertex];
+    if (idx < 0) {
+        heap.push_back({key, vertex});
+        position[vertex] = static_cast<int>(heap.size() - 1);
+        siftUp(heap.size() - 1);
+        return true;
+    }
+    if (key >= heap[idx].key) return false;
+    heap[idx].key = key;
+    siftUp(idx);
+    return true;
+}
+
+std::pair<int, double> IndexedHeap::top() const {
+    return {heap.front().vertex, heap.front().key};
+}
+
+std::pair<int, double> IndexedHeap::pop() {
+    Entry root = heap.front();
+    position[root.vertex] = -1;
+
+    Entry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        position[last.vertex] = 0;
+        siftDown(0);
+    }
+    return {root.vertex, root.key};
+}
+
+void IndexedHeap::clear() {
+    for (const auto& entry : heap) {
+        position[entry.vertex] = -1;
+    }
+    heap.clear();
+}
+
+size_t IndexedHeap::memoryUsage() const {
+    return sizeof(*this) + heap.capacity() * sizeof(Entry) + position.capacity() * sizeof(int);
+}
+
+void IndexedHeap::siftUp(size_t idx) {
+    Entry moving = heap[idx];
+    while (idx > 0) {
+        size_t parent = (idx - 1) / ARITY;
+        if (heap[parent].key <= moving.key) break;
+        heap[idx] = heap[parent];
+        position[heap[idx].vertex] = static_cast<int>(idx);
+        idx = parent;
+    }
+    heap[idx] = moving;
+    position[moving.vertex] = static_cast<int>(idx);
+}
+
+void IndexedHeap::siftDown(size_t idx) {
+    Entry moving = heap[idx];
+    size_t count = heap.size();
+    while (true) {
+        size_t first_child = idx * ARITY + 1;
+        if (first_child >= count) break;
+
+        size_t best = first_child;
+        size_t last_child = first_child + ARITY < count ? first_child + ARITY : count;
+        for (size_t child = first_child + 1; child < last_child; ++child) {
+            if (heap[child].key < heap[best].key) best = child;
+        }
+        if (heap[best].key >= moving.key) break;
+
+        heap[idx] = heap[best];
+        position[heap[idx].vertex] = static_cast<int>(idx);
+        idx = best;
+    }
+    heap[idx] = moving;
+    position[moving.vertex] = static_cast<int>(idx);
+}
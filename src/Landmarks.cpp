@@ -0,0 +1,467 @@
+#include "Landmarks.h"
+#include "Dijkstra.h"
+#include "Parallel.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    const double INF = std::numeric_limits<double>::max();
+    const uint16_t HALF_INFINITY = 0x7C00;
+    const uint16_t HALF_MAX_FINITE = 0x7BFF;
+
+    // IEEE binary16 -> double for every bit pattern; infinity maps to the library's max()
+    const std::vector<double>& halfTable() {
+        static const std::vector<double> table = [] {
+            std::vector<double> values(65536);
+            for (uint32_t h = 0; h < 65536; ++h) {
+                int exponent = (h >> 10) & 0x1F;
+                int fraction = h & 0x3FF;
+                double magnitude;
+                if (exponent == 0) {
+                    magnitude = std::ldexp(static_cast<double>(fraction), -24);
+                } else if (exponent == 31) {
+                    magnitude = INF;
+                } else {
+                    magnitude = std::ldexp(1.0 + fraction / 1024.0, exponent - 15);
+                }
+                values[h] = (h & 0x8000) && magnitude != INF ? -magnitude : magnitude;
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // Largest non-negative half <= q
+    uint16_t halfRoundDown(double q) {
+        if (q == INF) return HALF_INFINITY;
+        if (q <= 0.0) return 0;
+        if (q >= 65504.0) return HALF_MAX_FINITE;
+
+        int e;
+        double m = std::frexp(q, &e);   // q = m * 2^e, m in [0.5, 1)
+        int exponent = e - 1 + 15;
+        if (exponent <= 0) {
+            return static_cast<uint16_t>(std::floor(std::ldexp(q, 24)));   // subnormal
+        }
+        int fraction = static_cast<int>(std::floor((2.0 * m - 1.0) * 1024.0));
+        return static_cast<uint16_t>((exponent << 10) | fraction);
+    }
+
+    // Largest float <= d (infinite stays infinite)
+    float floatRoundDown(double d) {
+        if (d == INF) return std::numeric_limits<float>::infinity();
+        if (d >= static_cast<double>(std::numeric_limits<float>::max())) return std::numeric_limits<float>::max();
+        float f = static_cast<float>(d);
+        if (static_cast<double>(f) > d) f = std::nextafter(f, 0.0f);
+        return f;
+    }
+
+    double floatValue(float f) {
+        return std::isinf(f) ? INF : static_cast<double>(f);
+    }
+
+    // Exact bound from the double tables, used while selecting landmarks
+    double exactLowerBound(const std::vector<std::vector<double>>& forward,
+                           const std::vector<std::vector<double>>& backward, int v, int t) {
+        double bound = 0.0;
+        for (size_t l = 0; l < forward.size(); ++l) {
+            double from_v = forward[l][v], from_t = forward[l][t];
+            if (from_t == INF) {
+                if (from_v != INF) return INF;
+            } else if (from_v != INF) {
+                bound = std::max(bound, from_t - from_v);
+            }
+            double v_to = backward[l][v], t_to = backward[l][t];
+            if (v_to == INF) {
+                if (t_to != INF) return INF;
+            } else if (t_to != INF) {
+                bound = std::max(bound, v_to - t_to);
+            }
+        }
+        return bound;
+    }
+
+    Graph reverseOf(const Graph& graph) {
+        int n = graph.getNumVertices();
+        std::vector<std::vector<Edge>> reversed(n);
+        if (graph.hasReverseEdges()) {
+            for (int v = 0; v < n; ++v) reversed[v] = graph.reverseNeighbors(v);
+        } else {
+            for (int u = 0; u < n; ++u) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    reversed[edge.dest].push_back(Edge{u, edge.weight});
+                }
+            }
+        }
+        return Graph(n, std::move(reversed));
+    }
+
+    // Vertex farthest from the chosen landmarks (min over landmarks of the closer direction),
+    // ignoring vertices no landmark reaches in either direction. -1 if there is none.
+    int farthestCandidate(const std::vector<std::vector<double>>& forward,
+                          const std::vector<std::vector<double>>& backward,
+                          const std::vector<char>& is_landmark) {
+        int best = -1;
+        double best_score = -1.0;
+        int n = static_cast<int>(is_landmark.size());
+        for (int v = 0; v < n; ++v) {
+            if (is_landmark[v]) continue;
+            double score = INF;
+            for (size_t l = 0; l < forward.size(); ++l) {
+                score = std::min(score, std::min(forward[l][v], backward[l][v]));
+            }
+            if (score != INF && score > best_score) {
+                best_score = score;
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    // Goldberg-Werneck "avoid": grow a shortest-path tree from a random root, weight each
+    // vertex by how badly the current landmarks bound its distance from the root, and walk
+    // down the heaviest landmark-free subtree to a leaf. -1 if every subtree holds a landmark.
+    int avoidCandidate(const Graph& graph, int root,
+                       const std::vector<std::vector<double>>& forward,
+                       const std::vector<std::vector<double>>& backward,
+                       const std::vector<char>& is_landmark) {
+        int n = graph.getNumVertices();
+        DijkstraResults tree = runDijkstra(graph, root);
+
+        std::vector<std::vector<int>> children(n);
+        for (int v = 0; v < n; ++v) {
+            int parent = tree.predecessors[v];
+            if (parent >= 0 && v != root) children[parent].push_back(v);
+        }
+
+        // Pre-order from the root; reversed, every child precedes its parent
+        std::vector<int> order;
+        order.push_back(root);
+        for (size_t i = 0; i < order.size(); ++i) {
+            for (int child : children[order[i]]) order.push_back(child);
+        }
+
+        std::vector<double> size(n, 0.0);
+        std::vector<char> holds_landmark(n, 0);
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int v = *it;
+            holds_landmark[v] = is_landmark[v];
+            double total = tree.distances[v] - exactLowerBound(forward, backward, root, v);
+            for (int child : children[v]) {
+                holds_landmark[v] |= holds_landmark[child];
+                total += size[child];
+            }
+            size[v] = holds_landmark[v] ? 0.0 : total;
+        }
+
+        if (size[root] <= 0.0) return -1;
+        int v = root;
+        while (true) {
+            int next = -1;
+            for (int child : children[v]) {
+                if (size[child] > 0.0 && (next < 0 || size[child] > size[next])) next = child;
+            }
+            if (next < 0) break;
+            v = next;
+        }
+        return v;
+    }
+}
+
+LandmarkIndex::LandmarkIndex()
+    : num_vertices(0), precision(LandmarkPrecision::FLOAT32), half_scale(1.0) {
+}
+
+LandmarkIndex LandmarkIndex::build(const Graph& graph, const LandmarkParams& params) {
+    if (params.num_landmarks < 1) {
+        throw std::invalid_argument("LandmarkIndex::build: num_landmarks must be positive, got " +
+                                    std::to_string(params.num_landmarks));
+    }
+
+    int n = graph.getNumVertices();
+    int k = std::min(params.num_landmarks, n);
+    DEBUG_FUNCTION_ENTRY("LandmarkIndex::build", "n=" << n << ", landmarks=" << k);
+
+    LandmarkIndex index;
+    index.num_vertices = n;
+    index.precision = params.precision;
+    if (k == 0) return index;
+
+    Graph reversed = reverseOf(graph);
+    std::mt19937_64 rng(params.seed);
+    std::vector<std::vector<double>> forward, backward;
+    std::vector<char> is_landmark(n, 0);
+
+    auto addLandmark = [&](int landmark) {
+        index.landmarks.push_back(landmark);
+        is_landmark[landmark] = 1;
+        forward.emplace_back();
+        backward.emplace_back();
+        // The two directions are independent searches
+        parallelFor(0, 2, 1, [&](size_t lo, size_t hi) {
+            for (size_t direction = lo; direction < hi; ++direction) {
+                if (direction == 0) {
+                    forward.back() = runDijkstra(graph, landmark).distances;
+                } else {
+                    backward.back() = runDijkstra(reversed, landmark).distances;
+                }
+            }
+        });
+        DEBUG_PRINT("Landmark " << index.landmarks.size() - 1 << " = vertex " << landmark);
+    };
+
+    // First landmark: the vertex farthest from a random start (the start itself if it is isolated)
+    int start = static_cast<int>(rng() % static_cast<uint64_t>(n));
+    std::vector<double> from_start = runDijkstra(graph, start).distances;
+    int first = start;
+    for (int v = 0; v < n; ++v) {
+        if (from_start[v] != INF && from_start[v] > from_start[first]) first = v;
+    }
+    addLandmark(first);
+
+    while (static_cast<int>(index.landmarks.size()) < k) {
+        int candidate = -1;
+        if (params.strategy == LandmarkStrategy::AVOID) {
+            int root = static_cast<int>(rng() % static_cast<uint64_t>(n));
+            candidate = avoidCandidate(graph, root, forward, backward, is_landmark);
+        }
+        if (candidate < 0) candidate = farthestCandidate(forward, backward, is_landmark);
+        if (candidate < 0) {
+            // Everything reachable is covered; spread the rest over unreached vertices
+            for (int v = 0; v < n && candidate < 0; ++v) {
+                if (!is_landmark[v]) candidate = v;
+            }
+        }
+        addLandmark(candidate);
+    }
+
+    // Vertex-major compact tables
+    size_t cells = static_cast<size_t>(n) * k;
+    if (params.precision == LandmarkPrecision::FLOAT32) {
+        index.from_landmark32.resize(cells);
+        index.to_landmark32.resize(cells);
+    } else {
+        double max_finite = 0.0;
+        for (int l = 0; l < k; ++l) {
+            for (int v = 0; v < n; ++v) {
+                if (forward[l][v] != INF) max_finite = std::max(max_finite, forward[l][v]);
+                if (backward[l][v] != INF) max_finite = std::max(max_finite, backward[l][v]);
+            }
+        }
+        // Power of two, so scaling is exact and the largest distance maps below 2^15
+        index.half_scale = max_finite > 0.0 ? std::ldexp(1.0, static_cast<int>(std::ceil(std::log2(max_finite / 32768.0)))) : 1.0;
+        index.from_landmark16.resize(cells);
+        index.to_landmark16.resize(cells);
+    }
+
+    parallelFor(0, n, 4096, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            for (int l = 0; l < k; ++l) {
+                size_t cell = v * k + l;
+                if (params.precision == LandmarkPrecision::FLOAT32) {
+                    index.from_landmark32[cell] = floatRoundDown(forward[l][v]);
+                    index.to_landmark32[cell] = floatRoundDown(backward[l][v]);
+                } else {
+                    double from = forward[l][v], to = backward[l][v];
+                    index.from_landmark16[cell] = halfRoundDown(from == INF ? INF : from / index.half_scale);
+                    index.to_landmark16[cell] = halfRoundDown(to == INF ? INF : to / index.half_scale);
+                }
+            }
+        }
+    });
+
+    DEBUG_FUNCTION_EXIT("LandmarkIndex::build", "landmarks=" << k << ", table_bytes=" << index.tableBytes());
+    return index;
+}
+
+void LandmarkIndex::fromLandmark(int v, int l, double& lower, double& upper) const {
+    size_t cell = static_cast<size_t>(v) * landmarks.size() + l;
+    if (precision == LandmarkPrecision::FLOAT32) {
+        float f = from_landmark32[cell];
+        lower = floatValue(f);
+        upper = floatValue(std::nextafter(f, std::numeric_limits<float>::infinity()));
+    } else {
+        uint16_t h = from_landmark16[cell];
+        const std::vector<double>& table = halfTable();
+        lower = h == HALF_INFINITY ? INF : table[h] * half_scale;
+        upper = h >= HALF_MAX_FINITE ? INF : table[h + 1] * half_scale;
+    }
+}
+
+void LandmarkIndex::toLandmark(int v, int l, double& lower, double& upper) const {
+    size_t cell = static_cast<size_t>(v) * landmarks.size() + l;
+    if (precision == LandmarkPrecision::FLOAT32) {
+        float f = to_landmark32[cell];
+        lower = floatValue(f);
+        upper = floatValue(std::nextafter(f, std::numeric_limits<float>::infinity()));
+    } else {
+        uint16_t h = to_landmark16[cell];
+        const std::vector<double>& table = halfTable();
+        lower = h == HALF_INFINITY ? INF : table[h] * half_scale;
+        upper = h >= HALF_MAX_FINITE ? INF : table[h + 1] * half_scale;
+    }
+}
+
+double LandmarkIndex::lowerBound(int v, int target, const int* active, int count) const {
+    double bound = 0.0;
+    for (int i = 0; i < count; ++i) {
+        int l = active[i];
+        double from_v_lo, from_v_hi, from_t_lo, from_t_hi;
+        fromLandmark(v, l, from_v_lo, from_v_hi);
+        fromLandmark(target, l, from_t_lo, from_t_hi);
+        // d(L, t) <= d(L, v) + d(v, t)
+        if (from_t_lo == INF) {
+            if (from_v_lo != INF) return INF;
+        } else if (from_v_hi != INF) {
+            bound = std::max(bound, from_t_lo - from_v_hi);
+        }
+
+        double v_to_lo, v_to_hi, t_to_lo, t_to_hi;
+        toLandmark(v, l, v_to_lo, v_to_hi);
+        toLandmark(target, l, t_to_lo, t_to_hi);
+        // d(v, L) <= d(v, t) + d(t, L)
+        if (v_to_lo == INF) {
+            if (t_to_lo != INF) return INF;
+        } else if (t_to_hi != INF) {
+            bound = std::max(bound, v_to_lo - t_to_hi);
+        }
+    }
+    return bound;
+}
+
+double LandmarkIndex::lowerBound(int v, int target) const {
+    std::vector<int> all(landmarks.size());
+    for (size_t l = 0; l < all.size(); ++l) all[l] = static_cast<int>(l);
+    return lowerBound(v, target, all.data(), static_cast<int>(all.size()));
+}
+
+std::vector<int> LandmarkIndex::selectActive(int source, int target, int max_count) const {
+    int k = getNumLandmarks();
+    std::vector<std::pair<double, int>> scored(k);
+    for (int l = 0; l < k; ++l) {
+        scored[l] = {lowerBound(source, target, &l, 1), l};
+    }
+    std::stable_sort(scored.begin(), scored.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+        return a.first > b.first;
+    });
+
+    std::vector<int> active;
+    for (int i = 0; i < std::min(k, max_count); ++i) active.push_back(scored[i].second);
+    return active;
+}
+
+int LandmarkIndex::getNumVertices() const {
+    return num_vertices;
+}
+
+int LandmarkIndex::getNumLandmarks() const {
+    return static_cast<int>(landmarks.size());
+}
+
+const std::vector<int>& LandmarkIndex::getLandmarks() const {
+    return landmarks;
+}
+
+LandmarkPrecision LandmarkIndex::getPrecision() const {
+    return precision;
+}
+
+size_t LandmarkIndex::tableBytes() const {
+    return (from_landmark32.size() + to_landmark32.size()) * sizeof(float) +
+           (from_landmark16.size() + to_landmark16.size()) * sizeof(uint16_t);
+}
+
+ALTQuery::ALTQuery(const Graph& graph, const LandmarkIndex& index, int max_active)
+    : graph(graph), index(index), max_active(std::max(1, max_active)),
+      workspace(graph.getNumVertices()), potentials(graph.getNumVertices(), 0.0),
+      source(-1), target(-1), distance(INF), settled_vertices(0) {
+}
+
+double ALTQuery::run(int source, int target) {
+    DEBUG_FUNCTION_ENTRY("ALTQuery::run", "source=" << source << ", target=" << target);
+
+    int n = graph.getNumVertices();
+    if (index.getNumVertices() != n) {
+        throw std::invalid_argument("ALTQuery: landmark index was built for " + std::to_string(index.getNumVertices()) +
+                                    " vertices, graph has " + std::to_string(n));
+    }
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::invalid_argument("ALTQuery: vertex pair (" + std::to_string(source) + ", " +
+                                    std::to_string(target) + ") out of range");
+    }
+
+    QueryScope scope("ALTQuery::run", &graph);
+    if (scope.isActive()) {
+        scope.setParameters("source=" + std::to_string(source) + ", target=" + std::to_string(target) +
+                            ", landmarks=" + std::to_string(max_active));
+    }
+    uint64_t relaxed = 0;
+
+    if (workspace.getNumVertices() != n) workspace.resize(n);
+    if (static_cast<int>(potentials.size()) != n) potentials.assign(n, 0.0);
+    workspace.reset();
+    this->source = source;
+    this->target = target;
+    distance = INF;
+    settled_vertices = 0;
+
+    active = index.selectActive(source, target, max_active);
+    const int* active_ids = active.data();
+    int active_count = static_cast<int>(active.size());
+
+    double source_potential = index.lowerBound(source, target, active_ids, active_count);
+    if (source_potential == INF) return distance;
+
+    IndexedHeap& queue = workspace.getQueue();
+    potentials[source] = source_potential;
+    workspace.relax(source, 0.0, -1, source_potential);
+
+    // Rounded potentials are admissible but not always consistent; relax() requeues a settled
+    // vertex if it improves, so the first time the target is popped its distance is exact
+    while (!queue.empty()) {
+        int u = queue.pop().first;
+        double dist = workspace.getDistance(u);
+        workspace.settle(u);
+        settled_vertices++;
+
+        if (u == target) {
+            distance = dist;
+            break;
+        }
+
+        for (const auto& edge : graph.neighbors(u)) {
+            int v = edge.dest;
+            double alt = dist + edge.weight;
+            if (!workspace.isReached(v)) {
+                double potential = index.lowerBound(v, target, active_ids, active_count);
+                if (potential == INF) continue;   // v cannot reach the target
+                potentials[v] = potential;
+            }
+            if (workspace.relax(v, alt, u, alt + potentials[v])) ++relaxed;
+        }
+    }
+
+    QueryScope::count("settled_vertices", settled_vertices);
+    QueryScope::count("relaxed_edges", relaxed);
+    DEBUG_FUNCTION_EXIT("ALTQuery::run", "distance=" << distance << ", settled=" << settled_vertices);
+    return distance;
+}
+
+std::vector<int> ALTQuery::getPath() const {
+    std::vector<int> path;
+    if (distance == INF) return path;
+    for (int v = target; v != -1; v = workspace.getPredecessor(v)) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+int ALTQuery::getSettledCount() const {
+    return settled_vertices;
+}
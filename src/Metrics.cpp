@@ -0,0 +1,301 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+    const size_t DEFAULT_SLOW_CAPACITY = 32;
+
+    std::atomic<bool> metrics_enabled(false);
+    thread_local QueryScope* active_scope = nullptr;
+
+    bool fasterThan(const QueryRecord& a, const QueryRecord& b) {
+        return a.latency_ns > b.latency_ns;   // heap comparator: the fastest capture on top
+    }
+
+    void addCounter(std::vector<std::pair<std::string, uint64_t>>& counters, const std::string& name,
+                    uint64_t delta) {
+        for (auto& counter : counters) {
+            if (counter.first == name) {
+                counter.second += delta;
+                return;
+            }
+        }
+        counters.push_back({name, delta});
+    }
+
+    void writeString(std::ostringstream& out, const std::string& value) {
+        out << '"';
+        for (char c : value) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out << escaped;
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    void writeCounters(std::ostringstream& out, const std::vector<std::pair<std::string, uint64_t>>& counters) {
+        out << '{';
+        for (size_t i = 0; i < counters.size(); ++i) {
+            if (i > 0) out << ", ";
+            writeString(out, counters[i].first);
+            out << ": " << counters[i].second;
+        }
+        out << '}';
+    }
+}
+
+// ----- LatencyHistogram -----
+
+LatencyHistogram::LatencyHistogram() : buckets(NUM_BUCKETS, 0), total(0), min_value(0), max_value(0), sum(0.0) {}
+
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) return static_cast<int>(value);
+    int exponent = 63;
+    while (!(value >> exponent)) --exponent;   // position of the leading bit, >= SUB_BUCKET_BITS
+    int shift = exponent - SUB_BUCKET_BITS;
+    int sub = static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketLow(int bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    return (static_cast<uint64_t>(SUB_BUCKETS) + sub) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh(int bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    int shift = bucket / SUB_BUCKETS - 1;
+    return bucketLow(bucket) + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++buckets[bucketOf(value)];
+    if (total == 0 || value < min_value) min_value = value;
+    if (value > max_value) max_value = value;
+    ++total;
+    sum += static_cast<double>(value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) return;
+    for (int b = 0; b < NUM_BUCKETS; ++b) buckets[b] += other.buckets[b];
+    if (total == 0 || other.min_value < min_value) min_value = other.min_value;
+    max_value = std::max(max_value, other.max_value);
+    total += other.total;
+    sum += other.sum;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    total = 0;
+    min_value = 0;
+    max_value = 0;
+    sum = 0.0;
+}
+
+uint64_t LatencyHistogram::count() const { return total; }
+uint64_t LatencyHistogram::min() const { return min_value; }
+uint64_t LatencyHistogram::max() const { return max_value; }
+
+double LatencyHistogram::mean() const {
+    return total == 0 ? 0.0 : sum / static_cast<double>(total);
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (total == 0) return 0;
+    if (q <= 0.0) return min_value;
+    q = std::min(q, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (int b = 0; b < NUM_BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return std::min(std::max(bucketHigh(b), min_value), max_value);
+    }
+    return max_value;
+}
+
+// ----- QueryRecord -----
+
+uint64_t QueryRecord::counter(const std::string& name) const {
+    for (const auto& c : counters) {
+        if (c.first == name) return c.second;
+    }
+    return 0;
+}
+
+// ----- MetricsRegistry -----
+
+MetricsRegistry::MetricsRegistry() : slow_capacity(DEFAULT_SLOW_CAPACITY) {}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+bool MetricsRegistry::isEnabled() {
+    return metrics_enabled.load(std::memory_order_relaxed);
+}
+
+void MetricsRegistry::setEnabled(bool enabled) {
+    metrics_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::labelGraph(const void* graph, const std::string& label) {
+    std::lock_guard<std::mutex> lock(mutex);
+    graph_labels[graph] = label;
+}
+
+std::string MetricsRegistry::graphLabel(const void* graph) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = graph_labels.find(graph);
+        if (it != graph_labels.end()) return it->second;
+    }
+    std::ostringstream name;
+    name << "graph@" << graph;
+    return name.str();
+}
+
+void MetricsRegistry::setSlowQueryCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    slow_capacity = capacity;
+    while (slowest.size() > slow_capacity) {
+        std::pop_heap(slowest.begin(), slowest.end(), fasterThan);
+        slowest.pop_back();
+    }
+}
+
+void MetricsRegistry::record(const QueryRecord& query) {
+    std::lock_guard<std::mutex> lock(mutex);
+    EngineStats& entry = stats[{query.engine, query.graph}];
+    entry.latency.record(query.latency_ns);
+    ++entry.queries;
+    if (!query.complete) ++entry.incomplete;
+    for (const auto& counter : query.counters) addCounter(entry.counters, counter.first, counter.second);
+
+    if (slow_capacity == 0) return;
+    if (slowest.size() < slow_capacity) {
+        slowest.push_back(query);
+        std::push_heap(slowest.begin(), slowest.end(), fasterThan);
+    } else if (query.latency_ns > slowest.front().latency_ns) {
+        std::pop_heap(slowest.begin(), slowest.end(), fasterThan);
+        slowest.back() = query;
+        std::push_heap(slowest.begin(), slowest.end(), fasterThan);
+    }
+}
+
+LatencyHistogram MetricsRegistry::histogram(const std::string& engine, const std::string& graph) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = stats.find({engine, graph});
+    return it != stats.end() ? it->second.latency : LatencyHistogram();
+}
+
+uint64_t MetricsRegistry::queryCount(const std::string& engine, const std::string& graph) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = stats.find({engine, graph});
+    return it != stats.end() ? it->second.queries : 0;
+}
+
+std::vector<QueryRecord> MetricsRegistry::slowQueries() const {
+    std::vector<QueryRecord> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = slowest;
+    }
+    std::sort(result.begin(), result.end(), fasterThan);
+    return result;
+}
+
+std::string MetricsRegistry::toJson() const {
+    std::vector<QueryRecord> slow = slowQueries();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream out;
+    out << "{\"engines\": [";
+    bool first = true;
+    for (const auto& item : stats) {
+        const EngineStats& entry = item.second;
+        const LatencyHistogram& h = entry.latency;
+        if (!first) out << ", ";
+        first = false;
+        out << "{\"engine\": ";
+        writeString(out, item.first.first);
+        out << ", \"graph\": ";
+        writeString(out, item.first.second);
+        out << ", \"queries\": " << entry.queries << ", \"incomplete\": " << entry.incomplete << ", \"counters\": ";
+        writeCounters(out, entry.counters);
+        out << ", \"latency_ns\": {\"count\": " << h.count() << ", \"min\": " << h.min()
+            << ", \"mean\": " << static_cast<uint64_t>(h.mean()) << ", \"p50\": " << h.percentile(0.5)
+            << ", \"p90\": " << h.percentile(0.9) << ", \"p99\": " << h.percentile(0.99)
+            << ", \"p999\": " << h.percentile(0.999) << ", \"max\": " << h.max() << "}}";
+    }
+    out << "], \"slow_queries\": [";
+    for (size_t i = 0; i < slow.size(); ++i) {
+        const QueryRecord& query = slow[i];
+        if (i > 0) out << ", ";
+        out << "{\"engine\": ";
+        writeString(out, query.engine);
+        out << ", \"graph\": ";
+        writeString(out, query.graph);
+        out << ", \"parameters\": ";
+        writeString(out, query.parameters);
+        out << ", \"latency_ns\": " << query.latency_ns << ", \"complete\": " << (query.complete ? "true" : "false")
+            << ", \"counters\": ";
+        writeCounters(out, query.counters);
+        out << '}';
+    }
+    out << "]}";
+    return out.str();
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.clear();
+    slowest.clear();
+}
+
+// ----- QueryScope -----
+
+QueryScope::QueryScope(const char* engine, const void* graph)
+    : parent(active_scope), active(parent == nullptr && MetricsRegistry::isEnabled()) {
+    if (!active) return;
+    record.engine = engine;
+    record.graph = MetricsRegistry::global().graphLabel(graph);
+    active_scope = this;
+    start = std::chrono::steady_clock::now();
+}
+
+QueryScope::~QueryScope() {
+    if (!active) return;
+    record.latency_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    active_scope = parent;
+    MetricsRegistry::global().record(record);
+}
+
+void QueryScope::setParameters(const std::string& parameters) {
+    if (active) record.parameters = parameters;
+}
+
+void QueryScope::setComplete(bool complete) {
+    if (active) record.complete = complete;
+}
+
+void QueryScope::count(const char* counter, uint64_t delta) {
+    if (active_scope != nullptr) addCounter(active_scope->record.counters, counter, delta);
+}
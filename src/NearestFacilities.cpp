@@ -0,0 +1,174 @@
+#include "NearestFacilities.h"
+#include "SearchWorkspace.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void validateVertex(int v, int n, const char* what) {
+        if (v < 0 || v >= n) {
+            throw std::invalid_argument(std::string("NearestFacilityQuery: ") + what + " vertex " +
+                                        std::to_string(v) + " out of range");
+        }
+    }
+
+    // Settle vertices from source until k facilities are found; writes them to hits in order
+    // and returns how many were found
+    int searchNearest(const Graph& graph, const std::vector<char>& is_facility, SearchWorkspace& ws,
+                      int source, int k, FacilityHit* hits) {
+        IndexedHeap& queue = ws.getQueue();
+        ws.reset();
+        ws.relax(source, 0.0, -1);
+
+        int found = 0;
+        uint64_t settled = 0, relaxed = 0;
+        while (!queue.empty() && found < k) {
+            std::pair<int, double> top = queue.pop();
+            int u = top.first;
+            double dist = top.second;
+            ws.settle(u);
+            ++settled;
+
+            if (is_facility[u]) {
+                hits[found].facility = u;
+                hits[found].distance = dist;
+                if (++found == k) break;
+            }
+
+            for (const auto& edge : graph.neighbors(u)) {
+                if (ws.relax(edge.dest, dist + edge.weight, u)) ++relaxed;
+            }
+        }
+        QueryScope::count("settled_vertices", settled);
+        QueryScope::count("relaxed_edges", relaxed);
+        return found;
+    }
+}
+
+NearestFacilityQuery::NearestFacilityQuery(const Graph& graph, const std::vector<int>& facilities)
+    : graph(graph), is_facility(graph.getNumVertices(), 0), num_facilities(0) {
+    int n = graph.getNumVertices();
+    for (int f : facilities) {
+        validateVertex(f, n, "facility");
+        if (!is_facility[f]) {
+            is_facility[f] = 1;
+            num_facilities++;
+        }
+    }
+}
+
+std::vector<FacilityHit> NearestFacilityQuery::run(int source, int k) const {
+    int n = graph.getNumVertices();
+    validateVertex(source, n, "source");
+    k = std::min(k, num_facilities);
+    if (k <= 0) return std::vector<FacilityHit>();
+
+    QueryScope scope("NearestFacilityQuery::run", &graph);
+    if (scope.isActive()) scope.setParameters("source=" + std::to_string(source) + ", k=" + std::to_string(k));
+    std::vector<FacilityHit> hits(k);
+    int found = searchNearest(graph, is_facility, SearchWorkspace::threadLocal(n), source, k, hits.data());
+    hits.resize(found);
+    return hits;
+}
+
+NearestFacilityTable NearestFacilityQuery::runAll(int k) const {
+    int n = graph.getNumVertices();
+    DEBUG_FUNCTION_ENTRY("NearestFacilityQuery::runAll", "n=" << n << ", k=" << k
+                         << ", facilities=" << num_facilities);
+
+    NearestFacilityTable table;
+    table.num_vertices = n;
+    table.k = std::max(0, k);
+    table.hits.assign(static_cast<size_t>(n) * table.k, FacilityHit());
+    int effective_k = std::min(table.k, num_facilities);
+    if (effective_k == 0) return table;
+
+    // Incoming edges: the graph's own when enabled, else a temporary CSR built in parallel
+    std::vector<int64_t> in_offsets;
+    std::vector<int> in_sources;
+    std::vector<double> in_weights;
+    bool own_reverse = !graph.hasReverseEdges();
+    if (own_reverse) {
+        in_offsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                if (!edge.isRemoved()) in_offsets[edge.dest + 1]++;
+            }
+        }
+        for (int v = 0; v < n; ++v) in_offsets[v + 1] += in_offsets[v];
+        in_sources.resize(in_offsets[n]);
+        in_weights.resize(in_offsets[n]);
+        std::vector<int64_t> fill(in_offsets.begin(), in_offsets.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.isRemoved()) continue;
+                int64_t slot = fill[edge.dest]++;
+                in_sources[slot] = u;
+                in_weights[slot] = edge.weight;
+            }
+        }
+    }
+
+    // k-label Dijkstra backwards from all facilities at once: a vertex accepts each facility
+    // once and stops accepting after k, so labels arrive in increasing distance and every
+    // vertex is settled at most k times. O(k m log(k m)) for the whole table, against one
+    // search per vertex for run().
+    struct Label {
+        double dist;
+        int vertex;
+        int facility;
+        bool operator>(const Label& other) const {
+            if (dist != other.dist) return dist > other.dist;
+            if (vertex != other.vertex) return vertex > other.vertex;
+            return facility > other.facility;
+        }
+    };
+    std::priority_queue<Label, std::vector<Label>, std::greater<Label>> pq;
+    std::vector<int> found(n, 0);
+    for (int f = 0; f < n; ++f) {
+        if (is_facility[f]) pq.push({0.0, f, f});
+    }
+
+    auto accepts = [&](int v, int facility) {
+        if (found[v] >= effective_k) return false;
+        const FacilityHit* row = table.hits.data() + static_cast<size_t>(v) * table.k;
+        for (int i = 0; i < found[v]; ++i) {
+            if (row[i].facility == facility) return false;
+        }
+        return true;
+    };
+
+    while (!pq.empty()) {
+        Label label = pq.top();
+        pq.pop();
+        int v = label.vertex;
+        if (!accepts(v, label.facility)) continue;
+        FacilityHit& hit = table.hits[static_cast<size_t>(v) * table.k + found[v]++];
+        hit.facility = label.facility;
+        hit.distance = label.dist;
+
+        auto push = [&](int u, double weight) {
+            double alt = label.dist + weight;
+            if (alt != std::numeric_limits<double>::infinity() && accepts(u, label.facility)) {
+                pq.push({alt, u, label.facility});
+            }
+        };
+        if (own_reverse) {
+            for (int64_t e = in_offsets[v]; e < in_offsets[v + 1]; ++e) push(in_sources[e], in_weights[e]);
+        } else {
+            for (const auto& edge : graph.reverseNeighbors(v)) push(edge.dest, edge.weight);
+        }
+    }
+
+    DEBUG_FUNCTION_EXIT("NearestFacilityQuery::runAll", "rows=" << n);
+    return table;
+}
+
+int NearestFacilityQuery::getNumFacilities() const {
+    return num_facilities;
+}
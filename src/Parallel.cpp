@@ -0,0 +1,372 @@
+#include "Parallel.h"
+#include "Debug.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    int detectThreads() {
+        const char* env = std::getenv("FASTDIJKSTRA_THREADS");
+        if (env) {
+            int requested = std::atoi(env);
+            if (requested > 0) return requested;
+        }
+        unsigned int hw = std::thread::hardware_concurrency();
+        return hw > 0 ? static_cast<int>(hw) : 1;
+    }
+
+    bool detectAffinity() {
+        const char* env = std::getenv("FASTDIJKSTRA_AFFINITY");
+        return env && std::strcmp(env, "0") != 0 && env[0] != '\0';
+    }
+
+    std::atomic<int> g_parallel_threads(0);
+    std::atomic<int> g_parallel_affinity(-1);   // -1: not read from the environment yet
+    std::atomic<uint64_t> g_pools_started(0);
+
+    // How long a waiting thread sleeps before looking for stealable work again
+    const std::chrono::microseconds WAIT_POLL(200);
+}
+
+// ----- ParallelRuntime -----
+
+class ParallelRuntime {
+    private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    int concurrency;
+    // One deque per worker, plus a shared injection deque (the last) for outside threads
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued;
+    bool stopping;                 // guarded by sleep_mutex
+
+    std::atomic<uint64_t> executed;
+    std::atomic<uint64_t> stolen;
+    std::atomic<int> running_workers;
+
+    static thread_local ParallelRuntime* current_runtime;
+    static thread_local int current_worker;
+
+    int ownQueue() const {
+        return current_runtime == this ? current_worker : static_cast<int>(workers.size());
+    }
+
+    bool popFront(TaskQueue& queue, std::function<void()>& task) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    bool popBack(TaskQueue& queue, std::function<void()>& task) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool take(std::function<void()>& task) {
+        if (queued.load() == 0) return false;
+        int own = ownQueue();
+        int num_queues = static_cast<int>(queues.size());
+        // Newest own task first (still hot in cache), then the oldest task of everyone else
+        bool found = own < num_queues - 1 ? popBack(*queues[own], task) : popFront(*queues[own], task);
+        for (int i = 1; !found && i < num_queues; ++i) {
+            found = popFront(*queues[(own + i) % num_queues], task);
+            if (found && (own + i) % num_queues != num_queues - 1) stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (found) {
+            queued.fetch_sub(1);
+            executed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return found;
+    }
+
+    void pin(std::thread& thread, int index) {
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        if (cpus.empty()) return;
+        cpu_set_t target;
+        CPU_ZERO(&target);
+        CPU_SET(cpus[(index + 1) % cpus.size()], &target);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(target), &target);
+#else
+        (void)thread;
+        (void)index;
+#endif
+    }
+
+    void workerLoop(int index) {
+        current_runtime = this;
+        current_worker = index;
+        std::function<void()> task;
+        while (true) {
+            if (take(task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this]() { return queued.load() > 0 || stopping; });
+            if (stopping && queued.load() == 0) break;
+        }
+        running_workers.fetch_sub(1);
+        current_runtime = nullptr;
+    }
+
+    public:
+    ParallelRuntime(int num_threads, bool affinity)
+        : concurrency(std::max(1, num_threads)), queued(0), stopping(false), executed(0), stolen(0),
+          running_workers(0) {
+        int num_workers = concurrency - 1;
+        for (int i = 0; i <= num_workers; ++i) queues.push_back(std::make_unique<TaskQueue>());
+        workers.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i) {
+            workers.emplace_back(&ParallelRuntime::workerLoop, this, i);
+            running_workers.fetch_add(1);
+            if (affinity) pin(workers.back(), i);
+        }
+        g_pools_started.fetch_add(1);
+        DEBUG_PRINT("ParallelRuntime: started " << num_workers << " workers"
+                    << (affinity ? " pinned to CPUs" : ""));
+    }
+
+    ~ParallelRuntime() { shutdown(); }
+
+    int getConcurrency() const { return concurrency; }
+    bool hasWorkers() const { return !workers.empty(); }
+
+    // Queue a task; false once the pool has shut down (the caller then runs it itself)
+    bool submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            if (stopping) return false;
+            TaskQueue& queue = *queues[ownQueue()];
+            std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+            queued.fetch_add(1);
+        }
+        wake.notify_one();
+        return true;
+    }
+
+    // Run one queued task on the calling thread; false if there was none
+    bool runOne() {
+        std::function<void()> task;
+        if (!take(task)) return false;
+        task();
+        return true;
+    }
+
+    // Let the workers drain the queues, then join them. Tasks queued afterwards are refused.
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        // Outside threads may still be waiting on work that no worker picked up
+        while (runOne()) {}
+    }
+
+    void fillStats(ParallelRuntimeStats& stats) const {
+        stats.workers = running_workers.load();
+        stats.tasks = executed.load();
+        stats.steals = stolen.load();
+    }
+};
+
+thread_local ParallelRuntime* ParallelRuntime::current_runtime = nullptr;
+thread_local int ParallelRuntime::current_worker = -1;
+
+namespace {
+    std::mutex g_runtime_mutex;
+    std::shared_ptr<ParallelRuntime> g_runtime;
+
+    std::shared_ptr<ParallelRuntime> currentRuntime() {
+        std::lock_guard<std::mutex> lock(g_runtime_mutex);
+        if (!g_runtime) {
+            g_runtime = std::make_shared<ParallelRuntime>(getParallelThreads(), getParallelAffinity());
+        }
+        return g_runtime;
+    }
+
+    void retireRuntime() {
+        std::shared_ptr<ParallelRuntime> retired;
+        {
+            std::lock_guard<std::mutex> lock(g_runtime_mutex);
+            retired.swap(g_runtime);
+        }
+        // Holders of the old pool keep it alive; its workers stop once the queues are empty
+        if (retired) retired->shutdown();
+    }
+}
+
+int getParallelThreads() {
+    int threads = g_parallel_threads.load(std::memory_order_relaxed);
+    if (threads <= 0) {
+        threads = detectThreads();
+        g_parallel_threads.store(threads, std::memory_order_relaxed);
+    }
+    return threads;
+}
+
+void setParallelThreads(int num_threads) {
+    int threads = num_threads > 0 ? num_threads : detectThreads();
+    if (g_parallel_threads.exchange(threads) != threads) retireRuntime();
+}
+
+bool getParallelAffinity() {
+    int affinity = g_parallel_affinity.load(std::memory_order_relaxed);
+    if (affinity < 0) {
+        affinity = detectAffinity() ? 1 : 0;
+        g_parallel_affinity.store(affinity, std::memory_order_relaxed);
+    }
+    return affinity != 0;
+}
+
+void setParallelAffinity(bool enabled) {
+    if (g_parallel_affinity.exchange(enabled ? 1 : 0) != (enabled ? 1 : 0)) retireRuntime();
+}
+
+ParallelRuntimeStats getParallelRuntimeStats() {
+    ParallelRuntimeStats stats;
+    stats.threads = getParallelThreads();
+    stats.pools = g_pools_started.load();
+    std::lock_guard<std::mutex> lock(g_runtime_mutex);
+    if (g_runtime) g_runtime->fillStats(stats);
+    return stats;
+}
+
+// ----- TaskGroup -----
+
+TaskGroup::TaskGroup() : runtime(currentRuntime()), pending(0) {}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    pending.fetch_add(1);
+    auto wrapped = [this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+        // Notify under the lock: the waiter may destroy the group as soon as it sees zero
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.fetch_sub(1) == 1) done.notify_all();
+    };
+    if (!runtime->submit(wrapped)) wrapped();
+}
+
+void TaskGroup::wait() {
+    while (pending.load() > 0) {
+        if (runtime->runOne()) continue;
+        // Everything left is running elsewhere; wake up now and then in case it forks more
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait_for(lock, WAIT_POLL, [this]() { return pending.load() == 0; });
+    }
+    std::exception_ptr first;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(first, error);
+    }
+    if (first) std::rethrow_exception(first);
+}
+
+// ----- Parallel helpers -----
+
+void parallelFor(size_t begin, size_t end, size_t grain,
+                 const std::function<void(size_t, size_t)>& body) {
+    if (end <= begin) return;
+    if (grain == 0) grain = 1;
+
+    size_t num_chunks = (end - begin + grain - 1) / grain;
+    int num_threads = static_cast<int>(std::min<size_t>(num_chunks, getParallelThreads()));
+
+    DEBUG_FUNCTION_ENTRY("parallelFor", "range=[" << begin << ", " << end << "), grain=" << grain
+                         << ", chunks=" << num_chunks << ", threads=" << num_threads);
+
+    if (num_threads <= 1) {
+        for (size_t lo = begin; lo < end; lo += grain) {
+            body(lo, std::min(end, lo + grain));
+        }
+        return;
+    }
+
+    // Claimers take chunks dynamically so skewed chunks (e.g. hub vertices) balance out. A
+    // claimer that starts after the range is exhausted returns at once, so it costs nothing
+    // to offer one per thread even when the pool is busy with other work.
+    std::atomic<size_t> next_chunk(0);
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+
+    auto claimer = [&]() {
+        while (true) {
+            size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= num_chunks) break;
+            size_t lo = begin + chunk * grain;
+            try {
+                body(lo, std::min(end, lo + grain));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error) first_error = std::current_exception();
+                next_chunk.store(num_chunks, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    TaskGroup group;
+    for (int i = 1; i < num_threads; ++i) {
+        group.run(claimer);
+    }
+    claimer();
+    group.wait();
+
+    if (first_error) std::rethrow_exception(first_error);
+}
+
+void parallelSpawn(std::function<void()> task) {
+    auto guarded = [task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+        }
+    };
+    std::shared_ptr<ParallelRuntime> runtime = currentRuntime();
+    if (!runtime->hasWorkers() || !runtime->submit(guarded)) guarded();
+}
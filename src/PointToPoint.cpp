@@ -0,0 +1,122 @@
+#include "PointToPoint.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void validateVertex(int v, int n, const char* what) {
+        if (v < 0 || v >= n) {
+            throw std::invalid_argument(std::string("PointToPointQuery: ") + what + " vertex " +
+                                        std::to_string(v) + " out of range");
+        }
+    }
+}
+
+PointToPointQuery::PointToPointQuery(const Graph& graph)
+    : graph(graph), workspace(graph.getNumVertices()), source(-1) {
+}
+
+double PointToPointQuery::run(int source, int target, const QueryOptions& options) {
+    return run(source, std::vector<int>{target}, options).distances[0];
+}
+
+PointToPointResult PointToPointQuery::run(int source, const std::vector<int>& targets,
+                                          const QueryOptions& options) {
+    DEBUG_FUNCTION_ENTRY("PointToPointQuery::run", "source=" << source << ", targets.size()=" << targets.size()
+                         << ", cap=" << options.distance_cap);
+
+    int n = graph.getNumVertices();
+    validateVertex(source, n, "source");
+    for (int t : targets) validateVertex(t, n, "target");
+
+    QueryScope scope("PointToPointQuery::run", &graph);
+    if (scope.isActive()) {
+        scope.setParameters("source=" + std::to_string(source) + ", targets=" + std::to_string(targets.size()) +
+                            ", cap=" + std::to_string(options.distance_cap));
+    }
+    uint64_t relaxed = 0;
+
+    if (workspace.getNumVertices() != n) workspace.resize(n);
+    workspace.reset();
+    this->source = source;
+
+    PointToPointResult result;
+    result.distances.assign(targets.size(), std::numeric_limits<double>::max());
+
+    // Repeated targets are counted once
+    std::vector<int> distinct(targets);
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    int remaining = static_cast<int>(distinct.size());
+
+    if (remaining > 0 && options.distance_cap > 0.0) {
+        IndexedHeap& queue = workspace.getQueue();
+        workspace.relax(source, 0.0, -1);
+        StopCheck stop(options.cancel);
+
+        while (!queue.empty()) {
+            if (stop.tick()) {
+                DEBUG_PRINT("Cancelled after " << result.settled_vertices << " settled vertices");
+                result.complete = false;
+                break;
+            }
+            std::pair<int, double> top = queue.pop();
+            int u = top.first;
+            double dist = top.second;
+            workspace.settle(u);
+            result.settled_vertices++;
+
+            if (std::binary_search(distinct.begin(), distinct.end(), u)) {
+                DEBUG_PRINT("Settled target " << u << " at distance " << dist);
+                if (--remaining == 0 || options.stop_at_first_target) break;
+            }
+
+            for (const auto& edge : graph.neighbors(u)) {
+                double alt = dist + edge.weight;
+                if (alt < options.distance_cap && workspace.relax(edge.dest, alt, u)) {
+                    ++relaxed;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        result.distances[i] = getDistance(targets[i]);
+    }
+
+    QueryScope::count("settled_vertices", result.settled_vertices);
+    QueryScope::count("relaxed_edges", relaxed);
+    scope.setComplete(result.complete);
+    DEBUG_FUNCTION_EXIT("PointToPointQuery::run", "settled=" << result.settled_vertices);
+    return result;
+}
+
+bool PointToPointQuery::isSettled(int v) const {
+    return source >= 0 && workspace.isSettled(v);
+}
+
+double PointToPointQuery::getDistance(int v) const {
+    return isSettled(v) ? workspace.getDistance(v) : std::numeric_limits<double>::max();
+}
+
+std::vector<int> PointToPointQuery::getPath(int target) const {
+    std::vector<int> path;
+    if (target < 0 || target >= workspace.getNumVertices() || !isSettled(target)) return path;
+
+    for (int v = target; v != -1; v = workspace.getPredecessor(v)) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+SparseResult PointToPointQuery::getSparseResult() const {
+    if (source < 0) return SparseResult(graph.getNumVertices());
+    return SparseResult::fromWorkspace(workspace);
+}
+
+int PointToPointQuery::getSource() const {
+    return source;
+}
@@ -0,0 +1,608 @@
+#include "QueryServer.h"
+#include "Dijkstra.h"
+#include "DistanceTable.h"
+#include "GraphStore.h"
+#include "Parallel.h"
+#include "PointToPoint.h"
+#include "SSSPCache.h"
+#include "Debug.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace QueryProtocol;
+
+namespace {
+    // Appends fixed-size values to a payload
+    class PayloadWriter {
+        private:
+        std::vector<char>& out;
+
+        public:
+        explicit PayloadWriter(std::vector<char>& out) : out(out) {}
+
+        template <typename T>
+        void put(const T& value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+        template <typename T>
+        void putArray(const T* values, size_t count) {
+            const char* bytes = reinterpret_cast<const char*>(values);
+            out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+        }
+    };
+
+    // Reads fixed-size values from a payload; throws std::runtime_error past the end
+    class PayloadReader {
+        private:
+        const std::vector<char>& in;
+        size_t offset;
+
+        void need(size_t bytes) const {
+            if (in.size() - offset < bytes) throw std::runtime_error("truncated payload");
+        }
+
+        public:
+        explicit PayloadReader(const std::vector<char>& in) : in(in), offset(0) {}
+
+        template <typename T>
+        T get() {
+            need(sizeof(T));
+            T value;
+            std::memcpy(&value, in.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+        template <typename T>
+        void getArray(std::vector<T>& values, size_t count) {
+            if (count > (in.size() - offset) / sizeof(T)) throw std::runtime_error("truncated payload");
+            values.resize(count);
+            if (count > 0) std::memcpy(values.data(), in.data() + offset, sizeof(T) * count);
+            offset += sizeof(T) * count;
+        }
+    };
+
+    bool readFully(int fd, char* buffer, size_t bytes) {
+        while (bytes > 0) {
+            ssize_t got = ::recv(fd, buffer, bytes, 0);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            buffer += got;
+            bytes -= static_cast<size_t>(got);
+        }
+        return true;
+    }
+
+    bool writeFully(int fd, const char* buffer, size_t bytes) {
+        while (bytes > 0) {
+            ssize_t sent = ::send(fd, buffer, bytes, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) return false;
+            buffer += sent;
+            bytes -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    // The frame header stores the payload length as uint32
+    const size_t MAX_FRAME_PAYLOAD = std::numeric_limits<uint32_t>::max();
+
+    std::vector<char> frame(uint32_t id, uint8_t code, const std::vector<char>& payload) {
+        if (payload.size() > MAX_FRAME_PAYLOAD) {
+            throw std::runtime_error("message of " + std::to_string(payload.size()) + " bytes does not fit a frame");
+        }
+        std::vector<char> out;
+        out.reserve(HEADER_BYTES + payload.size());
+        PayloadWriter writer(out);
+        writer.put(static_cast<uint32_t>(payload.size()));
+        writer.put(id);
+        writer.put(code);
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    sockaddr_un socketAddress(const std::string& path, const char* who) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error(std::string(who) + ": invalid socket path '" + path + "'");
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+
+    size_t responseLimit(const QueryServerOptions& options) {
+        return std::min(options.max_response_bytes, MAX_FRAME_PAYLOAD);
+    }
+
+    void checkResponseSize(uint64_t bytes, size_t limit) {
+        if (bytes > limit) {
+            throw std::runtime_error("response of " + std::to_string(bytes) + " bytes exceeds the limit of " +
+                                     std::to_string(limit));
+        }
+    }
+
+    void checkVertex(int v, int n) {
+        if (v < 0 || v >= n) throw std::runtime_error("vertex " + std::to_string(v) + " out of range");
+    }
+
+    void writePointToPoint(std::vector<char>& out, double distance, bool with_path, const std::vector<int>& path) {
+        PayloadWriter writer(out);
+        writer.put(distance);
+        uint32_t length = with_path ? static_cast<uint32_t>(path.size()) : 0;
+        writer.put(length);
+        writer.putArray(path.data(), length);
+    }
+}
+
+// ----- QueryServer -----
+
+QueryServer::Connection::Connection(int fd) : fd(fd), finished(false) {}
+
+QueryServer::Connection::~Connection() {
+    ::close(fd);
+}
+
+QueryServer::QueryServer(const Graph& graph, const QueryServerOptions& options)
+    : store(nullptr), fixed_graph(&graph, [](const Graph*) {}), options(options), listen_fd(-1), running(false),
+      connection_count(0), request_count(0), error_count(0), batch_count(0), search_count(0),
+      retired_cache_hits(0), retired_cache_misses(0) {}
+
+QueryServer::QueryServer(const GraphStore& store, const QueryServerOptions& options)
+    : store(&store), options(options), listen_fd(-1), running(false), connection_count(0), request_count(0),
+      error_count(0), batch_count(0), search_count(0), retired_cache_hits(0), retired_cache_misses(0) {}
+
+QueryServer::~QueryServer() {
+    stop();
+}
+
+void QueryServer::start(const std::string& path) {
+    if (running.load()) throw std::runtime_error("QueryServer: already running");
+    sockaddr_un address = socketAddress(path, "QueryServer");
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("QueryServer: socket() failed: " + std::string(std::strerror(errno)));
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("QueryServer: cannot listen on " + path + ": " + reason);
+    }
+
+    socket_path = path;
+    listen_fd = fd;
+    running.store(true);
+
+    int num_workers = std::max(1, options.num_workers > 0 ? options.num_workers : getParallelThreads());
+    for (int i = 0; i < num_workers; ++i) workers.emplace_back(&QueryServer::workerLoop, this);
+    accept_thread = std::thread(&QueryServer::acceptLoop, this);
+
+    DEBUG_PRINT("QueryServer listening on " << path << " with " << num_workers << " workers");
+}
+
+void QueryServer::stop() {
+    if (!running.exchange(false)) return;
+
+    // shutdown() wakes the blocked accept() and recv() calls; descriptors are closed only
+    // once nothing can use them any more
+    ::shutdown(listen_fd, SHUT_RDWR);
+    accept_thread.join();
+    ::close(listen_fd);
+    listen_fd = -1;
+
+    std::vector<std::shared_ptr<Connection>> open;
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        open.swap(connections);
+    }
+    for (auto& connection : open) ::shutdown(connection->fd, SHUT_RDWR);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue_space.notify_all();   // readers waiting for room in the queue
+    }
+    for (auto& connection : open) connection->reader.join();
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue_ready.notify_all();
+    }
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+    queue.clear();
+
+    ::unlink(socket_path.c_str());
+    DEBUG_PRINT("QueryServer stopped after " << request_count.load() << " requests");
+}
+
+bool QueryServer::isRunning() const {
+    return running.load();
+}
+
+QueryServerStats QueryServer::stats() const {
+    QueryServerStats result;
+    result.connections = connection_count.load();
+    result.requests = request_count.load();
+    result.errors = error_count.load();
+    result.batches = batch_count.load();
+    result.searches = search_count.load();
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    result.searches += retired_cache_misses;
+    result.cache_hits = retired_cache_hits;
+    if (cache) {
+        SSSPCacheStats cache_stats = cache->stats();
+        result.searches += cache_stats.misses;
+        result.cache_hits += cache_stats.hits + cache_stats.coalesced;
+    }
+    return result;
+}
+
+std::shared_ptr<const Graph> QueryServer::currentGraph() const {
+    return store ? store->snapshot() : fixed_graph;
+}
+
+std::shared_ptr<SSSPCache> QueryServer::cacheFor(const std::shared_ptr<const Graph>& graph) {
+    if (options.cache_bytes == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache_graph == graph) return cache;
+    // Only the newest version gets a cache; a batch still on an older snapshot goes without
+    if (graph != currentGraph()) return nullptr;
+    if (cache) {
+        SSSPCacheStats retired = cache->stats();
+        retired_cache_hits += retired.hits + retired.coalesced;
+        retired_cache_misses += retired.misses;
+    }
+    SSSPCacheOptions cache_options;
+    cache_options.capacity_bytes = options.cache_bytes;
+    cache = std::make_shared<SSSPCache>(*graph, cache_options);
+    cache_graph = graph;   // keeps the version alive as long as its cache
+    return cache;
+}
+
+void QueryServer::acceptLoop() {
+    while (running.load()) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;   // listening socket shut down by stop()
+        }
+        auto connection = std::make_shared<Connection>(fd);
+        ++connection_count;
+
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        // Reap connections whose clients went away
+        for (auto it = connections.begin(); it != connections.end();) {
+            if ((*it)->finished.load()) {
+                (*it)->reader.join();
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        connection->reader = std::thread(&QueryServer::readLoop, this, connection);
+        connections.push_back(connection);
+    }
+}
+
+void QueryServer::readLoop(std::shared_ptr<Connection> connection) {
+    char header[HEADER_BYTES];
+    while (readFully(connection->fd, header, HEADER_BYTES)) {
+        Request request;
+        uint32_t payload_bytes;
+        std::memcpy(&payload_bytes, header, sizeof(uint32_t));
+        std::memcpy(&request.id, header + 4, sizeof(uint32_t));
+        request.type = static_cast<uint8_t>(header[8]);
+        if (payload_bytes > options.max_request_bytes) {
+            DEBUG_PRINT("QueryServer: dropping connection, " << payload_bytes << "-byte request");
+            break;
+        }
+        request.payload.resize(payload_bytes);
+        if (payload_bytes > 0 && !readFully(connection->fd, request.payload.data(), payload_bytes)) break;
+        request.connection = connection;
+
+        // Backpressure: stop reading (and so let the socket buffers fill up) while the
+        // workers are behind
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_space.wait(lock, [this] {
+            return queue.size() < std::max<size_t>(1, options.max_queued_requests) || !running.load();
+        });
+        if (!running.load()) break;
+        queue.push_back(std::move(request));
+        queue_ready.notify_one();
+    }
+    ::shutdown(connection->fd, SHUT_RDWR);
+    connection->finished.store(true);
+}
+
+void QueryServer::workerLoop() {
+    std::shared_ptr<const Graph> graph;
+    std::unique_ptr<PointToPointQuery> point_query;
+    std::vector<Request> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_ready.wait(lock, [this] { return !queue.empty() || !running.load(); });
+            if (!running.load()) return;
+            while (!queue.empty() && batch.size() < options.max_batch) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+            queue_space.notify_all();
+        }
+        ++batch_count;
+        // One snapshot per batch: all of its answers come from the same graph version. The
+        // worker keeps it (and its PointToPointQuery) until a batch finds a newer one.
+        std::shared_ptr<const Graph> snapshot = currentGraph();
+        if (snapshot != graph) {
+            point_query.reset(new PointToPointQuery(*snapshot));
+            graph = snapshot;
+        }
+        std::shared_ptr<SSSPCache> batch_cache = cacheFor(graph);
+        processBatch(batch, *graph, *point_query, batch_cache.get());
+        batch.clear();
+    }
+}
+
+void QueryServer::respond(Request& request, uint8_t status, const std::vector<char>& payload) {
+    // Last line of defence for answers not sized up front (point-to-point paths)
+    size_t limit = responseLimit(options);
+    if (payload.size() > limit) {
+        std::string message = "response of " + std::to_string(payload.size()) + " bytes exceeds the limit of " +
+                              std::to_string(limit);
+        respond(request, STATUS_ERROR, std::vector<char>(message.begin(), message.end()));
+        return;
+    }
+    std::vector<char> out = frame(request.id, status, payload);
+    {
+        std::lock_guard<std::mutex> lock(request.connection->write_mutex);
+        writeFully(request.connection->fd, out.data(), out.size());   // a vanished client is not an error
+    }
+    ++request_count;
+    if (status != STATUS_OK) ++error_count;
+}
+
+void QueryServer::processBatch(std::vector<Request>& batch, const Graph& graph, PointToPointQuery& point_query,
+                               SSSPCache* cache) {
+    int n = graph.getNumVertices();
+    size_t limit = responseLimit(options);
+
+    struct Parsed {
+        int source = -1;
+        int target = -1;
+        bool detail = false;   // predecessors for SSSP, the path for point-to-point
+    };
+    std::vector<Parsed> parsed(batch.size());
+    std::map<int, std::vector<size_t>> by_source;   // SSSP and point-to-point requests per source
+
+    auto fail = [&](Request& request, const std::string& message) {
+        respond(request, STATUS_ERROR, std::vector<char>(message.begin(), message.end()));
+    };
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Request& request = batch[i];
+        try {
+            PayloadReader reader(request.payload);
+            std::vector<char> out;
+            PayloadWriter writer(out);
+            switch (request.type) {
+                case INFO:
+                    writer.put(static_cast<int32_t>(n));
+                    writer.put(static_cast<int64_t>(graph.getNumEdges()));
+                    respond(request, STATUS_OK, out);
+                    break;
+                case SSSP:
+                    parsed[i].source = reader.get<int32_t>();
+                    parsed[i].detail = (reader.get<uint8_t>() & FLAG_PREDECESSORS) != 0;
+                    checkVertex(parsed[i].source, n);
+                    checkResponseSize(sizeof(uint32_t) + static_cast<uint64_t>(n) *
+                                          (sizeof(double) + (parsed[i].detail ? sizeof(int32_t) : 0)), limit);
+                    by_source[parsed[i].source].push_back(i);
+                    break;
+                case POINT_TO_POINT:
+                    parsed[i].source = reader.get<int32_t>();
+                    parsed[i].target = reader.get<int32_t>();
+                    parsed[i].detail = (reader.get<uint8_t>() & FLAG_PATH) != 0;
+                    checkVertex(parsed[i].source, n);
+                    checkVertex(parsed[i].target, n);
+                    by_source[parsed[i].source].push_back(i);
+                    break;
+                case DISTANCE_TABLE: {
+                    uint32_t num_sources = reader.get<uint32_t>();
+                    uint32_t num_targets = reader.get<uint32_t>();
+                    // ns * nt can overflow 64 bits, so compare against the limit by division
+                    size_t max_cells = limit > 2 * sizeof(uint32_t) ? (limit - 2 * sizeof(uint32_t)) / sizeof(double) : 0;
+                    if (num_targets > 0 && num_sources > max_cells / num_targets) {
+                        throw std::runtime_error("distance table of " + std::to_string(num_sources) + " x " +
+                                                 std::to_string(num_targets) + " exceeds the response limit of " +
+                                                 std::to_string(limit) + " bytes");
+                    }
+                    std::vector<int32_t> sources, targets;
+                    reader.getArray(sources, num_sources);
+                    reader.getArray(targets, num_targets);
+                    DistanceTable table = ::distanceTable(graph, std::vector<int>(sources.begin(), sources.end()),
+                                                          std::vector<int>(targets.begin(), targets.end()));
+                    writer.put(num_sources);
+                    writer.put(num_targets);
+                    writer.putArray(table.distances.data(), table.distances.size());
+                    respond(request, STATUS_OK, out);
+                    break;
+                }
+                default:
+                    fail(request, "unknown request type " + std::to_string(request.type));
+            }
+        } catch (const std::exception& e) {
+            fail(request, e.what());
+        }
+    }
+
+    // One search per distinct source. A full SSSP answers everything from that source; when
+    // only point-to-point requests share it, a multi-target search stops at the last target.
+    for (auto& group : by_source) {
+        int source = group.first;
+        const std::vector<size_t>& members = group.second;
+        // A failure here (e.g. bad_alloc in the search) answers the group's remaining
+        // requests with the error instead of escaping the worker
+        size_t answered = 0;
+        try {
+            bool needs_full = std::any_of(members.begin(), members.end(),
+                                          [&](size_t i) { return batch[i].type == SSSP; }) ||
+                              (cache && cache->contains(source));
+
+            if (needs_full) {
+                std::shared_ptr<const SSSPTree> tree;
+                if (cache) {
+                    tree = cache->get(source);
+                } else {
+                    ++search_count;
+                    DijkstraResults result = runDijkstra(graph, source);
+                    auto fresh = std::make_shared<SSSPTree>();
+                    fresh->source = source;
+                    fresh->distances = std::move(result.distances);
+                    fresh->predecessors = std::move(result.predecessors);
+                    tree = fresh;
+                }
+                for (size_t i : members) {
+                    std::vector<char> out;
+                    PayloadWriter writer(out);
+                    if (batch[i].type == SSSP) {
+                        writer.put(static_cast<uint32_t>(n));
+                        writer.putArray(tree->distances.data(), tree->distances.size());
+                        if (parsed[i].detail) {
+                            std::vector<int32_t> predecessors(tree->predecessors.begin(), tree->predecessors.end());
+                            writer.putArray(predecessors.data(), predecessors.size());
+                        }
+                    } else {
+                        int target = parsed[i].target;
+                        std::vector<int> path = parsed[i].detail ? tree->getPath(target) : std::vector<int>();
+                        writePointToPoint(out, tree->distances[target], parsed[i].detail, path);
+                    }
+                    respond(batch[i], STATUS_OK, out);
+                    ++answered;
+                }
+            } else {
+                ++search_count;
+                std::vector<int> targets;
+                for (size_t i : members) targets.push_back(parsed[i].target);
+                PointToPointResult result = point_query.run(source, targets);
+                for (size_t k = 0; k < members.size(); ++k) {
+                    size_t i = members[k];
+                    std::vector<char> out;
+                    std::vector<int> path = parsed[i].detail ? point_query.getPath(parsed[i].target) : std::vector<int>();
+                    writePointToPoint(out, result.distances[k], parsed[i].detail, path);
+                    respond(batch[i], STATUS_OK, out);
+                    ++answered;
+                }
+            }
+        } catch (const std::exception& e) {
+            for (size_t k = answered; k < members.size(); ++k) fail(batch[members[k]], e.what());
+        }
+    }
+}
+
+// ----- QueryClient -----
+
+QueryClient::QueryClient(const std::string& socket_path) : fd(-1), next_id(1) {
+    sockaddr_un address = socketAddress(socket_path, "QueryClient");
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("QueryClient: socket() failed: " + std::string(std::strerror(errno)));
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("QueryClient: cannot connect to " + socket_path + ": " + reason);
+    }
+}
+
+QueryClient::~QueryClient() {
+    ::close(fd);
+}
+
+std::vector<char> QueryClient::call(uint8_t type, const std::vector<char>& payload) {
+    uint32_t id = next_id++;
+    std::vector<char> out = frame(id, type, payload);
+    if (!writeFully(fd, out.data(), out.size())) throw std::runtime_error("QueryClient: connection lost");
+
+    char header[HEADER_BYTES];
+    if (!readFully(fd, header, HEADER_BYTES)) throw std::runtime_error("QueryClient: connection lost");
+    uint32_t payload_bytes, response_id;
+    std::memcpy(&payload_bytes, header, sizeof(uint32_t));
+    std::memcpy(&response_id, header + 4, sizeof(uint32_t));
+    std::vector<char> response(payload_bytes);
+    if (payload_bytes > 0 && !readFully(fd, response.data(), payload_bytes)) {
+        throw std::runtime_error("QueryClient: connection lost");
+    }
+    if (response_id != id) throw std::runtime_error("QueryClient: response to an unknown request");
+    if (static_cast<uint8_t>(header[8]) != STATUS_OK) {
+        throw std::runtime_error("QueryClient: " + std::string(response.begin(), response.end()));
+    }
+    return response;
+}
+
+void QueryClient::info(int& num_vertices, int64_t& num_edges) {
+    std::vector<char> response = call(INFO, std::vector<char>());
+    PayloadReader reader(response);
+    num_vertices = reader.get<int32_t>();
+    num_edges = reader.get<int64_t>();
+}
+
+std::vector<double> QueryClient::sssp(int source, std::vector<int>* predecessors) {
+    std::vector<char> payload;
+    PayloadWriter writer(payload);
+    writer.put(static_cast<int32_t>(source));
+    writer.put(static_cast<uint8_t>(predecessors ? FLAG_PREDECESSORS : 0));
+
+    std::vector<char> response = call(SSSP, payload);
+    PayloadReader reader(response);
+    uint32_t n = reader.get<uint32_t>();
+    std::vector<double> distances;
+    reader.getArray(distances, n);
+    if (predecessors) {
+        std::vector<int32_t> raw;
+        reader.getArray(raw, n);
+        predecessors->assign(raw.begin(), raw.end());
+    }
+    return distances;
+}
+
+double QueryClient::pointToPoint(int source, int target, std::vector<int>* path) {
+    std::vector<char> payload;
+    PayloadWriter writer(payload);
+    writer.put(static_cast<int32_t>(source));
+    writer.put(static_cast<int32_t>(target));
+    writer.put(static_cast<uint8_t>(path ? FLAG_PATH : 0));
+
+    std::vector<char> response = call(POINT_TO_POINT, payload);
+    PayloadReader reader(response);
+    double distance = reader.get<double>();
+    uint32_t length = reader.get<uint32_t>();
+    std::vector<int32_t> raw;
+    reader.getArray(raw, length);
+    if (path) path->assign(raw.begin(), raw.end());
+    return distance;
+}
+
+std::vector<double> QueryClient::distanceTable(const std::vector<int>& sources, const std::vector<int>& targets) {
+    std::vector<char> payload;
+    PayloadWriter writer(payload);
+    std::vector<int32_t> source_ids(sources.begin(), sources.end());
+    std::vector<int32_t> target_ids(targets.begin(), targets.end());
+    writer.put(static_cast<uint32_t>(source_ids.size()));
+    writer.put(static_cast<uint32_t>(target_ids.size()));
+    writer.putArray(source_ids.data(), source_ids.size());
+    writer.putArray(target_ids.data(), target_ids.size());
+
+    std::vector<char> response = call(DISTANCE_TABLE, payload);
+    PayloadReader reader(response);
+    uint32_t num_sources = reader.get<uint32_t>();
+    uint32_t num_targets = reader.get<uint32_t>();
+    std::vector<double> distances;
+    reader.getArray(distances, static_cast<size_t>(num_sources) * num_targets);
+    return distances;
+}
@@ -0,0 +1,182 @@
+#include "RelaxKernel.h"
+#include "Debug.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FASTDIJKSTRA_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    SimdLevel levelFromEnvironment(SimdLevel detected) {
+        const char* env = std::getenv("FASTDIJKSTRA_SIMD");
+        if (!env) return detected;
+        SimdLevel requested = detected;
+        if (std::strcmp(env, "scalar") == 0) requested = SimdLevel::SCALAR;
+        else if (std::strcmp(env, "avx2") == 0) requested = SimdLevel::AVX2;
+        else if (std::strcmp(env, "avx512") == 0) requested = SimdLevel::AVX512;
+        return std::min(requested, detected);
+    }
+
+    std::atomic<int> g_simd_level(-1);
+
+    template <typename Weight>
+    size_t relaxScalar(double base, const int* targets, const Weight* weights, size_t begin, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved,
+                       size_t found) {
+        for (size_t i = begin; i < count; ++i) {
+            double candidate = base + static_cast<double>(weights[i]);
+            candidates[i] = candidate;
+            double current = distances[targets[i]];
+            if (candidate < current || (allow_equal && candidate == current)) {
+                improved[found++] = static_cast<uint32_t>(i);
+            }
+        }
+        return found;
+    }
+
+#ifdef FASTDIJKSTRA_X86_SIMD
+    __attribute__((target("avx2"))) inline __m256d loadWeights4(const double* weights) {
+        return _mm256_loadu_pd(weights);
+    }
+
+    __attribute__((target("avx2"))) inline __m256d loadWeights4(const float* weights) {
+        return _mm256_cvtps_pd(_mm_loadu_ps(weights));
+    }
+
+    // No unsigned conversion before AVX-512: convert as signed and add 2^32 where negative
+    __attribute__((target("avx2"))) inline __m256d loadWeights4(const uint32_t* weights) {
+        __m256d converted = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights)));
+        __m256d negative = _mm256_cmp_pd(converted, _mm256_setzero_pd(), _CMP_LT_OQ);
+        return _mm256_add_pd(converted, _mm256_and_pd(negative, _mm256_set1_pd(4294967296.0)));
+    }
+
+    template <typename Weight>
+    __attribute__((target("avx2")))
+    size_t relaxAvx2(double base, const int* targets, const Weight* weights, size_t count,
+                     const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+        const __m256d base4 = _mm256_set1_pd(base);
+        size_t found = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(targets + i));
+            __m256d current = _mm256_i32gather_pd(distances, index, 8);
+            __m256d candidate = _mm256_add_pd(base4, loadWeights4(weights + i));
+            _mm256_storeu_pd(candidates + i, candidate);
+            __m256d better = allow_equal ? _mm256_cmp_pd(candidate, current, _CMP_LE_OQ)
+                                         : _mm256_cmp_pd(candidate, current, _CMP_LT_OQ);
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(better));
+            while (mask) {
+                improved[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+        return relaxScalar(base, targets, weights, i, count, distances, allow_equal, candidates, improved, found);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512d loadWeights8(const double* weights) {
+        return _mm512_loadu_pd(weights);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512d loadWeights8(const float* weights) {
+        return _mm512_cvtps_pd(_mm256_loadu_ps(weights));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512d loadWeights8(const uint32_t* weights) {
+        return _mm512_cvtepu32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights)));
+    }
+
+    template <typename Weight>
+    __attribute__((target("avx512f")))
+    size_t relaxAvx512(double base, const int* targets, const Weight* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+        const __m512d base8 = _mm512_set1_pd(base);
+        size_t found = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(targets + i));
+            __m512d current = _mm512_i32gather_pd(index, distances, 8);
+            __m512d candidate = _mm512_add_pd(base8, loadWeights8(weights + i));
+            _mm512_storeu_pd(candidates + i, candidate);
+            unsigned mask = allow_equal ? _mm512_cmp_pd_mask(candidate, current, _CMP_LE_OQ)
+                                        : _mm512_cmp_pd_mask(candidate, current, _CMP_LT_OQ);
+            while (mask) {
+                improved[found++] = static_cast<uint32_t>(i + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+        return relaxScalar(base, targets, weights, i, count, distances, allow_equal, candidates, improved, found);
+    }
+#endif
+
+    template <typename Weight>
+    size_t dispatch(double base, const int* targets, const Weight* weights, size_t count,
+                    const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+#ifdef FASTDIJKSTRA_X86_SIMD
+        switch (getSimdLevel()) {
+            case SimdLevel::AVX512:
+                return relaxAvx512(base, targets, weights, count, distances, allow_equal, candidates, improved);
+            case SimdLevel::AVX2:
+                return relaxAvx2(base, targets, weights, count, distances, allow_equal, candidates, improved);
+            default:
+                break;
+        }
+#endif
+        return relaxScalar(base, targets, weights, 0, count, distances, allow_equal, candidates, improved, 0);
+    }
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef FASTDIJKSTRA_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel getSimdLevel() {
+    int level = g_simd_level.load(std::memory_order_relaxed);
+    if (level < 0) {
+        SimdLevel detected = levelFromEnvironment(detectSimdLevel());
+        DEBUG_PRINT("Relaxation kernel uses " << simdLevelName(detected));
+        level = static_cast<int>(detected);
+        g_simd_level.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+void setSimdLevel(SimdLevel level) {
+    g_simd_level.store(static_cast<int>(std::min(level, detectSimdLevel())), std::memory_order_relaxed);
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "avx512";
+        case SimdLevel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+RelaxScratch& RelaxScratch::threadLocal() {
+    thread_local RelaxScratch scratch;
+    return scratch;
+}
+
+size_t relaxCandidates(double base, const int* targets, const double* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+    return dispatch(base, targets, weights, count, distances, allow_equal, candidates, improved);
+}
+
+size_t relaxCandidates(double base, const int* targets, const float* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+    return dispatch(base, targets, weights, count, distances, allow_equal, candidates, improved);
+}
+
+size_t relaxCandidates(double base, const int* targets, const uint32_t* weights, size_t count,
+                       const double* distances, bool allow_equal, double* candidates, uint32_t* improved) {
+    return dispatch(base, targets, weights, count, distances, allow_equal, candidates, improved);
+}
@@ -0,0 +1,266 @@
+#include "Reorder.h"
+#include "Parallel.h"
+#include "Debug.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    // Live edges of both directions, self-loops dropped, in CSR form
+    struct UndirectedView {
+        std::vector<int64_t> offsets;
+        std::vector<int> targets;
+
+        int degree(int v) const { return static_cast<int>(offsets[v + 1] - offsets[v]); }
+    };
+
+    UndirectedView undirectedView(const Graph& graph) {
+        int n = graph.getNumVertices();
+        UndirectedView view;
+        view.offsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.isRemoved() || edge.dest == u) continue;
+                view.offsets[u + 1]++;
+                view.offsets[edge.dest + 1]++;
+            }
+        }
+        for (int v = 0; v < n; ++v) view.offsets[v + 1] += view.offsets[v];
+
+        view.targets.resize(view.offsets[n]);
+        std::vector<int64_t> fill(view.offsets.begin(), view.offsets.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.isRemoved() || edge.dest == u) continue;
+                view.targets[fill[u]++] = edge.dest;
+                view.targets[fill[edge.dest]++] = u;
+            }
+        }
+        return view;
+    }
+
+    std::vector<int> bfsOrder(const UndirectedView& view, int n) {
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<char> visited(n, 0);
+        for (int start = 0; start < n; ++start) {
+            if (visited[start]) continue;
+            visited[start] = 1;
+            order.push_back(start);
+            for (size_t head = order.size() - 1; head < order.size(); ++head) {
+                int u = order[head];
+                for (int64_t i = view.offsets[u]; i < view.offsets[u + 1]; ++i) {
+                    int v = view.targets[i];
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        order.push_back(v);
+                    }
+                }
+            }
+        }
+        return order;
+    }
+
+    // Level structure of a BFS from root: returns the eccentricity and the lowest-degree vertex
+    // of the last level. `level` uses -1 for unvisited and is restored before returning.
+    std::pair<int, int> lastLevel(const UndirectedView& view, int root, std::vector<int>& level,
+                                  std::vector<int>& queue) {
+        queue.clear();
+        queue.push_back(root);
+        level[root] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            for (int64_t i = view.offsets[u]; i < view.offsets[u + 1]; ++i) {
+                int v = view.targets[i];
+                if (level[v] < 0) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        int depth = level[queue.back()];
+        int best = queue.back();
+        for (auto it = queue.rbegin(); it != queue.rend() && level[*it] == depth; ++it) {
+            if (view.degree(*it) < view.degree(best)) best = *it;
+        }
+        for (int v : queue) level[v] = -1;
+        return {depth, best};
+    }
+
+    std::vector<int> rcmOrder(const UndirectedView& view, int n) {
+        std::vector<int> by_degree(n);
+        for (int v = 0; v < n; ++v) by_degree[v] = v;
+        std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) {
+            return view.degree(a) < view.degree(b);
+        });
+
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<char> visited(n, 0);
+        std::vector<int> level(n, -1), scratch, children;
+        for (int candidate : by_degree) {
+            if (visited[candidate]) continue;
+
+            // George-Liu: hop to the far end of the level structure while it keeps deepening
+            int start = candidate;
+            std::pair<int, int> far = lastLevel(view, start, level, scratch);
+            for (int hop = 0; hop < 8; ++hop) {
+                std::pair<int, int> next = lastLevel(view, far.second, level, scratch);
+                if (next.first <= far.first) break;
+                start = far.second;
+                far = next;
+            }
+
+            // Cuthill-McKee: visit each vertex's new neighbours by increasing degree
+            visited[start] = 1;
+            order.push_back(start);
+            for (size_t head = order.size() - 1; head < order.size(); ++head) {
+                int u = order[head];
+                children.clear();
+                for (int64_t i = view.offsets[u]; i < view.offsets[u + 1]; ++i) {
+                    int v = view.targets[i];
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        children.push_back(v);
+                    }
+                }
+                std::sort(children.begin(), children.end(), [&](int a, int b) {
+                    return view.degree(a) != view.degree(b) ? view.degree(a) < view.degree(b) : a < b;
+                });
+                order.insert(order.end(), children.begin(), children.end());
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    std::vector<int> degreeOrder(const UndirectedView& view, int n) {
+        std::vector<int> order(n);
+        for (int v = 0; v < n; ++v) order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return view.degree(a) > view.degree(b);
+        });
+        return order;
+    }
+
+    // Distance along the order-16 Hilbert curve of cell (x, y), both in [0, 2^16)
+    uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+        const uint32_t side = 1u << 16;
+        uint64_t d = 0;
+        for (uint32_t s = side / 2; s > 0; s /= 2) {
+            uint32_t rx = (x & s) ? 1 : 0;
+            uint32_t ry = (y & s) ? 1 : 0;
+            d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = side - 1 - x;
+                    y = side - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return d;
+    }
+
+    std::vector<int> hilbertOrder(const std::vector<double>& x, const std::vector<double>& y, int n) {
+        double min_x = *std::min_element(x.begin(), x.end()), max_x = *std::max_element(x.begin(), x.end());
+        double min_y = *std::min_element(y.begin(), y.end()), max_y = *std::max_element(y.begin(), y.end());
+        double span = std::max(max_x - min_x, max_y - min_y);
+        double scale = span > 0.0 ? 65535.0 / span : 0.0;
+
+        std::vector<std::pair<uint64_t, int>> keyed(n);
+        parallelFor(0, n, 4096, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                uint32_t cx = static_cast<uint32_t>((x[v] - min_x) * scale);
+                uint32_t cy = static_cast<uint32_t>((y[v] - min_y) * scale);
+                keyed[v] = {hilbertIndex(cx, cy), static_cast<int>(v)};
+            }
+        });
+        std::sort(keyed.begin(), keyed.end());
+
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i) order[i] = keyed[i].second;
+        return order;
+    }
+}
+
+std::vector<double> ReorderResult::mapBack(const std::vector<double>& values) const {
+    std::vector<double> original(permutation.size());
+    for (size_t v = 0; v < permutation.size(); ++v) original[v] = values[permutation[v]];
+    return original;
+}
+
+std::vector<int> ReorderResult::mapPredecessorsBack(const std::vector<int>& predecessors) const {
+    std::vector<int> original(permutation.size());
+    for (size_t v = 0; v < permutation.size(); ++v) {
+        int pred = predecessors[permutation[v]];
+        original[v] = pred < 0 ? -1 : inverse[pred];
+    }
+    return original;
+}
+
+ReorderResult reorder(const Graph& graph, ReorderStrategy strategy,
+                      const std::vector<double>& x, const std::vector<double>& y) {
+    int n = graph.getNumVertices();
+    DEBUG_FUNCTION_ENTRY("reorder", "n=" << n << ", strategy=" << static_cast<int>(strategy));
+
+    std::vector<int> order;   // new id -> old id
+    if (strategy == ReorderStrategy::HILBERT) {
+        if (static_cast<int>(x.size()) != n || static_cast<int>(y.size()) != n) {
+            throw std::invalid_argument("reorder: HILBERT needs one coordinate pair per vertex, got " +
+                                        std::to_string(x.size()) + " x and " + std::to_string(y.size()) +
+                                        " y values for " + std::to_string(n) + " vertices");
+        }
+        order = n > 0 ? hilbertOrder(x, y, n) : std::vector<int>();
+    } else {
+        UndirectedView view = undirectedView(graph);
+        switch (strategy) {
+            case ReorderStrategy::BFS: order = bfsOrder(view, n); break;
+            case ReorderStrategy::RCM: order = rcmOrder(view, n); break;
+            default: order = degreeOrder(view, n); break;
+        }
+    }
+
+    std::vector<int> permutation(n);
+    for (int i = 0; i < n; ++i) permutation[order[i]] = i;
+
+    std::vector<std::vector<Edge>> adjacency(n);
+    parallelFor(0, n, 1024, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; ++v) {
+            std::vector<Edge>& edges = adjacency[v];
+            for (const auto& edge : graph.neighbors(order[v])) {
+                if (!edge.isRemoved()) edges.push_back(Edge{permutation[edge.dest], edge.weight});
+            }
+            std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+                return a.dest < b.dest;
+            });
+        }
+    });
+
+    ReorderResult result{Graph(n, std::move(adjacency)), std::move(permutation), std::move(order)};
+    for (int v = 0; v < n; ++v) {
+        if (graph.isVertexRemoved(v)) result.graph.removeVertex(result.permutation[v]);
+    }
+    if (graph.hasReverseEdges()) result.graph.enableReverseEdges();
+
+    DEBUG_FUNCTION_EXIT("reorder", "bandwidth=" << permutedBandwidth(graph, result.permutation));
+    return result;
+}
+
+ReorderResult reorder(const GeneratedGraph& graph, ReorderStrategy strategy) {
+    return reorder(graph.toGraph(), strategy, graph.x, graph.y);
+}
+
+int permutedBandwidth(const Graph& graph, const std::vector<int>& permutation) {
+    int bandwidth = 0;
+    for (int u = 0; u < graph.getNumVertices(); ++u) {
+        for (const auto& edge : graph.neighbors(u)) {
+            if (edge.isRemoved()) continue;
+            bandwidth = std::max(bandwidth, std::abs(permutation[u] - permutation[edge.dest]));
+        }
+    }
+    return bandwidth;
+}
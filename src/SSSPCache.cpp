@@ -0,0 +1,197 @@
+#include "SSSPCache.h"
+#include "Dijkstra.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    const double INF = std::numeric_limits<double>::max();
+    // Bookkeeping per entry beyond its arrays: the map node, the LRU node and the tree itself
+    const size_t ENTRY_OVERHEAD = sizeof(SSSPTree) + 64;
+}
+
+// ----- SSSPTree -----
+
+double SSSPTree::distance(int v) const {
+    if (isExact()) return distances[v];
+    float d = compact_distances[v];
+    return std::isinf(d) ? INF : static_cast<double>(d);
+}
+
+void SSSPTree::copyDistances(std::vector<double>& out) const {
+    if (isExact()) {
+        out.resize(distances.size());
+        if (!distances.empty()) std::memcpy(out.data(), distances.data(), distances.size() * sizeof(double));
+        return;
+    }
+    out.resize(compact_distances.size());
+    for (size_t v = 0; v < compact_distances.size(); ++v) {
+        float d = compact_distances[v];
+        out[v] = std::isinf(d) ? INF : static_cast<double>(d);
+    }
+}
+
+std::vector<int> SSSPTree::getPath(int target) const {
+    std::vector<int> path;
+    if (distance(target) == INF) return path;
+    for (int v = target; v != -1; v = predecessors[v]) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+size_t SSSPTree::memoryUsage() const {
+    return ENTRY_OVERHEAD + distances.capacity() * sizeof(double) + compact_distances.capacity() * sizeof(float) +
+           predecessors.capacity() * sizeof(int);
+}
+
+// ----- SSSPCache -----
+
+SSSPCache::SSSPCache(const Graph& graph, const SSSPCacheOptions& options)
+    : graph(graph), options(options), cached_version(graph.getVersion()), epoch(0), bytes(0) {}
+
+std::shared_ptr<const SSSPTree> SSSPCache::compute(int source, uint64_t version) const {
+    auto tree = std::make_shared<SSSPTree>();
+    tree->source = source;
+    tree->graph_version = version;
+
+    DijkstraResults result = runDijkstra(graph, source);
+    tree->distances = std::move(result.distances);
+    tree->predecessors = std::move(result.predecessors);
+
+    if (options.float_distances) {
+        tree->compact_distances.resize(tree->distances.size());
+        for (size_t v = 0; v < tree->distances.size(); ++v) {
+            double d = tree->distances[v];
+            tree->compact_distances[v] = d == INF ? std::numeric_limits<float>::infinity() : static_cast<float>(d);
+        }
+        std::vector<double>().swap(tree->distances);
+    }
+    return tree;
+}
+
+void SSSPCache::dropStaleLocked() {
+    uint64_t version = graph.getVersion();
+    if (version == cached_version) return;
+    DEBUG_PRINT("SSSPCache: graph version " << cached_version << " -> " << version << ", dropping "
+                << entries.size() << " trees");
+    cached_version = version;
+    flushLocked();
+}
+
+void SSSPCache::flushLocked() {
+    if (!entries.empty() || !pending.empty()) ++counters.invalidations;
+    entries.clear();
+    lru.clear();
+    bytes = 0;
+    ++epoch;
+}
+
+void SSSPCache::finishLocked(int source, uint64_t search_epoch) {
+    // A flush may have let a newer search of the same source replace this one
+    auto it = pending.find(source);
+    if (it != pending.end() && it->second.epoch == search_epoch) pending.erase(it);
+}
+
+void SSSPCache::evictLocked(size_t capacity) {
+    while (bytes > capacity && !lru.empty()) {
+        auto it = entries.find(lru.back());
+        bytes -= it->second.tree->memoryUsage();
+        entries.erase(it);
+        lru.pop_back();
+        ++counters.evictions;
+    }
+}
+
+std::shared_ptr<const SSSPTree> SSSPCache::get(int source) {
+    if (source < 0 || source >= graph.getNumVertices()) {
+        throw std::invalid_argument("SSSPCache::get: source " + std::to_string(source) + " out of range");
+    }
+    QueryScope scope("SSSPCache::get", &graph);
+    if (scope.isActive()) scope.setParameters("source=" + std::to_string(source));
+
+    std::promise<std::shared_ptr<const SSSPTree>> promise;
+    uint64_t version, started_epoch;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        dropStaleLocked();
+        auto hit = entries.find(source);
+        if (hit != entries.end()) {
+            lru.splice(lru.begin(), lru, hit->second.position);
+            ++counters.hits;
+            QueryScope::count("cache_hits", 1);
+            return hit->second.tree;
+        }
+        auto running = pending.find(source);
+        if (running != pending.end() && running->second.epoch == epoch) {
+            std::shared_future<std::shared_ptr<const SSSPTree>> result = running->second.result;
+            ++counters.coalesced;
+            lock.unlock();
+            QueryScope::count("cache_hits", 1);
+            return result.get();
+        }
+        ++counters.misses;
+        version = cached_version;
+        started_epoch = epoch;
+        pending[source] = Search{promise.get_future().share(), epoch};
+    }
+    QueryScope::count("cache_misses", 1);
+
+    std::shared_ptr<const SSSPTree> tree;
+    try {
+        tree = compute(source, version);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishLocked(source, started_epoch);
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishLocked(source, started_epoch);
+        dropStaleLocked();
+        size_t size = tree->memoryUsage();
+        if (started_epoch == epoch && size <= options.capacity_bytes && entries.count(source) == 0) {
+            lru.push_front(source);
+            entries[source] = Entry{tree, lru.begin()};
+            bytes += size;
+            evictLocked(options.capacity_bytes);
+        }
+    }
+    promise.set_value(tree);
+    return tree;
+}
+
+bool SSSPCache::contains(int source) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cached_version == graph.getVersion() && entries.count(source) > 0;
+}
+
+void SSSPCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+}
+
+void SSSPCache::setCapacity(size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    options.capacity_bytes = capacity_bytes;
+    evictLocked(capacity_bytes);
+}
+
+SSSPCacheStats SSSPCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    SSSPCacheStats result = counters;
+    result.entries = entries.size();
+    result.bytes = bytes;
+    return result;
+}
+
+void SSSPCache::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters = SSSPCacheStats();
+}
@@ -0,0 +1,68 @@
+#include "SearchWorkspace.h"
+#include "Debug.h"
+#include <algorithm>
+#include <limits>
+
+SearchWorkspace::SearchWorkspace(int num_vertices) : epoch(1) {
+    resize(num_vertices);
+}
+
+SearchWorkspace& SearchWorkspace::threadLocal(int num_vertices) {
+    thread_local SearchWorkspace workspace;
+    if (workspace.getNumVertices() != num_vertices) {
+        workspace.resize(num_vertices);
+    }
+    return workspace;
+}
+
+int SearchWorkspace::getNumVertices() const {
+    return static_cast<int>(stamps.size());
+}
+
+void SearchWorkspace::resize(int num_vertices) {
+    DEBUG_MEMORY("SearchWorkspace resize to n=" << num_vertices);
+
+    int n = std::max(0, num_vertices);
+    distances.assign(n, std::numeric_limits<double>::max());
+    predecessors.assign(n, -1);
+    stamps.assign(n, 0);
+    settled_stamps.assign(n, 0);
+    epoch = 1;
+    touched.clear();
+    queue.resize(n);
+}
+
+void SearchWorkspace::reset() {
+    queue.clear();
+    touched.clear();
+    if (++epoch == 0) {
+        // Stamps wrapped around after 2^32 searches; clear them once so stale entries
+        // from the previous cycle cannot alias the new epoch
+        std::fill(stamps.begin(), stamps.end(), 0);
+        std::fill(settled_stamps.begin(), settled_stamps.end(), 0);
+        epoch = 1;
+    }
+}
+
+double SearchWorkspace::getDistance(int v) const {
+    return stamps[v] == epoch ? distances[v] : std::numeric_limits<double>::max();
+}
+
+int SearchWorkspace::getPredecessor(int v) const {
+    return stamps[v] == epoch ? predecessors[v] : -1;
+}
+
+const std::vector<int>& SearchWorkspace::getTouched() const {
+    return touched;
+}
+
+IndexedHeap& SearchWorkspace::getQueue() {
+    return queue;
+}
+
+size_t SearchWorkspace::memoryUsage() const {
+    // queue is a member, so sizeof(*this) already covers the IndexedHeap object itself
+    return sizeof(*this) - sizeof(IndexedHeap) + queue.memoryUsage() + distances.capacity() * sizeof(double) +
+           predecessors.capacity() * sizeof(int) + stamps.capacity() * sizeof(uint32_t) +
+           settled_stamps.capacity() * sizeof(uint32_t) + touched.capacity() * sizeof(int);
+}
@@ -0,0 +1,133 @@
+#include "SparseResult.h"
+#include "Debug.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+SparseResult::SparseResult(int num_vertices) : num_vertices(std::max(0, num_vertices)) {}
+
+SparseResult SparseResult::fromDense(const std::vector<double>& distances, const std::vector<int>& predecessors) {
+    if (distances.size() != predecessors.size()) {
+        throw std::invalid_argument("SparseResult::fromDense: " + std::to_string(distances.size()) +
+                                    " distances but " + std::to_string(predecessors.size()) + " predecessors");
+    }
+    SparseResult result(static_cast<int>(distances.size()));
+    for (size_t v = 0; v < distances.size(); ++v) {
+        if (distances[v] != std::numeric_limits<double>::max()) {
+            result.add(static_cast<int>(v), distances[v], predecessors[v]);
+        }
+    }
+    return result;
+}
+
+SparseResult SparseResult::fromDense(const std::vector<double>& distances, const std::vector<int>& predecessors,
+                                     const std::vector<int>& vertices) {
+    if (distances.size() != predecessors.size()) {
+        throw std::invalid_argument("SparseResult::fromDense: " + std::to_string(distances.size()) +
+                                    " distances but " + std::to_string(predecessors.size()) + " predecessors");
+    }
+    SparseResult result(static_cast<int>(distances.size()));
+    result.reserve(vertices.size());
+    for (int v : vertices) {
+        if (v < 0 || v >= result.num_vertices) {
+            throw std::invalid_argument("SparseResult::fromDense: vertex " + std::to_string(v) + " out of range");
+        }
+        if (distances[v] != std::numeric_limits<double>::max()) result.add(v, distances[v], predecessors[v]);
+    }
+    return result;
+}
+
+SparseResult SparseResult::fromWorkspace(const SearchWorkspace& workspace, bool settled_only) {
+    SparseResult result(workspace.getNumVertices());
+    const std::vector<int>& touched = workspace.getTouched();
+    result.reserve(touched.size());
+    for (int v : touched) {
+        if (!settled_only || workspace.isSettled(v)) {
+            result.add(v, workspace.getDistance(v), workspace.getPredecessor(v));
+        }
+    }
+    return result;
+}
+
+void SparseResult::add(int v, double distance, int predecessor) {
+    DEBUG_BOUNDS_CHECK(v, num_vertices, "SparseResult vertex");
+    auto inserted = slot.insert({v, static_cast<int>(vertices.size())});
+    if (!inserted.second) {
+        distances[inserted.first->second] = distance;
+        predecessors[inserted.first->second] = predecessor;
+        return;
+    }
+    vertices.push_back(v);
+    distances.push_back(distance);
+    predecessors.push_back(predecessor);
+}
+
+void SparseResult::reserve(size_t count) {
+    vertices.reserve(count);
+    distances.reserve(count);
+    predecessors.reserve(count);
+    slot.reserve(count);
+}
+
+int SparseResult::getNumVertices() const {
+    return num_vertices;
+}
+
+size_t SparseResult::size() const {
+    return vertices.size();
+}
+
+bool SparseResult::empty() const {
+    return vertices.empty();
+}
+
+bool SparseResult::contains(int v) const {
+    return slot.count(v) != 0;
+}
+
+double SparseResult::getDistance(int v) const {
+    auto it = slot.find(v);
+    return it == slot.end() ? std::numeric_limits<double>::max() : distances[it->second];
+}
+
+int SparseResult::getPredecessor(int v) const {
+    auto it = slot.find(v);
+    return it == slot.end() ? -1 : predecessors[it->second];
+}
+
+std::vector<int> SparseResult::getPath(int target) const {
+    std::vector<int> path;
+    if (!contains(target)) return path;
+    for (int v = target; v != -1; v = getPredecessor(v)) {
+        path.push_back(v);
+        if (path.size() > vertices.size()) {
+            throw std::logic_error("SparseResult::getPath: predecessor cycle at vertex " + std::to_string(v));
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+const std::vector<int>& SparseResult::getVertices() const {
+    return vertices;
+}
+
+const std::vector<double>& SparseResult::getDistances() const {
+    return distances;
+}
+
+const std::vector<int>& SparseResult::getPredecessors() const {
+    return predecessors;
+}
+
+DijkstraResults SparseResult::toDense() const {
+    DijkstraResults result;
+    result.distances.assign(num_vertices, std::numeric_limits<double>::max());
+    result.predecessors.assign(num_vertices, -1);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        result.distances[vertices[i]] = distances[i];
+        result.predecessors[vertices[i]] = predecessors[i];
+    }
+    return result;
+}
@@ -0,0 +1,128 @@
+#include "Trace.h"
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::atomic<bool> tracing_enabled(false);
+    std::atomic<int> next_thread(0);
+
+    int currentThread() {
+        thread_local int id = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void writeMicros(std::ostringstream& out, int64_t ns) {
+        out << ns / 1000 << '.';
+        int64_t fraction = ns % 1000;
+        if (fraction < 100) out << '0';
+        if (fraction < 10) out << '0';
+        out << fraction;
+    }
+
+    void writeNumber(std::ostringstream& out, double value) {
+        if (!std::isfinite(value)) {
+            out << (std::isnan(value) ? "\"nan\"" : value > 0 ? "\"inf\"" : "\"-inf\"");
+        } else if (value == std::floor(value) && std::fabs(value) < 1e15) {
+            out << static_cast<int64_t>(value);
+        } else {
+            out << value;
+        }
+    }
+}
+
+TraceRecorder::TraceRecorder() : origin(std::chrono::steady_clock::now()), max_events(0) {}
+
+TraceRecorder& TraceRecorder::global() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+bool TraceRecorder::isEnabled() {
+    return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::start(size_t max_events) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    this->max_events = max_events;
+    origin = std::chrono::steady_clock::now();
+    tracing_enabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::stop() {
+    tracing_enabled.store(false, std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+}
+
+void TraceRecorder::record(TraceEvent event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (events.size() >= max_events) return;
+    event.start_ns -= std::chrono::duration_cast<std::chrono::nanoseconds>(origin.time_since_epoch()).count();
+    if (event.start_ns < 0) return;   // began before start(), belongs to no trace
+    events.push_back(event);
+}
+
+std::vector<TraceEvent> TraceRecorder::getEvents() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events;
+}
+
+size_t TraceRecorder::eventCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+std::string TraceRecorder::toJson() const {
+    std::vector<TraceEvent> snapshot = getEvents();
+    std::ostringstream out;
+    out << "{\"traceEvents\": [";
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const TraceEvent& event = snapshot[i];
+        if (i > 0) out << ",";
+        out << "\n{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+            << "\", \"ph\": \"X\", \"ts\": ";
+        writeMicros(out, event.start_ns);
+        out << ", \"dur\": ";
+        writeMicros(out, event.duration_ns);
+        out << ", \"pid\": 1, \"tid\": " << event.thread << ", \"args\": {";
+        for (int a = 0; a < event.num_args; ++a) {
+            if (a > 0) out << ", ";
+            out << '"' << event.arg_names[a] << "\": ";
+            writeNumber(out, event.arg_values[a]);
+        }
+        out << "}}";
+    }
+    out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+    return out.str();
+}
+
+void TraceRecorder::writeJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) throw std::runtime_error("TraceRecorder: cannot open " + path + " for writing");
+    file << toJson();
+    if (!file) throw std::runtime_error("TraceRecorder: failed writing " + path);
+}
+
+TraceSpan::TraceSpan(const char* name, const char* category) : active(TraceRecorder::isEnabled()) {
+    if (!active) return;
+    event.name = name;
+    event.category = category;
+    event.num_args = 0;
+    start = std::chrono::steady_clock::now();
+}
+
+TraceSpan::~TraceSpan() {
+    if (!active) return;
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    event.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    event.duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    event.thread = currentThread();
+    TraceRecorder::global().record(event);
+}
@@ -0,0 +1,301 @@
+#include "BMSSPTestFramework.h"
+#include "Dijkstra.h"
+#include "BMSSP.h"
+#include "Debug.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+/**
+ * Performance Regression Check
+ * Runs a fixed, seeded benchmark matrix (graph type x size x algorithm) and compares
+ * throughput against a stored baseline CSV. Exits non-zero when any entry is slower than
+ * the baseline by more than the configured threshold.
+ *
+ * Usage:
+ *   perf_regression --baseline tests/perf_baseline.csv [--threshold 0.25]
+ *   perf_regression --baseline tests/perf_baseline.csv --update-baseline
+ */
+
+struct MatrixEntry {
+    GraphType type;
+    std::string type_name;
+    int vertices;
+    int edges;
+};
+
+struct RegressionResult {
+    std::string graph_type;
+    int vertices;
+    int edges;
+    std::string algorithm;
+    double median_ms;
+    double best_ms;
+    double edges_per_sec;   // from the best run, the most stable statistic on a shared machine
+};
+
+struct Options {
+    std::string baseline_path = "perf_baseline.csv";
+    std::string output_path;
+    double threshold = 0.25;
+    int repetitions = 5;
+    bool update_baseline = false;
+    bool quick = false;
+};
+
+static std::string makeKey(const std::string& type, int vertices, const std::string& algorithm) {
+    return type + "/" + std::to_string(vertices) + "/" + algorithm;
+}
+
+// FNV-1a over the cell's type name and vertex count. std::hash differs between standard
+// libraries, and the seed must not, or other toolchains would benchmark different graphs
+// than the ones the baseline was recorded on.
+static unsigned int cellSeed(const std::string& type_name, int vertices) {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](unsigned char byte) { hash = (hash ^ byte) * 16777619u; };
+    for (char c : type_name) mix(static_cast<unsigned char>(c));
+    for (int shift = 0; shift < 32; shift += 8) mix(static_cast<unsigned char>(static_cast<uint32_t>(vertices) >> shift));
+    return hash;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+static std::vector<MatrixEntry> buildMatrix(bool quick) {
+    std::vector<std::pair<GraphType, std::string>> types = {
+        {GraphType::RANDOM_SPARSE, "RANDOM_SPARSE"},
+        {GraphType::GRID_2D, "GRID_2D"},
+        {GraphType::RMAT, "RMAT"},
+        {GraphType::RANDOM_GEOMETRIC, "RANDOM_GEOMETRIC"},
+        {GraphType::ROAD_GRID, "ROAD_GRID"}
+    };
+    std::vector<int> sizes = quick ? std::vector<int>{2500} : std::vector<int>{2500, 10000};
+
+    std::vector<MatrixEntry> matrix;
+    for (const auto& type : types) {
+        for (int n : sizes) {
+            matrix.push_back({type.first, type.second, n, 8 * n});
+        }
+    }
+    return matrix;
+}
+
+static double timeDijkstra(Graph& graph, int source) {
+    auto start = std::chrono::high_resolution_clock::now();
+    DijkstraResults result = runDijkstra(graph, source);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (result.distances[source] != 0.0) {
+        std::cerr << "Dijkstra returned invalid source distance" << std::endl;
+        std::exit(2);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static double timeBMSSP(Graph& graph, int source) {
+    int n = graph.getNumVertices();
+    int t = std::max(2, graph.getT());
+    int level = std::max(1, static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::log(static_cast<double>(t)))));
+
+    std::vector<double> distances(n, std::numeric_limits<double>::max());
+    std::vector<int> predecessors(n, -1);
+    distances[source] = 0.0;
+
+    // BatchHeap stores its bound as int, so a large finite B stands in for B = infinity
+    auto start = std::chrono::high_resolution_clock::now();
+    runBMSSP(graph, distances, predecessors, level, 1e9, {source});
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static std::vector<RegressionResult> runMatrix(const Options& options) {
+    std::vector<RegressionResult> results;
+
+    for (const auto& entry : buildMatrix(options.quick)) {
+        // Seed depends only on the matrix cell so every run benchmarks identical graphs
+        BMSSPTestFramework framework(cellSeed(entry.type_name, entry.vertices));
+
+        TestParameters params;
+        params.num_vertices = entry.vertices;
+        params.num_edges = entry.edges;
+        params.graph_type = entry.type;
+        params.weight_dist = WeightDistribution::UNIFORM;
+        params.source_method = SourceGenMethod::SINGLE_SOURCE;
+        params.source_count = 1;
+        params.bound_type = BoundType::ZERO;  // bound is unused; avoid the reference run
+        params.k_param = 0;
+        params.t_param = 0;
+        params.test_name = entry.type_name;
+
+        BMSSPTestCase test_case = framework.generateTestCase(params);
+        Graph& graph = test_case.graph;
+        int edge_count = 0;
+        for (int v = 0; v < graph.getNumVertices(); ++v) {
+            edge_count += static_cast<int>(graph.getConnections(v).size());
+        }
+
+        for (const std::string algorithm : {"dijkstra", "bmssp"}) {
+            // One discarded warm-up run so page faults and cold caches do not skew the median
+            if (algorithm == "dijkstra") timeDijkstra(graph, 0); else timeBMSSP(graph, 0);
+
+            // At least `repetitions` runs, extended for fast cells until ~200 ms were measured,
+            // so short benchmarks are not dominated by timer and scheduler noise
+            std::vector<double> times;
+            double total_ms = 0.0;
+            while (static_cast<int>(times.size()) < options.repetitions ||
+                   (total_ms < 200.0 && times.size() < 200)) {
+                times.push_back(algorithm == "dijkstra" ? timeDijkstra(graph, 0) : timeBMSSP(graph, 0));
+                total_ms += times.back();
+            }
+
+            RegressionResult result;
+            result.graph_type = entry.type_name;
+            result.vertices = graph.getNumVertices();
+            result.edges = edge_count;
+            result.algorithm = algorithm;
+            result.median_ms = median(times);
+            result.best_ms = *std::min_element(times.begin(), times.end());
+            result.edges_per_sec = edge_count / std::max(result.best_ms, 1e-6) * 1000.0;
+            results.push_back(result);
+
+            std::cout << "  " << std::left << std::setw(18) << entry.type_name
+                      << std::setw(8) << result.vertices << std::setw(10) << algorithm
+                      << std::right << std::fixed << std::setprecision(3) << std::setw(12)
+                      << result.median_ms << " ms median, " << result.best_ms << " ms best ("
+                      << times.size() << " runs)" << std::endl;
+        }
+    }
+    return results;
+}
+
+static bool loadBaseline(const std::string& path, std::map<std::string, RegressionResult>& baseline) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    std::getline(file, line);  // header
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::stringstream ss(line);
+        RegressionResult r;
+        std::string field;
+        std::getline(ss, r.graph_type, ',');
+        std::getline(ss, field, ','); r.vertices = std::stoi(field);
+        std::getline(ss, field, ','); r.edges = std::stoi(field);
+        std::getline(ss, r.algorithm, ',');
+        std::getline(ss, field, ','); r.median_ms = std::stod(field);
+        std::getline(ss, field, ','); r.best_ms = std::stod(field);
+        std::getline(ss, field, ','); r.edges_per_sec = std::stod(field);
+        baseline[makeKey(r.graph_type, r.vertices, r.algorithm)] = r;
+    }
+    return true;
+}
+
+static void saveResults(const std::string& path, const std::vector<RegressionResult>& results) {
+    std::ofstream file(path);
+    file << "graph_type,vertices,edges,algorithm,median_ms,best_ms,edges_per_sec\n";
+    for (const auto& r : results) {
+        file << r.graph_type << "," << r.vertices << "," << r.edges << "," << r.algorithm << ","
+             << std::fixed << std::setprecision(4) << r.median_ms << "," << r.best_ms << ","
+             << std::setprecision(1) << r.edges_per_sec << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    initializeDebug(argc, argv);
+
+    Options options;
+    if (const char* env = std::getenv("PERF_REGRESSION_THRESHOLD")) {
+        options.threshold = std::atof(env);
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--baseline" && i + 1 < argc) {
+            options.baseline_path = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output_path = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            options.threshold = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--update-baseline") {
+            options.update_baseline = true;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--debug" || arg == "-d") {
+        } else {
+            std::cout << "Usage: " << argv[0] << " --baseline FILE [--threshold FRACTION] [--repetitions N]"
+                      << " [--output FILE] [--update-baseline] [--quick]" << std::endl;
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    std::cout << "=== PERFORMANCE REGRESSION CHECK ===" << std::endl;
+    std::cout << "Baseline: " << options.baseline_path << ", threshold: "
+              << std::setprecision(0) << std::fixed << options.threshold * 100 << "%, repetitions: "
+              << options.repetitions << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+
+    std::vector<RegressionResult> results = runMatrix(options);
+
+    if (!options.output_path.empty()) {
+        saveResults(options.output_path, results);
+    }
+
+    if (options.update_baseline) {
+        saveResults(options.baseline_path, results);
+        std::cout << "\n✓ Baseline written to " << options.baseline_path << std::endl;
+        return 0;
+    }
+
+    std::map<std::string, RegressionResult> baseline;
+    if (!loadBaseline(options.baseline_path, baseline)) {
+        std::cerr << "\n❌ Could not read baseline " << options.baseline_path
+                  << " (run with --update-baseline to create it)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n" << std::left << std::setw(18) << "Graph" << std::setw(8) << "n"
+              << std::setw(10) << "Algorithm" << std::right << std::setw(14) << "Baseline Me/s"
+              << std::setw(14) << "Current Me/s" << std::setw(10) << "Change" << std::endl;
+    std::cout << std::string(74, '-') << std::endl;
+
+    int regressions = 0;
+    for (const auto& r : results) {
+        auto it = baseline.find(makeKey(r.graph_type, r.vertices, r.algorithm));
+        std::cout << std::left << std::setw(18) << r.graph_type << std::setw(8) << r.vertices
+                  << std::setw(10) << r.algorithm << std::right << std::fixed << std::setprecision(2);
+        if (it == baseline.end()) {
+            std::cout << std::setw(14) << "-" << std::setw(14) << r.edges_per_sec / 1e6
+                      << std::setw(10) << "NEW" << std::endl;
+            continue;
+        }
+        double change = r.edges_per_sec / it->second.edges_per_sec - 1.0;
+        bool regressed = change < -options.threshold;
+        if (regressed) regressions++;
+        std::cout << std::setw(14) << it->second.edges_per_sec / 1e6 << std::setw(14) << r.edges_per_sec / 1e6
+                  << std::setw(9) << std::showpos << change * 100 << std::noshowpos << "%"
+                  << (regressed ? "  ❌ REGRESSION" : "") << std::endl;
+    }
+
+    std::cout << std::string(74, '-') << std::endl;
+    if (regressions > 0) {
+        std::cout << "❌ " << regressions << " benchmark(s) regressed by more than "
+                  << options.threshold * 100 << "%" << std::endl;
+        return 1;
+    }
+    std::cout << "✓ No throughput regressions beyond " << options.threshold * 100 << "%" << std::endl;
+    return 0;
+}
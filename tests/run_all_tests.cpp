@@ -23,6 +23,11 @@ void printUsage(const char* program_name) {
               << "  --edge-cases      Run edge cases and error handling tests\n"
               << "  --performance     Run performance and scalability tests\n"
               << "  --large-scale     Run large scale testing (up to 10K vertices)\n"
+              << "  --generators      Run large-scale graph generator tests\n"
+              << "  --queries         Run query engine tests (distance tables, ...)\n"
+              << "  --speedups        Run preprocessing-based speed-up tests (CH, ...)\n"
+              << "  --dynamic         Run dynamic graph tests (mutation, incremental SSSP)\n"
+              << "  --layout          Run graph layout tests (vertex reordering, ...)\n"
               << "  --all             Run all test suites (default)\n\n"
               << "Additional Options:\n"
               << "  --quick           Run quick subset of tests\n"
@@ -101,6 +106,7 @@ int main(int argc, char* argv[]) {
     // Parse command line arguments
     bool run_all = true;
     bool run_core = false, run_comprehensive = false, run_edge_cases = false, run_performance = false, run_large_scale = false;
+    bool run_generators = false, run_queries = false, run_speedups = false, run_dynamic = false, run_layout = false;
     bool quick_mode = false, detailed_mode = false;
     
     for (int i = 1; i < argc; i++) {
@@ -118,6 +124,16 @@ int main(int argc, char* argv[]) {
             run_performance = true; run_all = false;
         } else if (arg == "--large-scale") {
             run_large_scale = true; run_all = false;
+        } else if (arg == "--generators") {
+            run_generators = true; run_all = false;
+        } else if (arg == "--queries") {
+            run_queries = true; run_all = false;
+        } else if (arg == "--speedups") {
+            run_speedups = true; run_all = false;
+        } else if (arg == "--dynamic") {
+            run_dynamic = true; run_all = false;
+        } else if (arg == "--layout") {
+            run_layout = true; run_all = false;
         } else if (arg == "--all") {
             run_all = true;
         } else if (arg == "--quick") {
@@ -178,6 +194,31 @@ int main(int argc, char* argv[]) {
         results.emplace_back("Large Scale Tests", result);
     }
     
+    if (run_all || run_generators) {
+        int result = runTestSuite("Graph Generator Tests", "test_graph_generators");
+        results.emplace_back("Graph Generators", result);
+    }
+    
+    if (run_all || run_queries) {
+        int result = runTestSuite("Query Engine Tests", "test_query_engines");
+        results.emplace_back("Query Engines", result);
+    }
+    
+    if (run_all || run_speedups) {
+        int result = runTestSuite("Speed-up Technique Tests", "test_speedup_techniques");
+        results.emplace_back("Speed-up Techniques", result);
+    }
+    
+    if (run_all || run_dynamic) {
+        int result = runTestSuite("Dynamic Graph Tests", "test_dynamic_graphs");
+        results.emplace_back("Dynamic Graphs", result);
+    }
+    
+    if (run_all || run_layout) {
+        int result = runTestSuite("Graph Layout Tests", "test_graph_layout");
+        results.emplace_back("Graph Layout", result);
+    }
+    
     // Print final summary
     printSummary(results);
     
@@ -39,13 +39,6 @@ private:
     BMSSPTestFramework framework;
     std::vector<BenchmarkResult> results;
     
-    // Memory tracking
-    size_t getCurrentMemoryUsage() {
-        // Simple memory tracking - in a real implementation you might use more sophisticated methods
-        // For now, return 0 as placeholder
-        return 0;
-    }
-    
     // Calculate statistics for multiple trials
     struct TrialStatistics {
         double mean_time_ms;
@@ -204,9 +197,6 @@ private:
             auto test_case = framework.generateTestCase(params);
             std::cout << " Done. " << std::flush;
             
-            // Measure memory usage
-            result.memory_usage_kb = getCurrentMemoryUsage();
-            
             // Test BMSSP
             std::cout << "BMSSP..." << std::flush;
             auto bmssp_start = std::chrono::high_resolution_clock::now();
@@ -217,6 +207,7 @@ private:
             result.bmssp_success = bmssp_output.execution_success;
             result.bmssp_completed_vertices = bmssp_output.completed_vertices.size();
             result.bmssp_new_bound = bmssp_output.new_bound;
+            result.memory_usage_kb = bmssp_output.memory_peak_kb;   // peak of the BMSSP run
             std::cout << " Done. " << std::flush;
             
             if (!bmssp_output.execution_success) {
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
+#include <limits>
 #include "Graph.h"
 #include "Dijkstra.h"
 #include "BMSSP.h"
@@ -112,7 +113,7 @@ void testFindPivotBasics() {
     graph.calcT();
     
     // Test FindPivot
-    std::unordered_set<int> S = {0};
+    TrackedUnorderedSet<int> S = {0};
     std::vector<double> d_hat = {0.0, 1.0, 1.0, 2.0, 2.0};
     double B = 5.0;
     
@@ -20,7 +20,7 @@
  * - Algorithm-specific edge cases
  */
 
-void printSet(const std::unordered_set<int>& s, const std::string& name) {
+void printSet(const TrackedUnorderedSet<int>& s, const std::string& name) {
     std::cout << name << " (size=" << s.size() << "): {";
     bool first = true;
     for (int elem : s) {
@@ -282,7 +282,7 @@ void testFindPivotEdgeCases() {
         graph.calcK();
         graph.calcT();
         
-        std::unordered_set<int> empty_S;
+        TrackedUnorderedSet<int> empty_S;
         std::vector<double> d_hat(5, std::numeric_limits<double>::max());
         double B = 10.0;
         
@@ -306,7 +306,7 @@ void testFindPivotEdgeCases() {
         graph.calcK();
         graph.calcT();
         
-        std::unordered_set<int> S = {0}; // Isolated vertex
+        TrackedUnorderedSet<int> S = {0}; // Isolated vertex
         std::vector<double> d_hat(5, std::numeric_limits<double>::max());
         d_hat[0] = 0.0;
         double B = 10.0;
@@ -332,7 +332,7 @@ void testFindPivotEdgeCases() {
         graph.calcK();
         graph.calcT();
         
-        std::unordered_set<int> S = {0};
+        TrackedUnorderedSet<int> S = {0};
         std::vector<double> d_hat(10);
         for (int i = 0; i < 10; i++) {
             d_hat[i] = static_cast<double>(i);
@@ -361,7 +361,7 @@ void testFindPivotEdgeCases() {
         graph.calcK();
         graph.calcT();
         
-        std::unordered_set<int> S = {0};
+        TrackedUnorderedSet<int> S = {0};
         std::vector<double> d_hat(15);
         d_hat[0] = 0.0;
         for (int i = 1; i < 15; i++) {
@@ -0,0 +1,473 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <chrono>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "GraphGenerators.h"
+#include "Parallel.h"
+#include "BMSSPTestFramework.h"
+#include "Debug.h"
+
+/**
+ * Large-Scale Graph Generator Tests
+ * Validates the parallel CSR generators:
+ * - CSR structure (offsets monotone, targets in range, rows sorted)
+ * - Seed determinism independent of thread count
+ * - Symmetry of the geometric and road-like generators
+ * - Integration with BMSSPTestFramework graph types
+ * - Binary graph files and conversion back from Graph
+ */
+
+void checkCSR(const GeneratedGraph& g) {
+    assert(g.offsets.size() == static_cast<size_t>(g.num_vertices) + 1);
+    assert(g.offsets.front() == 0);
+    assert(g.targets.size() == static_cast<size_t>(g.getNumEdges()));
+    assert(g.weights.size() == g.targets.size());
+    for (int v = 0; v < g.num_vertices; ++v) {
+        assert(g.offsets[v] <= g.offsets[v + 1]);
+        for (int64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+            assert(g.targets[e] >= 0 && g.targets[e] < g.num_vertices);
+            assert(g.weights[e] > 0.0);
+            if (e > g.offsets[v]) assert(g.targets[e - 1] <= g.targets[e]);
+        }
+    }
+}
+
+bool sameGraph(const GeneratedGraph& a, const GeneratedGraph& b) {
+    return a.num_vertices == b.num_vertices && a.offsets == b.offsets &&
+           a.targets == b.targets && a.weights == b.weights && a.x == b.x && a.y == b.y;
+}
+
+bool hasEdge(const GeneratedGraph& g, int u, int v, double& weight) {
+    for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+        if (g.targets[e] == v) {
+            weight = g.weights[e];
+            return true;
+        }
+    }
+    return false;
+}
+
+void checkSymmetric(const GeneratedGraph& g) {
+    for (int u = 0; u < g.num_vertices; ++u) {
+        for (int64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            double back = 0.0;
+            assert(hasEdge(g, g.targets[e], u, back));
+            assert(back == g.weights[e]);
+        }
+    }
+}
+
+void testRMAT() {
+    std::cout << "=== Testing R-MAT Generator ===" << std::endl;
+
+    GeneratedGraph g = generateRMAT(1000, 8000, 42);
+    checkCSR(g);
+    assert(g.num_vertices == 1000);
+    assert(g.getNumEdges() == 8000);
+    assert(!g.hasCoordinates());
+    std::cout << "✓ R-MAT CSR structure valid (non power-of-two n)" << std::endl;
+
+    // Power-law: the heaviest vertex should dominate the average degree
+    int64_t max_degree = 0;
+    for (int v = 0; v < g.num_vertices; ++v) {
+        max_degree = std::max(max_degree, g.offsets[v + 1] - g.offsets[v]);
+    }
+    assert(max_degree > 5 * (g.getNumEdges() / g.num_vertices));
+    std::cout << "✓ Skewed degree distribution (max degree " << max_degree << ")" << std::endl;
+
+    RMATParams dedup;
+    dedup.remove_duplicate_edges = true;
+    GeneratedGraph unique = generateRMAT(1000, 8000, 42, dedup);
+    checkCSR(unique);
+    assert(unique.getNumEdges() <= g.getNumEdges());
+    for (int v = 0; v < unique.num_vertices; ++v) {
+        for (int64_t e = unique.offsets[v] + 1; e < unique.offsets[v + 1]; ++e) {
+            assert(unique.targets[e - 1] < unique.targets[e]);
+        }
+    }
+    std::cout << "✓ Duplicate removal keeps " << unique.getNumEdges() << " unique edges" << std::endl;
+
+    GeneratedGraph kron = generateKronecker(10, 16, 7);
+    checkCSR(kron);
+    assert(kron.num_vertices == 1024);
+    assert(kron.getNumEdges() == 16 * 1024);
+    std::cout << "✓ Kronecker generator produces 2^scale vertices" << std::endl;
+}
+
+void testGeometricAndRoad() {
+    std::cout << "\n=== Testing Geometric and Road Generators ===" << std::endl;
+
+    GeneratedGraph geo = generateRandomGeometric(2000, 0.04, 11);
+    checkCSR(geo);
+    checkSymmetric(geo);
+    assert(geo.hasCoordinates());
+    assert(geo.getNumEdges() > 0);
+    std::cout << "✓ Random geometric graph symmetric with " << geo.getNumEdges() << " edges" << std::endl;
+
+    for (double radius : {-0.3, 0.0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()}) {
+        bool threw = false;
+        try {
+            generateRandomGeometric(100, radius, 11);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "✓ Zero, negative and non-finite radii rejected" << std::endl;
+
+    GeneratedGraph road = generateRoadGrid(40, 50, 5);
+    checkCSR(road);
+    checkSymmetric(road);
+    assert(road.num_vertices == 2000);
+    assert(road.hasCoordinates());
+    for (int v = 0; v < road.num_vertices; ++v) {
+        assert(road.offsets[v + 1] - road.offsets[v] <= 8);
+    }
+    std::cout << "✓ Road grid symmetric with " << road.getNumEdges() << " edges" << std::endl;
+
+    // Highways keep every row/column multiple of the spacing intact
+    RoadGridParams params;
+    params.drop_probability = 1.0;
+    params.diagonal_probability = 0.0;
+    params.highway_spacing = 4;
+    GeneratedGraph skeleton = generateRoadGrid(9, 9, 5, params);
+    double w = 0.0;
+    assert(hasEdge(skeleton, 0, 1, w));
+    assert(hasEdge(skeleton, 0, 9, w));
+    assert(!hasEdge(skeleton, 10, 11, w));
+    std::cout << "✓ Highway skeleton survives full street drop" << std::endl;
+}
+
+void testDeterminism() {
+    std::cout << "\n=== Testing Seed Determinism ===" << std::endl;
+
+    int original_threads = getParallelThreads();
+
+    setParallelThreads(1);
+    GeneratedGraph rmat1 = generateRMAT(1 << 14, 1 << 17, 99);
+    GeneratedGraph geo1 = generateRandomGeometric(1 << 13, 0.02, 99);
+    GeneratedGraph road1 = generateRoadGrid(64, 64, 99);
+
+    setParallelThreads(4);
+    GeneratedGraph rmat4 = generateRMAT(1 << 14, 1 << 17, 99);
+    GeneratedGraph geo4 = generateRandomGeometric(1 << 13, 0.02, 99);
+    GeneratedGraph road4 = generateRoadGrid(64, 64, 99);
+
+    setParallelThreads(original_threads);
+
+    assert(sameGraph(rmat1, rmat4));
+    assert(sameGraph(geo1, geo4));
+    assert(sameGraph(road1, road4));
+    std::cout << "✓ Identical output with 1 and 4 threads" << std::endl;
+
+    GeneratedGraph other = generateRMAT(1 << 14, 1 << 17, 100);
+    assert(!sameGraph(rmat1, other));
+    std::cout << "✓ Different seeds give different graphs" << std::endl;
+}
+
+void testParallelRuntime() {
+    std::cout << "\n=== Testing Parallel Runtime ===" << std::endl;
+
+    int original_threads = getParallelThreads();
+    setParallelThreads(4);
+
+    // Every index exactly once, on a pool that is reused across calls
+    std::vector<std::atomic<int>> visits(1 << 16);
+    for (auto& visit : visits) visit.store(0);
+    std::set<std::thread::id> pool_threads;
+    std::mutex ids_mutex;
+    uint64_t pools_before = 0;
+    for (int round = 0; round < 5; ++round) {
+        parallelFor(0, visits.size(), 64, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) visits[i].fetch_add(1);
+            std::lock_guard<std::mutex> lock(ids_mutex);
+            pool_threads.insert(std::this_thread::get_id());
+        });
+        if (round == 0) pools_before = getParallelRuntimeStats().pools;
+    }
+    for (auto& visit : visits) assert(visit.load() == 5);
+    ParallelRuntimeStats stats = getParallelRuntimeStats();
+    assert(stats.pools == pools_before && stats.threads == 4 && stats.workers == 3);
+    assert(pool_threads.size() <= 4);
+    std::cout << "✓ " << pool_threads.size() << " threads served 5 loops from one pool of "
+              << stats.workers << " workers" << std::endl;
+
+    // Nested loops share the same threads and still cover every (outer, inner) pair
+    std::vector<std::atomic<long long>> sums(16);
+    for (auto& sum : sums) sum.store(0);
+    parallelFor(0, sums.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t outer = lo; outer < hi; ++outer) {
+            parallelFor(0, 1000, 10, [&](size_t inner_lo, size_t inner_hi) {
+                long long local = 0;
+                for (size_t inner = inner_lo; inner < inner_hi; ++inner) local += static_cast<long long>(inner);
+                sums[outer].fetch_add(local);
+            });
+        }
+    });
+    for (auto& sum : sums) assert(sum.load() == 999 * 1000 / 2);
+    assert(getParallelRuntimeStats().workers == 3);
+    std::cout << "✓ Nested parallelFor without extra threads" << std::endl;
+
+    bool caught = false;
+    try {
+        parallelFor(0, 8, 1, [&](size_t lo, size_t) {
+            parallelFor(0, 100, 1, [&](size_t inner, size_t) {
+                if (lo == 5 && inner == 42) throw std::runtime_error("inner failure");
+            });
+        });
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "inner failure";
+    }
+    assert(caught);
+
+    TaskGroup group;
+    int left = 0, right = 0;
+    group.run([&]() { left = 1; });
+    group.run([&]() { right = 2; });
+    group.wait();
+    assert(left == 1 && right == 2);
+    group.run([]() { throw std::invalid_argument("task failure"); });
+    caught = false;
+    try {
+        group.wait();
+    } catch (const std::invalid_argument&) {
+        caught = true;
+    }
+    assert(caught);
+    std::cout << "✓ Exceptions propagate out of nested loops and task groups" << std::endl;
+
+    auto promise = std::make_shared<std::promise<int>>();
+    std::future<int> spawned = promise->get_future();
+    parallelSpawn([promise]() { promise->set_value(7); });
+    assert(spawned.get() == 7);
+
+    setParallelAffinity(true);
+    for (auto& visit : visits) visit.store(0);
+    parallelFor(0, visits.size(), 256, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) visits[i].fetch_add(1);
+    });
+    for (auto& visit : visits) assert(visit.load() == 1);
+    assert(getParallelRuntimeStats().workers == 3);
+    setParallelAffinity(false);
+    std::cout << "✓ Background tasks and pinned workers" << std::endl;
+
+    // Test-case generation fans out over the runtime but depends only on the framework seed
+    std::vector<TestParameters> suite;
+    for (GraphType type : {GraphType::RANDOM_SPARSE, GraphType::GRID_2D, GraphType::RMAT, GraphType::ROAD_GRID}) {
+        TestParameters params;
+        params.num_vertices = 900;
+        params.num_edges = 4000;
+        params.graph_type = type;
+        params.weight_dist = WeightDistribution::UNIFORM;
+        params.source_method = SourceGenMethod::RANDOM;
+        params.source_count = 3;
+        params.bound_type = BoundType::INFINITE;
+        params.k_param = 2;
+        params.t_param = 2;
+        params.test_name = "parallel generation";
+        suite.push_back(params);
+    }
+    std::vector<BMSSPTestCase> serial, parallel;
+    setParallelThreads(1);
+    serial = BMSSPTestFramework(77).generateTestCases(suite);
+    setParallelThreads(4);
+    parallel = BMSSPTestFramework(77).generateTestCases(suite);
+    setParallelThreads(original_threads);
+
+    assert(serial.size() == suite.size() && parallel.size() == suite.size());
+    for (size_t i = 0; i < suite.size(); ++i) {
+        const Graph& a = serial[i].graph;
+        const Graph& b = parallel[i].graph;
+        assert(a.getNumVertices() == b.getNumVertices() && a.getNumEdges() == b.getNumEdges());
+        assert(serial[i].sources == parallel[i].sources);
+        for (int u = 0; u < a.getNumVertices(); ++u) {
+            const std::vector<Edge>& x = a.neighbors(u);
+            const std::vector<Edge>& y = b.neighbors(u);
+            assert(x.size() == y.size());
+            for (size_t e = 0; e < x.size(); ++e) assert(x[e].dest == y[e].dest && x[e].weight == y[e].weight);
+        }
+    }
+    std::cout << "✓ generateTestCases identical with 1 and 4 threads" << std::endl;
+}
+
+void testGraphConversion() {
+    std::cout << "\n=== Testing Conversion and Framework Integration ===" << std::endl;
+
+    GeneratedGraph road = generateRoadGrid(20, 20, 3);
+    Graph graph = road.toGraph();
+    assert(graph.getNumVertices() == road.num_vertices);
+    for (int v = 0; v < road.num_vertices; ++v) {
+        auto edges = graph.getConnections(v);
+        assert(static_cast<int64_t>(edges.size()) == road.offsets[v + 1] - road.offsets[v]);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            assert(edges[i].dest == road.targets[road.offsets[v] + i]);
+            assert(edges[i].weight == road.weights[road.offsets[v] + i]);
+        }
+    }
+    std::cout << "✓ toGraph preserves adjacency" << std::endl;
+
+    BMSSPTestFramework framework(1234);
+    for (GraphType type : {GraphType::RMAT, GraphType::RANDOM_GEOMETRIC, GraphType::ROAD_GRID}) {
+        TestParameters params;
+        params.num_vertices = 400;
+        params.num_edges = 2400;
+        params.graph_type = type;
+        params.weight_dist = WeightDistribution::UNIFORM;
+        params.source_method = SourceGenMethod::SINGLE_SOURCE;
+        params.source_count = 1;
+        params.bound_type = BoundType::INFINITE;
+        params.k_param = 2;
+        params.t_param = 2;
+        params.test_name = "generator integration";
+
+        BMSSPTestCase test_case = framework.generateTestCase(params);
+        assert(test_case.graph.getNumVertices() == 400);
+
+        // Only RMAT follows weight_dist; the geometric types keep their lengths
+        params.weight_dist = WeightDistribution::UNIT_WEIGHTS;
+        Graph unit = framework.generateTestCase(params).graph;
+        bool all_unit = true;
+        for (int v = 0; v < unit.getNumVertices(); ++v) {
+            for (const auto& edge : unit.getConnections(v)) all_unit = all_unit && edge.weight == 1.0;
+        }
+        assert(all_unit == (type == GraphType::RMAT));
+    }
+    std::cout << "✓ RMAT / RANDOM_GEOMETRIC / ROAD_GRID available as GraphType; RMAT honours weight_dist" << std::endl;
+}
+
+void testGraphFiles() {
+    std::cout << "\n=== Testing Graph Files ===" << std::endl;
+
+    std::string path = "test_graph_generators_graph.bin";
+    GeneratedGraph road = generateRoadGrid(25, 30, 9);
+    road.save(path);
+    GeneratedGraph loaded = GeneratedGraph::load(path);
+    assert(sameGraph(road, loaded) && loaded.hasCoordinates());
+
+    GeneratedGraph rmat = generateRMAT(1000, 6000, 4);
+    rmat.save(path);
+    loaded = GeneratedGraph::load(path);
+    assert(sameGraph(rmat, loaded) && !loaded.hasCoordinates());
+    std::cout << "✓ Save/load round trip, with and without coordinates" << std::endl;
+
+    // fromGraph restores the sorted CSR; it drops coordinates
+    GeneratedGraph back = GeneratedGraph::fromGraph(rmat.toGraph());
+    checkCSR(back);
+    assert(back.offsets == rmat.offsets && back.targets == rmat.targets && back.weights == rmat.weights);
+    std::cout << "✓ fromGraph inverts toGraph" << std::endl;
+
+    auto rejects = [](const std::string& file) {
+        try {
+            GeneratedGraph::load(file);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated.write(bytes.data(), bytes.size() / 2);
+    }
+    assert(rejects(path));
+    {
+        std::ofstream foreign(path, std::ios::binary | std::ios::trunc);
+        foreign << "not a graph file";
+    }
+    assert(rejects(path));
+
+    // Hostile headers and weights. Layout: magic, version, n at byte 8, m at 12, coordinates
+    // flag, then offsets from byte 21, targets and weights.
+    GeneratedGraph small = generateRMAT(50, 200, 4);
+    int64_t m = small.getNumEdges();
+    size_t offsets_at = 21;
+    size_t weights_at = offsets_at + sizeof(int64_t) * (small.num_vertices + 1) + sizeof(int) * m;
+    auto patched = [&](size_t at, const void* value, size_t bytes) {
+        small.save(path);
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(at);
+        file.write(static_cast<const char*>(value), bytes);
+        file.close();
+        return rejects(path);
+    };
+    small.save(path);
+    assert(!rejects(path));
+    int32_t huge_n = 1 << 30;
+    assert(patched(8, &huge_n, sizeof(huge_n)));
+    {
+        // m and offsets[n] agree, so only the size check stops the allocation
+        int64_t huge_m = int64_t(1) << 40;
+        small.save(path);
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(12);
+        file.write(reinterpret_cast<const char*>(&huge_m), sizeof(huge_m));
+        file.seekp(offsets_at + sizeof(int64_t) * small.num_vertices);
+        file.write(reinterpret_cast<const char*>(&huge_m), sizeof(huge_m));
+        file.close();
+        assert(rejects(path));
+    }
+    for (double bad : {-1.0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()}) {
+        assert(patched(weights_at + sizeof(double) * (m / 2), &bad, sizeof(bad)));
+    }
+
+    std::remove(path.c_str());
+    assert(rejects(path));
+    std::cout << "✓ Truncated, foreign and missing files rejected, as are oversized counts and bad weights" << std::endl;
+}
+
+void testLargeScale(bool enabled) {
+    if (!enabled) return;
+    std::cout << "\n=== Large Scale Generation ===" << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    GeneratedGraph kron = generateKronecker(20, 16, 1);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Kronecker scale 20: " << kron.getNumEdges() << " edges in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    GeneratedGraph road = generateRoadGrid(1000, 1000, 1);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Road grid 1000x1000: " << road.getNumEdges() << " edges in "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Graph Generator Test Suite ===" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+
+    initializeDebug(argc, argv);
+    bool large = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--large") large = true;
+    }
+
+    try {
+        testRMAT();
+        testGeometricAndRoad();
+        testDeterminism();
+        testParallelRuntime();
+        testGraphConversion();
+        testGraphFiles();
+        testLargeScale(large);
+
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "🎉 All graph generator tests PASSED!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,672 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include "Graph.h"
+#include "GraphGenerators.h"
+#include "BMSSPTestFramework.h"
+#include "Dijkstra.h"
+#include "BMSSP.h"
+#include "FindPivot.h"
+#include "CSRGraph.h"
+#include "CompressedGraph.h"
+#include "BatchHeap.h"
+#include "MemoryTracker.h"
+#include "SearchWorkspace.h"
+#include "RelaxKernel.h"
+#include "Reorder.h"
+#include "Debug.h"
+
+/**
+ * Graph Layout Test Suite
+ * Vertex relabeling and storage layouts, verified against the original graph and
+ * BMSSPTestFramework::runReferenceDijkstra:
+ * - reorder() permutations (BFS, RCM, degree, Hilbert) and mapping results back
+ * - CSRGraph<float | uint32_t | double> storage and the algorithms templated on it
+ * - SIMD relaxation kernel on every supported instruction set vs the scalar path
+ * - CompressedGraph gap/varint encoding, weight quantization and the algorithms on it
+ * - memoryUsage() of every storage type, BatchHeap and workspaces; tracked allocation peaks
+ */
+
+const double INF = std::numeric_limits<double>::max();
+
+bool closeEnough(double a, double b) {
+    if (a == INF || b == INF) return a == b;
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+const char* strategyName(ReorderStrategy strategy) {
+    switch (strategy) {
+        case ReorderStrategy::BFS: return "BFS";
+        case ReorderStrategy::RCM: return "RCM";
+        case ReorderStrategy::DEGREE: return "degree";
+        default: return "Hilbert";
+    }
+}
+
+// Same graph under uniformly random labels, like user input with arbitrary ids
+Graph scramble(const Graph& graph, uint64_t seed, std::vector<int>& permutation) {
+    int n = graph.getNumVertices();
+    permutation.resize(n);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::mt19937_64 rng(seed);
+    std::shuffle(permutation.begin(), permutation.end(), rng);
+
+    std::vector<std::vector<Edge>> adjacency(n);
+    for (int u = 0; u < n; ++u) {
+        for (const auto& edge : graph.neighbors(u)) {
+            adjacency[permutation[u]].push_back(Edge{permutation[edge.dest], edge.weight});
+        }
+    }
+    return Graph(n, std::move(adjacency));
+}
+
+void verifyReordering(const Graph& original, const ReorderResult& result, BMSSPTestFramework& framework) {
+    int n = original.getNumVertices();
+    assert(result.graph.getNumVertices() == n);
+    assert(result.graph.getNumEdges() == original.getNumEdges());
+
+    std::vector<char> seen(n, 0);
+    for (int v = 0; v < n; ++v) {
+        int mapped = result.toNew(v);
+        assert(mapped >= 0 && mapped < n && !seen[mapped]);
+        seen[mapped] = 1;
+        assert(result.toOld(mapped) == v);
+    }
+    for (int v = 0; v < n; ++v) {
+        const std::vector<Edge>& edges = result.graph.neighbors(v);
+        for (size_t i = 1; i < edges.size(); ++i) assert(edges[i - 1].dest <= edges[i].dest);
+    }
+
+    for (int source : {0, n / 2, n - 1}) {
+        std::vector<double> reference = framework.runReferenceDijkstra(original, {source});
+        DijkstraResults reordered = runDijkstra(result.graph, result.toNew(source));
+        std::vector<double> distances = result.mapBack(reordered.distances);
+        std::vector<int> predecessors = result.mapPredecessorsBack(reordered.predecessors);
+        for (int v = 0; v < n; ++v) {
+            assert(closeEnough(distances[v], reference[v]));
+            if (v == source || distances[v] == INF) continue;
+            bool tight = false;
+            for (const auto& edge : original.neighbors(predecessors[v])) {
+                if (edge.dest == v && closeEnough(distances[predecessors[v]] + edge.weight, distances[v])) tight = true;
+            }
+            assert(tight);
+        }
+    }
+}
+
+void testReorderStrategies() {
+    std::cout << "=== Testing Reorder Strategies ===" << std::endl;
+
+    BMSSPTestFramework framework(35);
+    GeneratedGraph road = generateRoadGrid(40, 40, 35);
+    Graph road_graph = road.toGraph();
+    Graph rmat = generateRMAT(1500, 9000, 35).toGraph();
+
+    for (ReorderStrategy strategy : {ReorderStrategy::BFS, ReorderStrategy::RCM, ReorderStrategy::DEGREE,
+                                     ReorderStrategy::HILBERT}) {
+        verifyReordering(road_graph, reorder(road, strategy), framework);
+        if (strategy != ReorderStrategy::HILBERT) verifyReordering(rmat, reorder(rmat, strategy), framework);
+        std::cout << "✓ " << strategyName(strategy) << ": valid permutation, distances and paths map back" << std::endl;
+    }
+
+    // Degree order puts the hubs first
+    ReorderResult by_degree = reorder(rmat, ReorderStrategy::DEGREE);
+    int hub = by_degree.toOld(0);
+    int leaf = by_degree.toOld(rmat.getNumVertices() - 1);
+    assert(rmat.neighbors(hub).size() >= rmat.neighbors(leaf).size());
+    std::cout << "✓ Degree order starts at a hub with " << rmat.neighbors(hub).size() << " out-edges" << std::endl;
+}
+
+void testBandwidthRecovery() {
+    std::cout << "\n=== Testing Bandwidth Recovery ===" << std::endl;
+
+    const int rows = 60, cols = 60;
+    GeneratedGraph road = generateRoadGrid(rows, cols, 11);
+    Graph grid = road.toGraph();
+    std::vector<int> identity(grid.getNumVertices());
+    std::iota(identity.begin(), identity.end(), 0);
+
+    std::vector<int> labels;
+    Graph scrambled = scramble(grid, 11, labels);
+    int scrambled_bandwidth = permutedBandwidth(scrambled, identity);
+    ReorderResult rcm = reorder(scrambled, ReorderStrategy::RCM);
+    int rcm_bandwidth = permutedBandwidth(scrambled, rcm.permutation);
+    assert(rcm_bandwidth == permutedBandwidth(rcm.graph, identity));
+    assert(rcm_bandwidth <= 3 * cols);
+    assert(rcm_bandwidth * 10 < scrambled_bandwidth);
+    std::cout << "✓ RCM bandwidth " << rcm_bandwidth << " vs " << scrambled_bandwidth
+              << " scrambled (row-major grid: " << permutedBandwidth(grid, identity) << ")" << std::endl;
+
+    // Hilbert order keeps edges short on the plane: most neighbours land within a few cache lines
+    ReorderResult hilbert = reorder(road, ReorderStrategy::HILBERT);
+    size_t edges = 0, near = 0;
+    for (int u = 0; u < hilbert.graph.getNumVertices(); ++u) {
+        for (const auto& edge : hilbert.graph.neighbors(u)) {
+            edges++;
+            if (std::abs(edge.dest - u) < 64) near++;
+        }
+    }
+    assert(near * 10 > edges * 7);
+    std::cout << "✓ Hilbert order: " << 100 * near / edges << "% of edges span fewer than 64 ids" << std::endl;
+}
+
+void testReorderEdgeCases() {
+    std::cout << "\n=== Testing Reorder Edge Cases ===" << std::endl;
+
+    Graph plain(4);
+    plain.addEdge(0, 1, 1.0);
+    bool threw = false;
+    try { reorder(plain, ReorderStrategy::HILBERT); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { reorder(plain, ReorderStrategy::HILBERT, {0.0, 1.0}, {0.0, 1.0}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "✓ Hilbert order without coordinates rejected" << std::endl;
+
+    Graph empty(0);
+    assert(reorder(empty, ReorderStrategy::RCM).graph.getNumVertices() == 0);
+    assert(reorder(empty, ReorderStrategy::HILBERT, {}, {}).permutation.empty());
+
+    // Isolated vertices, a self-loop, tombstones, a removed vertex and reverse edges
+    Graph graph(6);
+    graph.addEdge(0, 1, 1.0);
+    graph.addEdge(1, 1, 4.0);
+    EdgeHandle gone = graph.addEdge(1, 2, 2.0);
+    graph.addEdge(2, 3, 1.0);
+    graph.addEdge(3, 5, 1.0);
+    graph.removeEdge(gone);
+    graph.removeVertex(5);
+    graph.enableReverseEdges();
+    for (ReorderStrategy strategy : {ReorderStrategy::BFS, ReorderStrategy::RCM, ReorderStrategy::DEGREE}) {
+        ReorderResult result = reorder(graph, strategy);
+        assert(result.graph.getNumEdges() == 3 && result.graph.getNumTombstones() == 0);
+        assert(result.graph.isVertexRemoved(result.toNew(5)));
+        assert(result.graph.hasReverseEdges());
+        assert(result.graph.getEdgeWeight(result.toNew(1), result.toNew(1)) == 4.0);
+        assert(result.graph.getEdgeWeight(result.toNew(1), result.toNew(2)) == INF);
+        assert(result.graph.reverseNeighbors(result.toNew(3)).size() == 1);
+    }
+    std::cout << "✓ Empty graphs, self-loops, tombstones, removed vertices and reverse edges handled" << std::endl;
+}
+
+// Copy of graph with every weight passed through convert, to build exact references
+template <typename Convert>
+Graph convertedWeights(const Graph& graph, Convert convert) {
+    int n = graph.getNumVertices();
+    std::vector<std::vector<Edge>> adjacency(n);
+    for (int u = 0; u < n; ++u) {
+        for (const auto& edge : graph.neighbors(u)) {
+            if (!edge.isRemoved()) adjacency[u].push_back(Edge{edge.dest, convert(edge.weight)});
+        }
+    }
+    return Graph(n, std::move(adjacency));
+}
+
+template <typename GraphT>
+BMSSPResult runTopLevelBMSSP(const GraphT& graph, int source, std::vector<double>& distances) {
+    int n = graph.getNumVertices();
+    int t = std::max(2, graph.getT());
+    int level = std::max(1, static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::log(static_cast<double>(t)))));
+    distances.assign(n, INF);
+    std::vector<int> predecessors(n, -1);
+    distances[source] = 0.0;
+    // BatchHeap stores its bound as int, so a large finite B stands in for B = infinity
+    return runBMSSP(graph, distances, predecessors, level, 1e9, {source});
+}
+
+void testCSRStorage() {
+    std::cout << "\n=== Testing CSR Storage ===" << std::endl;
+
+    Graph graph(4);
+    graph.addEdge(0, 1, 1.25);
+    EdgeHandle gone = graph.addEdge(0, 2, 9.0);
+    graph.addEdge(0, 3, 2.5);
+    graph.addEdge(2, 1, 0.1);
+    graph.removeEdge(gone);
+
+    FloatGraph floats = FloatGraph::fromGraph(graph);
+    assert(floats.getNumVertices() == 4 && floats.getNumEdges() == 3);
+    assert((floats.getOffsets() == std::vector<int64_t>{0, 2, 2, 3, 3}));
+    assert((floats.getTargets() == std::vector<int>{1, 3, 1}));
+    assert(floats.getWeights()[2] == 0.1f);
+    size_t count = 0;
+    for (const auto& edge : floats.neighbors(0)) {
+        assert(edge.dest == (count == 0 ? 1 : 3));
+        count++;
+    }
+    assert(count == 2 && floats.neighbors(1).empty());
+    assert(floats.getK() == graph.getK() && floats.getT() == graph.getT());
+
+    UInt32Graph integers = UInt32Graph::fromGraph(graph, 100.0);
+    assert((integers.getWeights() == std::vector<uint32_t>{125, 250, 10}));
+    assert(integers.getWeightScale() == 100.0);
+
+    DoubleGraph doubles = DoubleGraph::fromGraph(graph);
+    assert(sizeof(Edge) == 16);
+    assert(floats.edgeBytes() == 3 * 8 && integers.edgeBytes() == 3 * 8 && doubles.edgeBytes() == 3 * 12);
+    std::cout << "✓ SoA layout: 8 bytes per edge with float/uint32 weights vs " << sizeof(Edge) << " for Edge" << std::endl;
+
+    Graph negative(2);
+    negative.addEdge(0, 1, -1.0);
+    bool threw = false;
+    try { UInt32Graph::fromGraph(negative); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { UInt32Graph::fromGraph(graph, 1e10); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "✓ Integer weights that do not fit are rejected" << std::endl;
+
+    GeneratedGraph generated = generateRoadGrid(20, 20, 36);
+    FloatGraph adopted = FloatGraph::fromGenerated(generated);
+    assert(adopted.getNumEdges() == generated.getNumEdges() && adopted.getOffsets() == generated.offsets);
+    std::cout << "✓ Generator output adopted without rebuilding the structure" << std::endl;
+}
+
+void testCSRAlgorithms() {
+    std::cout << "\n=== Testing Algorithms on CSR Storage ===" << std::endl;
+
+    for (int round = 0; round < 2; ++round) {
+        Graph graph = round == 0 ? generateRoadGrid(40, 40, 36).toGraph() : generateRMAT(2000, 12000, 36).toGraph();
+        int n = graph.getNumVertices();
+        Graph as_float = convertedWeights(graph, [](double w) { return static_cast<double>(static_cast<float>(w)); });
+        Graph as_integer = convertedWeights(graph, [](double w) { return std::round(w * 100.0); });
+        DoubleGraph doubles = DoubleGraph::fromGraph(graph);
+        FloatGraph floats = FloatGraph::fromGraph(graph);
+        UInt32Graph integers = UInt32Graph::fromGraph(graph, 100.0);
+
+        for (int source : {0, n / 2}) {
+            // Same edge order and the same double arithmetic: results are bit-identical
+            DijkstraResults expected = runDijkstra(graph, source);
+            assert(runDijkstra(doubles, source).distances == expected.distances);
+            assert(runDijkstra(doubles, source).predecessors == expected.predecessors);
+            assert(runDijkstra(floats, source).distances == runDijkstra(as_float, source).distances);
+            assert(runDijkstra(integers, source).distances == runDijkstra(as_integer, source).distances);
+
+            std::vector<double> graph_distances, csr_distances;
+            BMSSPResult on_graph = runTopLevelBMSSP(graph, source, graph_distances);
+            BMSSPResult on_csr = runTopLevelBMSSP(doubles, source, csr_distances);
+            assert(csr_distances == graph_distances);
+            assert(on_csr.completed_vertices == on_graph.completed_vertices && on_csr.new_bound == on_graph.new_bound);
+            runTopLevelBMSSP(as_float, source, graph_distances);
+            runTopLevelBMSSP(floats, source, csr_distances);
+            assert(csr_distances == graph_distances);
+            runTopLevelBMSSP(as_integer, source, graph_distances);
+            runTopLevelBMSSP(integers, source, csr_distances);
+            assert(csr_distances == graph_distances);
+
+            std::vector<double> d_graph = expected.distances, d_csr = expected.distances;
+            TrackedUnorderedSet<int> S = {source}, S_csr = {source};
+            FindPivotResult pivots_graph = findPivots(graph, 1e9, S, d_graph);
+            FindPivotResult pivots_csr = findPivots(doubles, 1e9, S_csr, d_csr);
+            assert(pivots_csr.pivots == pivots_graph.pivots && pivots_csr.nearby == pivots_graph.nearby);
+        }
+        std::cout << "✓ " << (round == 0 ? "Road grid" : "R-MAT")
+                  << ": runDijkstra, runBMSSP and findPivots agree across float/uint32/double storage" << std::endl;
+    }
+}
+
+double timeDijkstra(const Graph& graph, const std::vector<int>& sources) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int source : sources) runDijkstra(graph, source);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / sources.size();
+}
+
+template <typename Weight>
+void checkKernel(std::mt19937& rng, SimdLevel level, size_t count, bool allow_equal) {
+    const int n = 64;
+    std::uniform_real_distribution<double> real(0.0, 100.0);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<double> distances(n);
+    for (double& d : distances) d = real(rng) < 10.0 ? INF : std::floor(real(rng) + 20.0);
+    std::vector<int> targets(count);
+    std::vector<Weight> weights(count);
+    for (size_t i = 0; i < count; ++i) {
+        targets[i] = vertex(rng);
+        weights[i] = static_cast<Weight>(std::floor(real(rng)));
+    }
+    if (std::is_same<Weight, uint32_t>::value && count > 3) weights[3] = static_cast<Weight>(3000000000u);
+    double base = 20.0;
+
+    std::vector<double> expected_candidates(count), candidates(count);
+    std::vector<uint32_t> expected_improved(count), improved(count);
+    setSimdLevel(SimdLevel::SCALAR);
+    size_t expected = relaxCandidates(base, targets.data(), weights.data(), count, distances.data(), allow_equal,
+                                      expected_candidates.data(), expected_improved.data());
+    setSimdLevel(level);
+    size_t found = relaxCandidates(base, targets.data(), weights.data(), count, distances.data(), allow_equal,
+                                   candidates.data(), improved.data());
+    assert(found == expected);
+    assert(candidates == expected_candidates);
+    for (size_t i = 0; i < found; ++i) {
+        assert(improved[i] == expected_improved[i]);
+        double current = distances[targets[improved[i]]];
+        assert(candidates[improved[i]] < current || (allow_equal && candidates[improved[i]] == current));
+    }
+}
+
+void testRelaxKernel() {
+    std::cout << "\n=== Testing SIMD Relaxation Kernel ===" << std::endl;
+
+    SimdLevel detected = detectSimdLevel();
+    std::cout << "  CPU supports: " << simdLevelName(detected) << std::endl;
+    std::mt19937 rng(37);
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected) continue;
+        for (size_t count : {0, 1, 3, 4, 7, 8, 9, 15, 16, 31, 100, 1000}) {
+            for (bool allow_equal : {false, true}) {
+                checkKernel<double>(rng, level, count, allow_equal);
+                checkKernel<float>(rng, level, count, allow_equal);
+                checkKernel<uint32_t>(rng, level, count, allow_equal);
+            }
+        }
+        std::cout << "✓ " << simdLevelName(level) << " kernel matches the scalar path for all weight types and tails" << std::endl;
+    }
+
+    // Whole algorithms: every level gives bit-identical results on a power-law graph
+    GeneratedGraph generated = generateRMAT(3000, 40000, 37);
+    FloatGraph floats = FloatGraph::fromGenerated(generated);
+    UInt32Graph integers = UInt32Graph::fromGenerated(generated);
+    setSimdLevel(SimdLevel::SCALAR);
+    DijkstraResults scalar_float = runDijkstra(floats, 0);
+    DijkstraResults scalar_integer = runDijkstra(integers, 0);
+    std::vector<double> scalar_bmssp;
+    BMSSPResult scalar_result = runTopLevelBMSSP(floats, 0, scalar_bmssp);
+    for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected) continue;
+        setSimdLevel(level);
+        DijkstraResults vector_float = runDijkstra(floats, 0);
+        assert(vector_float.distances == scalar_float.distances && vector_float.predecessors == scalar_float.predecessors);
+        assert(runDijkstra(integers, 0).distances == scalar_integer.distances);
+        std::vector<double> vector_bmssp;
+        BMSSPResult vector_result = runTopLevelBMSSP(floats, 0, vector_bmssp);
+        assert(vector_bmssp == scalar_bmssp && vector_result.completed_vertices == scalar_result.completed_vertices);
+        std::cout << "✓ " << simdLevelName(level) << ": runDijkstra and runBMSSP identical to the scalar path" << std::endl;
+    }
+    setSimdLevel(detected);
+    assert(getSimdLevel() == detected);
+}
+
+void testCompressedGraph() {
+    std::cout << "\n=== Testing Compressed Graph ===" << std::endl;
+
+    Graph graph(5);
+    graph.addEdge(2, 4, 3.0);
+    graph.addEdge(2, 0, 1.0);
+    EdgeHandle gone = graph.addEdge(2, 1, 7.0);
+    graph.addEdge(2, 4, 2.0);
+    graph.addEdge(0, 3, 1000000.0);
+    graph.addEdge(4, 1, 0.75);
+    graph.removeEdge(gone);
+
+    CompressedGraph exact = CompressedGraph::fromGraph(graph, 0.25);
+    assert(exact.getNumVertices() == 5 && exact.getNumEdges() == 5);
+    assert(exact.getK() == graph.getK() && exact.getT() == graph.getT());
+    std::vector<std::pair<int, double>> decoded;
+    for (const auto& edge : exact.neighbors(2)) decoded.push_back({edge.dest, edge.weight});
+    // Sorted by target; the first target is below its owner, so its zigzag delta is negative
+    assert((decoded == std::vector<std::pair<int, double>>{{0, 1.0}, {4, 2.0}, {4, 3.0}}));
+    assert(exact.neighbors(1).empty() && exact.neighbors(3).empty());
+    assert((*exact.neighbors(0).begin()).weight == 1000000.0);
+    assert((*exact.neighbors(4).begin()).weight == 0.75);
+    Graph round_trip = exact.toGraph();
+    assert(round_trip.getNumEdges() == 5 && round_trip.getEdgeWeight(0, 3) == 1000000.0);
+    std::cout << "✓ Sorted gap/varint lists decode exactly; tombstones dropped" << std::endl;
+
+    // Quantization error is at most half a quantum per edge
+    CompressedGraph coarse = CompressedGraph::fromGraph(graph, 0.5);
+    assert((*coarse.neighbors(4).begin()).weight == 1.0);
+    GeneratedGraph generated = generateRMAT(4000, 60000, 38);
+    CompressedGraph quantized = CompressedGraph::fromGenerated(generated, 0.01);
+    assert(quantized.getNumEdges() == generated.getNumEdges());
+    for (int u = 0; u < generated.num_vertices; ++u) {
+        int64_t e = generated.offsets[u];
+        for (const auto& edge : quantized.neighbors(u)) {
+            assert(edge.dest == generated.targets[e]);
+            assert(std::fabs(edge.weight - generated.weights[e]) <= 0.005 + 1e-9);
+            ++e;
+        }
+        assert(e == generated.offsets[u + 1]);
+    }
+    FloatGraph floats = FloatGraph::fromGenerated(generated);
+    assert(quantized.edgeBytes() < floats.edgeBytes());
+    std::cout << "✓ R-MAT with quantum 0.01: " << static_cast<double>(quantized.edgeBytes()) / generated.getNumEdges()
+              << " B/edge vs " << static_cast<double>(floats.edgeBytes()) / generated.getNumEdges()
+              << " for CSRGraph<float>" << std::endl;
+
+    bool threw = false;
+    try { CompressedGraph::fromGraph(graph, 0.0); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    Graph negative(2);
+    negative.addEdge(0, 1, -1.0);
+    threw = false;
+    try { CompressedGraph::fromGraph(negative); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    assert(CompressedGraph::fromGraph(Graph(0)).getNumVertices() == 0);
+    std::cout << "✓ Invalid quanta and weights are rejected" << std::endl;
+
+    // Algorithms on the compressed graph match the same quantized weights held in a Graph.
+    // Lists are reordered by target, so only distances are compared.
+    for (int round = 0; round < 2; ++round) {
+        GeneratedGraph source_graph = round == 0 ? generateRoadGrid(40, 40, 38) : generateRMAT(2000, 12000, 38);
+        CompressedGraph compressed = CompressedGraph::fromGenerated(source_graph, 0.125);
+        Graph reference = compressed.toGraph();
+        int n = reference.getNumVertices();
+        for (int source : {0, n / 2}) {
+            assert(runDijkstra(compressed, source).distances == runDijkstra(reference, source).distances);
+            std::vector<double> reference_distances, compressed_distances;
+            runTopLevelBMSSP(reference, source, reference_distances);
+            runTopLevelBMSSP(compressed, source, compressed_distances);
+            assert(compressed_distances == reference_distances);
+
+            std::vector<double> d_reference = runDijkstra(reference, source).distances, d_compressed = d_reference;
+            TrackedUnorderedSet<int> S = {source}, S_compressed = {source};
+            FindPivotResult pivots_reference = findPivots(reference, 1e9, S, d_reference);
+            FindPivotResult pivots_compressed = findPivots(compressed, 1e9, S_compressed, d_compressed);
+            assert(pivots_compressed.pivots == pivots_reference.pivots);
+            assert(pivots_compressed.nearby == pivots_reference.nearby);
+        }
+        std::cout << "✓ " << (round == 0 ? "Road grid" : "R-MAT")
+                  << ": runDijkstra, runBMSSP and findPivots agree with the decoded Graph" << std::endl;
+    }
+}
+
+void testMemoryAccounting() {
+    std::cout << "\n=== Testing Memory Accounting ===" << std::endl;
+
+    GeneratedGraph generated = generateRoadGrid(60, 60, 37);
+    Graph graph = generated.toGraph();
+    size_t edges = graph.getNumEdges();
+    size_t graph_bytes = graph.memoryUsage();
+    assert(graph_bytes >= edges * sizeof(Edge) && graph_bytes < 2 * edges * sizeof(Edge) + 64 * 3600);
+    graph.enableReverseEdges();
+    assert(graph.memoryUsage() >= graph_bytes + edges * (sizeof(Edge) + 2 * sizeof(int)));
+    FloatGraph csr = FloatGraph::fromGraph(graph);
+    CompressedGraph compressed = CompressedGraph::fromGraph(graph);
+    assert(csr.memoryUsage() >= csr.edgeBytes() && compressed.memoryUsage() >= compressed.memoryBytes());
+    assert(compressed.memoryUsage() < csr.memoryUsage() && csr.memoryUsage() < graph_bytes);
+    std::cout << "✓ Graph " << graph_bytes / 1024 << " KB (" << graph.memoryUsage() / 1024
+              << " KB with reverse edges), CSR<float> " << csr.memoryUsage() / 1024 << " KB, compressed "
+              << compressed.memoryUsage() / 1024 << " KB" << std::endl;
+
+    SearchWorkspace workspace(3600);
+    size_t workspace_bytes = workspace.memoryUsage();
+    assert(workspace_bytes >= 3600 * (sizeof(double) + sizeof(int) + 2 * sizeof(uint32_t)));
+
+    // BatchHeap: the estimate grows with the items and its containers are tracked once the
+    // process-wide counts are switched on
+    {
+        BatchHeap untracked(16, 1000000);
+        for (int i = 0; i < 100; ++i) untracked.insert(i, static_cast<double>(i));
+        assert(!MemoryTracker::isEnabled() && MemoryTracker::currentBytes() == 0 && MemoryTracker::peakBytes() == 0);
+    }
+    MemoryTracker::setEnabled(true);
+    int64_t before = MemoryTracker::currentBytes();
+    size_t heap_bytes = 0;
+    {
+        BatchHeap heap(16, 1000000);
+        size_t empty_bytes = heap.memoryUsage();
+        for (int i = 0; i < 1000; ++i) heap.insert(i, static_cast<double>((i * 7919) % 1000));
+        heap_bytes = heap.memoryUsage();
+        assert(heap_bytes > empty_bytes + 1000 * (sizeof(std::pair<int, double>) + 2 * sizeof(void*)));
+        assert(MemoryTracker::currentBytes() - before >= static_cast<int64_t>(heap_bytes - sizeof(BatchHeap)) / 2);
+        assert(MemoryTracker::peakBytes() >= MemoryTracker::currentBytes());
+    }
+    assert(MemoryTracker::currentBytes() == before);
+    MemoryTracker::setEnabled(false);
+    std::cout << "✓ BatchHeap with 1000 items: " << heap_bytes / 1024 << " KB; tracked bytes return to "
+              << before << " after destruction" << std::endl;
+
+    // Per-query peak: nested scopes report their own high-water mark
+    std::vector<double> distances(3600, INF);
+    std::vector<int> predecessors(3600, -1);
+    distances[0] = 0.0;
+    size_t outer_peak = 0, inner_peak = 0;
+    {
+        MemoryScope outer;
+        {
+            MemoryScope inner;
+            TrackedVector<char> block(1 << 20);
+            inner_peak = inner.peakBytes();
+        }
+        runBMSSP(graph, distances, predecessors, 2, 1e9, {0});
+        outer_peak = outer.peakBytes();
+    }
+    assert(inner_peak >= (1u << 20) && outer_peak >= inner_peak);
+
+    // findPivots' frontier sets and its result are tracked too
+    std::vector<double> d_pivots(3600, INF);
+    d_pivots[0] = 0.0;
+    TrackedUnorderedSet<int> frontier = {0};
+    size_t pivots_peak = 0, nearby = 0;
+    {
+        MemoryScope scope;
+        FindPivotResult pivots = findPivots(graph, 1e9, frontier, d_pivots);
+        nearby = pivots.nearby.size();
+        pivots_peak = scope.peakBytes();
+    }
+    assert(nearby > 1 && pivots_peak >= nearby * sizeof(int));
+
+    BMSSPTestFramework framework;
+    BMSSPTestCase test_case;
+    test_case.graph = graph;
+    test_case.sources = {0};
+    test_case.bound = 1e9;
+    PerformanceMeasurement perf = framework.measurePerformance(test_case);
+    assert(perf.memory_peak_kb >= 3600 * (sizeof(double) + sizeof(int)) / 1024);
+    std::cout << "✓ MemoryScope peaks nest; runBMSSP run peaks at " << perf.memory_peak_kb << " KB" << std::endl;
+}
+
+template <typename GraphT>
+double timeStorage(const GraphT& graph, const std::vector<int>& sources) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int source : sources) runDijkstra(graph, source);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / sources.size();
+}
+
+void testStorageTiming(bool enabled) {
+    if (!enabled) return;
+    std::cout << "\n=== Storage Timing ===" << std::endl;
+
+    GeneratedGraph generated = generateKronecker(18, 16, 36);
+    Graph graph = generated.toGraph();
+    FloatGraph floats = FloatGraph::fromGenerated(generated);
+    UInt32Graph integers = UInt32Graph::fromGenerated(generated);
+    DoubleGraph doubles = DoubleGraph::fromGenerated(generated);
+    std::vector<int> sources = {0, graph.getNumVertices() / 3, graph.getNumVertices() / 2};
+    std::cout << "  262K-vertex Kronecker, " << generated.getNumEdges() << " edges, ms per Dijkstra:" << std::endl;
+    std::cout << "    Graph (16 B/edge):             " << timeStorage(graph, sources) << std::endl;
+    std::cout << "    CSRGraph<double> (12 B/edge):  " << timeStorage(doubles, sources) << std::endl;
+    std::cout << "    CSRGraph<float> (8 B/edge):    " << timeStorage(floats, sources) << std::endl;
+    std::cout << "    CSRGraph<uint32_t> (8 B/edge): " << timeStorage(integers, sources) << std::endl;
+    CompressedGraph compressed = CompressedGraph::fromGenerated(generated, 0.01);
+    std::cout << "    CompressedGraph (" << static_cast<double>(compressed.edgeBytes()) / generated.getNumEdges()
+              << " B/edge): " << timeStorage(compressed, sources) << std::endl;
+
+    SimdLevel detected = detectSimdLevel();
+    std::cout << "  CSRGraph<float> Dijkstra by relaxation kernel:" << std::endl;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected) continue;
+        setSimdLevel(level);
+        std::cout << "    " << simdLevelName(level) << ": " << timeStorage(floats, sources) << " ms" << std::endl;
+    }
+    setSimdLevel(detected);
+}
+
+void testReorderTiming(bool enabled) {
+    if (!enabled) return;
+    std::cout << "\n=== Reorder Timing ===" << std::endl;
+
+    GeneratedGraph road = generateRoadGrid(400, 400, 5);
+    std::vector<int> labels;
+    Graph scrambled = scramble(road.toGraph(), 5, labels);
+    std::vector<double> x(road.num_vertices), y(road.num_vertices);
+    for (int v = 0; v < road.num_vertices; ++v) {
+        x[labels[v]] = road.x[v];
+        y[labels[v]] = road.y[v];
+    }
+
+    Graph kronecker = generateKronecker(17, 16, 5).toGraph();
+    for (int round = 0; round < 2; ++round) {
+        const Graph& graph = round == 0 ? scrambled : kronecker;
+        std::vector<int> sources = {0, graph.getNumVertices() / 3, graph.getNumVertices() / 2};
+        std::cout << "  " << (round == 0 ? "160K-vertex road grid, scrambled" : "131K-vertex Kronecker")
+                  << ": " << timeDijkstra(graph, sources) << " ms per Dijkstra" << std::endl;
+
+        for (ReorderStrategy strategy : {ReorderStrategy::BFS, ReorderStrategy::RCM, ReorderStrategy::DEGREE,
+                                         ReorderStrategy::HILBERT}) {
+            if (strategy == ReorderStrategy::HILBERT && round == 1) continue;
+            auto start = std::chrono::high_resolution_clock::now();
+            ReorderResult result = reorder(graph, strategy, x, y);
+            auto end = std::chrono::high_resolution_clock::now();
+            std::vector<int> mapped;
+            for (int source : sources) mapped.push_back(result.toNew(source));
+            std::cout << "    " << strategyName(strategy) << ": "
+                      << timeDijkstra(result.graph, mapped) << " ms per Dijkstra (reorder "
+                      << std::chrono::duration<double, std::milli>(end - start).count() << " ms)" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Graph Layout Test Suite ===" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+
+    initializeDebug(argc, argv);
+    bool timing = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--timing") timing = true;
+    }
+
+    try {
+        testReorderStrategies();
+        testBandwidthRecovery();
+        testReorderEdgeCases();
+        testCSRStorage();
+        testCSRAlgorithms();
+        testRelaxKernel();
+        testCompressedGraph();
+        testMemoryAccounting();
+        testReorderTiming(timing);
+        testStorageTiming(timing);
+
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "🎉 All graph layout tests PASSED!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <functional>
 
 /**
  * Performance and Scalability Test Suite
@@ -0,0 +1,1084 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "Graph.h"
+#include "GraphGenerators.h"
+#include "BMSSPTestFramework.h"
+#include "Dijkstra.h"
+#include "BMSSP.h"
+#include "CSRGraph.h"
+#include "DistanceTable.h"
+#include "NearestFacilities.h"
+#include "BoundedSSSP.h"
+#include "SparseResult.h"
+#include "Cancellation.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "QueryServer.h"
+#include "SSSPCache.h"
+#include "IndexedHeap.h"
+#include "PointToPoint.h"
+#include "BidirectionalDijkstra.h"
+#include "ContractionHierarchy.h"
+#include "Landmarks.h"
+#include "Debug.h"
+
+/**
+ * Query Engine Test Suite
+ * Verifies the query-oriented APIs against BMSSPTestFramework::runReferenceDijkstra:
+ * - IndexedHeap ordering and decrease-key
+ * - Many-to-many distance tables
+ * - Multi-source Dijkstra with offsets and Voronoi origins
+ * - Nearest-k facility queries, single and for every vertex
+ * - Bounded-radius (isochrone) queries with sparse results
+ * - SparseResult emitted by each engine and its dense round trip
+ * - Cancellation tokens and deadlines in runDijkstra, runBMSSP and PointToPointQuery
+ * - Latency histograms, per-query counters and slow-query capture
+ * - Chrome trace export of the BMSSP recursion
+ * - Unix-socket query server: batched SSSP, point-to-point and table requests
+ * - LRU cache of shortest-path trees: hits, eviction, coalesced misses, invalidation
+ * - Point-to-point queries (early exit, distance cap, lazy paths)
+ * - Reverse adjacency and bidirectional Dijkstra
+ */
+
+const double INF = std::numeric_limits<double>::max();
+
+bool closeEnough(double a, double b) {
+    if (a == INF || b == INF) return a == b;
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+Graph makeRoadGraph(int side, uint64_t seed) {
+    return generateRoadGrid(side, side, seed).toGraph();
+}
+
+double pathLength(const Graph& graph, const std::vector<int>& path) {
+    double length = 0.0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        double best = INF;
+        for (const auto& edge : graph.neighbors(path[i])) {
+            if (edge.dest == path[i + 1]) best = std::min(best, edge.weight);
+        }
+        if (best == INF) return INF;
+        length += best;
+    }
+    return length;
+}
+
+void testIndexedHeap() {
+    std::cout << "=== Testing IndexedHeap ===" << std::endl;
+
+    IndexedHeap heap(10);
+    heap.pushOrDecrease(3, 5.0);
+    heap.pushOrDecrease(1, 2.0);
+    heap.pushOrDecrease(7, 9.0);
+    heap.pushOrDecrease(4, 1.0);
+    assert(heap.size() == 4);
+    assert(!heap.pushOrDecrease(1, 3.0));  // not an improvement
+    assert(heap.pushOrDecrease(7, 0.5));   // decrease-key
+    assert(heap.size() == 4);
+
+    std::vector<int> order;
+    while (!heap.empty()) order.push_back(heap.pop().first);
+    assert((order == std::vector<int>{7, 4, 1, 3}));
+    assert(!heap.contains(7));
+    std::cout << "✓ Pops in key order with in-place decrease-key" << std::endl;
+}
+
+void testDistanceTable() {
+    std::cout << "\n=== Testing Distance Table ===" << std::endl;
+
+    Graph graph = makeRoadGraph(30, 17);
+    BMSSPTestFramework framework(17);
+
+    std::vector<int> sources = {0, 45, 450, 899, 45};   // includes a duplicate
+    std::vector<int> targets = {899, 10, 0, 300, 301, 10};
+
+    DistanceTable table = distanceTable(graph, sources, targets);
+    assert(table.num_sources == 5 && table.num_targets == 6);
+    assert(table.distances.size() == 30u);
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::vector<double> reference = framework.runReferenceDijkstra(graph, {sources[i]});
+        for (size_t j = 0; j < targets.size(); ++j) {
+            assert(closeEnough(table.at(i, j), reference[targets[j]]));
+        }
+    }
+    std::cout << "✓ Matches reference Dijkstra (with duplicate sources/targets)" << std::endl;
+
+    // Unreachable pairs keep the library's "infinite" sentinel
+    Graph split(4);
+    split.addEdge(0, 1, 1.0);
+    split.addEdge(2, 3, 1.0);
+    DistanceTable disconnected = distanceTable(split, {0, 2}, {1, 3});
+    assert(disconnected.at(0, 0) == 1.0 && disconnected.at(0, 1) == INF);
+    assert(disconnected.at(1, 0) == INF && disconnected.at(1, 1) == 1.0);
+    std::cout << "✓ Unreachable pairs reported as max()" << std::endl;
+
+    bool threw = false;
+    try {
+        distanceTable(split, {0}, {4});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(distanceTable(split, {}, {1}).distances.empty());
+    std::cout << "✓ Invalid ids rejected, empty inputs handled" << std::endl;
+}
+
+void testMultiSource() {
+    std::cout << "\n=== Testing Multi-Source Dijkstra ===" << std::endl;
+
+    Graph graph = makeRoadGraph(30, 39);
+    BMSSPTestFramework framework(39);
+    std::vector<int> sources = {0, 450, 899, 17};
+
+    MultiSourceResults plain = runMultiSourceDijkstra(graph, sources);
+    assert(plain.distances == framework.runReferenceDijkstra(graph, sources));
+    assert(plain.origins.empty());
+    std::cout << "✓ Zero offsets match the reference multi-source Dijkstra" << std::endl;
+
+    // Offsets: each vertex takes min over sources of offset + distance, and its origin is
+    // a source achieving that minimum at the root of its predecessor chain
+    std::vector<double> offsets = {40.0, 0.0, 250.5, 12.0};
+    MultiSourceResults cells = runMultiSourceDijkstra(graph, sources, offsets, true);
+    std::vector<std::vector<double>> single;
+    for (int source : sources) single.push_back(runDijkstra(graph, source).distances);
+    for (int v = 0; v < graph.getNumVertices(); ++v) {
+        double best = INF;
+        for (size_t i = 0; i < sources.size(); ++i) {
+            if (single[i][v] != INF) best = std::min(best, offsets[i] + single[i][v]);
+        }
+        assert(closeEnough(cells.distances[v], best));
+        if (best == INF) {
+            assert(cells.origins[v] == -1);
+            continue;
+        }
+        int origin = cells.origins[v];
+        assert(origin >= 0 && closeEnough(offsets[origin] + single[origin][v], best));
+        int root = v;
+        while (cells.predecessors[root] != -1) {
+            assert(cells.origins[cells.predecessors[root]] == origin);
+            root = cells.predecessors[root];
+        }
+        assert(root == sources[origin]);
+    }
+    std::cout << "✓ Offsets and Voronoi origins consistent with per-source searches" << std::endl;
+
+    FloatGraph floats = FloatGraph::fromGraph(graph);
+    MultiSourceResults on_csr = runMultiSourceDijkstra(floats, sources, offsets, true);
+    for (int v = 0; v < graph.getNumVertices(); ++v) {
+        assert(std::fabs(on_csr.distances[v] - cells.distances[v]) <= 1e-3 * std::max(1.0, cells.distances[v]));
+    }
+    std::cout << "✓ CSRGraph<float> storage agrees" << std::endl;
+
+    // A duplicated source keeps its smallest offset; unreachable vertices have no cell
+    Graph split(4);
+    split.addEdge(0, 1, 1.0);
+    split.addEdge(2, 3, 1.0);
+    MultiSourceResults dup = runMultiSourceDijkstra(split, {0, 0}, {5.0, 2.0}, true);
+    assert(dup.distances[0] == 2.0 && dup.distances[1] == 3.0 && dup.distances[2] == INF);
+    assert(dup.origins[1] == 1 && dup.origins[3] == -1 && dup.predecessors[0] == -1);
+    assert(runMultiSourceDijkstra(split, {}).distances == std::vector<double>(4, INF));
+
+    bool threw = false;
+    try { runMultiSourceDijkstra(split, {4}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { runMultiSourceDijkstra(split, {0, 1}, {1.0}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { runMultiSourceDijkstra(split, {0}, {INF * 2}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "✓ Duplicate sources, empty input and invalid arguments handled" << std::endl;
+}
+
+void testNearestFacilities() {
+    std::cout << "\n=== Testing Nearest Facilities ===" << std::endl;
+
+    Graph graph = generateRMAT(1500, 9000, 40).toGraph();
+    BMSSPTestFramework framework(40);
+    std::vector<int> facilities = {3, 77, 500, 501, 1499, 900, 77};   // includes a duplicate
+    NearestFacilityQuery query(graph, facilities);
+    assert(query.getNumFacilities() == 6);
+
+    const int k = 3;
+    NearestFacilityTable table = query.runAll(k);
+    assert(table.num_vertices == 1500 && table.k == k && table.hits.size() == 4500u);
+    for (int v = 0; v < graph.getNumVertices(); v += 7) {
+        std::vector<double> reference = framework.runReferenceDijkstra(graph, {v});
+        std::vector<double> expected;
+        for (int f : {3, 77, 500, 501, 1499, 900}) {
+            if (reference[f] != INF) expected.push_back(reference[f]);
+        }
+        std::sort(expected.begin(), expected.end());
+        if (expected.size() > static_cast<size_t>(k)) expected.resize(k);
+
+        std::vector<FacilityHit> hits = query.run(v, k);
+        assert(hits.size() == expected.size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            assert(closeEnough(hits[i].distance, expected[i]));
+            assert(closeEnough(reference[hits[i].facility], hits[i].distance));
+            assert(closeEnough(table.at(v, i).distance, hits[i].distance));
+            assert(closeEnough(reference[table.at(v, i).facility], table.at(v, i).distance));
+        }
+        for (int i = static_cast<int>(hits.size()); i < k; ++i) {
+            assert(table.at(v, i).facility == -1 && table.at(v, i).distance == INF);
+        }
+    }
+    assert(query.run(500, 1)[0].facility == 500 && query.run(500, 1)[0].distance == 0.0);
+    assert(table.at(500, 0).facility == 500 && table.at(500, 0).distance == 0.0);
+    graph.enableReverseEdges();
+    NearestFacilityTable via_reverse = query.runAll(k);
+    for (size_t i = 0; i < table.hits.size(); ++i) {
+        assert(via_reverse.hits[i].facility == table.hits[i].facility);
+        assert(via_reverse.hits[i].distance == table.hits[i].distance);
+    }
+    std::cout << "✓ run() and runAll() match the k smallest reference distances" << std::endl;
+
+    Graph split(4);
+    split.addEdge(0, 1, 1.0);
+    split.addEdge(2, 3, 1.0);
+    NearestFacilityQuery split_query(split, {1, 3});
+    assert(split_query.run(0, 5).size() == 1 && split_query.run(0, 5)[0].facility == 1);
+    assert(split_query.run(0, 0).empty());
+    assert(NearestFacilityQuery(split, {}).runAll(2).hits.size() == 8u);
+    bool threw = false;
+    try { NearestFacilityQuery(split, {4}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { split_query.run(-1, 1); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "✓ Unreachable facilities, k = 0 and invalid ids handled" << std::endl;
+}
+
+void testBoundedSSSP() {
+    std::cout << "\n=== Testing Bounded-Radius Queries ===" << std::endl;
+
+    Graph graph = makeRoadGraph(60, 41);
+    BMSSPTestFramework framework(41);
+    std::vector<int> sources = {1830, 100};
+    std::vector<double> reference = framework.runReferenceDijkstra(graph, sources);
+
+    double radius = 600.0;
+    std::vector<ReachedVertex> reached = boundedSSSP(graph, sources, radius);
+    size_t inside = 0;
+    for (double d : reference) inside += d < radius ? 1 : 0;
+    assert(reached.size() == inside && inside < reference.size() / 4);
+    std::vector<char> seen(graph.getNumVertices(), 0);
+    for (size_t i = 0; i < reached.size(); ++i) {
+        const ReachedVertex& r = reached[i];
+        assert(!seen[r.vertex]);
+        seen[r.vertex] = 1;
+        assert(closeEnough(r.distance, reference[r.vertex]) && r.distance < radius);
+        if (i > 0) assert(reached[i - 1].distance <= r.distance);
+        if (r.predecessor == -1) {
+            assert(r.vertex == 1830 || r.vertex == 100);
+        } else {
+            // The predecessor is inside too, and the edge accounts for the difference
+            assert(seen[r.predecessor]);
+            double edge = INF;
+            for (const auto& e : graph.neighbors(r.predecessor)) {
+                if (e.dest == r.vertex) edge = std::min(edge, e.weight);
+            }
+            assert(closeEnough(reference[r.predecessor] + edge, r.distance));
+        }
+    }
+    std::cout << "✓ " << reached.size() << "/" << reference.size()
+              << " vertices within the radius, in distance order with valid predecessors" << std::endl;
+
+    DoubleGraph doubles = DoubleGraph::fromGraph(graph);
+    std::vector<ReachedVertex> on_csr = boundedSSSP(doubles, sources, radius);
+    assert(on_csr.size() == reached.size());
+    for (size_t i = 0; i < reached.size(); ++i) assert(on_csr[i].distance == reached[i].distance);
+    std::cout << "✓ CSRGraph<double> storage agrees" << std::endl;
+
+    // Strict bound: a vertex exactly at the radius is excluded
+    Graph line(3);
+    line.addEdge(0, 1, 1.0);
+    line.addEdge(1, 2, 1.0);
+    assert(boundedSSSP(line, {0}, 2.0).size() == 2u);
+    assert(boundedSSSP(line, {0}, INF).size() == 3u);
+    assert(boundedSSSP(line, {0}, 0.0).empty() && boundedSSSP(line, {}, 5.0).empty());
+    bool threw = false;
+    try { boundedSSSP(line, {3}, 1.0); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { boundedSSSP(line, {0}, std::nan("")); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "✓ Strict radius, empty input and invalid arguments handled" << std::endl;
+}
+
+void testSparseResult() {
+    std::cout << "\n=== Testing Sparse Results ===" << std::endl;
+
+    Graph graph = makeRoadGraph(40, 42);
+    int n = graph.getNumVertices();
+
+    // Dense engine output round-trips exactly
+    DijkstraResults dense = runDijkstra(graph, 5);
+    SparseResult full = SparseResult::fromDense(dense.distances, dense.predecessors);
+    assert(full.getNumVertices() == n && full.size() == static_cast<size_t>(n));
+    DijkstraResults back = full.toDense();
+    assert(back.distances == dense.distances && back.predecessors == dense.predecessors);
+    std::vector<int> path = full.getPath(n - 1);
+    assert(path.front() == 5 && path.back() == n - 1 && closeEnough(pathLength(graph, path), dense.distances[n - 1]));
+    std::cout << "✓ runDijkstra output round-trips through SparseResult" << std::endl;
+
+    // Bounded search: only the explored vertices, matching the vector form entry by entry
+    std::vector<ReachedVertex> reached = boundedSSSP(graph, {5}, 300.0);
+    SparseResult local = boundedSSSPSparse(graph, {5}, 300.0);
+    assert(local.size() == reached.size() && local.size() < static_cast<size_t>(n) / 4);
+    for (size_t i = 0; i < reached.size(); ++i) {
+        assert(local.getVertices()[i] == reached[i].vertex);
+        assert(local.getDistance(reached[i].vertex) == reached[i].distance);
+        assert(local.getPredecessor(reached[i].vertex) == reached[i].predecessor);
+        assert(local.getDistance(reached[i].vertex) == dense.distances[reached[i].vertex]);
+    }
+    DijkstraResults local_dense = local.toDense();
+    for (int v = 0; v < n; ++v) {
+        assert(local.contains(v) == (local_dense.distances[v] != INF));
+        if (!local.contains(v)) assert(local.getDistance(v) == INF && local.getPredecessor(v) == -1);
+    }
+    std::cout << "✓ boundedSSSPSparse holds " << local.size() << "/" << n << " vertices and densifies on demand" << std::endl;
+
+    // Point-to-point: settled vertices only, with final distances
+    PointToPointQuery query(graph);
+    PointToPointResult run = query.run(5, std::vector<int>{6});
+    SparseResult settled = query.getSparseResult();
+    assert(settled.size() == static_cast<size_t>(run.settled_vertices) && settled.contains(6));
+    for (size_t i = 0; i < settled.size(); ++i) {
+        assert(settled.getDistances()[i] == dense.distances[settled.getVertices()[i]]);
+    }
+    assert(PointToPointQuery(graph).getSparseResult().empty());
+
+    // BMSSP: restricted to the completed vertices
+    std::vector<double> distances(n, INF);
+    std::vector<int> predecessors(n, -1);
+    distances[5] = 0.0;
+    int level = static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::max(1, graph.getT())));
+    BMSSPResult bmssp = runBMSSP(graph, distances, predecessors, level, 1e9, {5});
+    SparseResult completed = SparseResult::fromDense(distances, predecessors, bmssp.completed_vertices);
+    assert(completed.size() <= bmssp.completed_vertices.size());
+    for (int v : completed.getVertices()) assert(closeEnough(completed.getDistance(v), dense.distances[v]));
+    std::cout << "✓ PointToPointQuery and runBMSSP emit sparse results" << std::endl;
+
+    bool threw = false;
+    try { SparseResult::fromDense({0.0}, {}); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    SparseResult manual(3);
+    manual.add(2, 4.0, -1);
+    manual.add(2, 3.0, -1);
+    assert(manual.size() == 1u && manual.getDistance(2) == 3.0 && manual.getPath(0).empty());
+    std::cout << "✓ Re-added vertices update in place; mismatched arrays rejected" << std::endl;
+}
+
+void testCancellation() {
+    std::cout << "\n=== Testing Cancellation ===" << std::endl;
+
+    CancellationToken token;
+    assert(!token.shouldStop());
+    StopCheck check(&token, 8);
+    for (int i = 0; i < 20; ++i) assert(!check.tick());
+    token.cancel();
+    int ticks = 0;
+    while (!check.tick()) ticks++;
+    assert(ticks < 8 && check.isStopped() && check.tick());
+    StopCheck never(nullptr);
+    assert(!never.tick());
+    CancellationToken expired(std::chrono::nanoseconds(0));
+    assert(expired.isExpired() && !expired.isCancelled() && expired.shouldStop());
+    expired.clearDeadline();
+    assert(!expired.shouldStop());
+    std::cout << "✓ Token flag, deadline and amortised polling" << std::endl;
+
+    Graph graph = makeRoadGraph(300, 43);
+    int n = graph.getNumVertices();
+    DijkstraResults full = runDijkstra(graph, 0);
+    CancellationToken idle;
+    DijkstraResults unstopped = runDijkstra(graph, 0, &idle);
+    assert(unstopped.complete && full.complete && unstopped.distances == full.distances);
+
+    DijkstraResults stopped = runDijkstra(graph, 0, &token);
+    assert(!stopped.complete && stopped.distances[0] == 0.0);
+    for (int v = 1; v < n; ++v) assert(stopped.distances[v] == INF);
+
+    // Stopped mid-run by a deadline: every distance written is a real path length
+    CancellationToken deadline(std::chrono::microseconds(500));
+    DijkstraResults partial = runDijkstra(graph, 0, &deadline);
+    int reached = 0;
+    for (int v = 0; v < n; ++v) {
+        if (partial.distances[v] == INF) continue;
+        reached++;
+        assert(partial.distances[v] >= full.distances[v] - 1e-9);
+        int p = partial.predecessors[v];
+        if (v != 0) assert(p >= 0 && partial.distances[p] <= partial.distances[v]);
+    }
+    std::cout << "✓ runDijkstra: " << (partial.complete ? "finished" : "stopped") << " within 0.5 ms with "
+              << reached << "/" << n << " vertices reached, all upper bounds" << std::endl;
+
+    std::vector<double> distances(n, INF);
+    std::vector<int> predecessors(n, -1);
+    distances[0] = 0.0;
+    int level = static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::max(1, graph.getT())));
+    BMSSPResult bmssp = runBMSSP(graph, distances, predecessors, level, 1e9, {0}, &token);
+    assert(!bmssp.complete);
+    for (int v : bmssp.completed_vertices) assert(distances[v] >= full.distances[v] - 1e-9);
+    distances.assign(n, INF);
+    distances[0] = 0.0;
+    assert(runBMSSP(graph, distances, predecessors, level, 1e9, {0}, &idle).complete);
+
+    // Stopped partway: every vertex reported as completed carries its final distance
+    int stopped_runs = 0;
+    for (int micros : {20, 100, 300, 1000, 3000}) {
+        CancellationToken budget{std::chrono::microseconds(micros)};
+        distances.assign(n, INF);
+        predecessors.assign(n, -1);
+        distances[0] = 0.0;
+        BMSSPResult partial_bmssp = runBMSSP(graph, distances, predecessors, level, 1e9, {0}, &budget);
+        if (partial_bmssp.complete) continue;
+        stopped_runs++;
+        for (int v : partial_bmssp.completed_vertices) assert(closeEnough(distances[v], full.distances[v]));
+    }
+    std::cout << "✓ runBMSSP unwinds with complete = false, reporting only exact vertices ("
+              << stopped_runs << "/5 deadline runs stopped)" << std::endl;
+
+    PointToPointQuery query(graph);
+    QueryOptions options;
+    options.cancel = &token;
+    PointToPointResult aborted = query.run(0, std::vector<int>{n - 1}, options);
+    assert(!aborted.complete && aborted.distances[0] == INF && aborted.settled_vertices == 0);
+    options.cancel = &idle;
+    PointToPointResult answered = query.run(0, std::vector<int>{n - 1}, options);
+    assert(answered.complete && closeEnough(answered.distances[0], full.distances[n - 1]));
+
+    // Cancelled from another thread while the search runs
+    CancellationToken remote;
+    std::thread canceller([&remote]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        remote.cancel();
+    });
+    DijkstraResults remote_result = runDijkstra(graph, 0, &remote);
+    canceller.join();
+    assert(remote_result.distances[0] == 0.0);
+    std::cout << "✓ PointToPointQuery honours QueryOptions::cancel; cross-thread cancel "
+              << (remote_result.complete ? "arrived after the search" : "stopped the search") << std::endl;
+}
+
+void testMetrics() {
+    std::cout << "\n=== Testing Metrics ===" << std::endl;
+
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 1000; ++v) histogram.record(v * 1000);
+    assert(histogram.count() == 1000 && histogram.min() == 1000 && histogram.max() == 1000000);
+    for (double q : {0.5, 0.9, 0.99}) {
+        double exact = q * 1000000.0;
+        double reported = static_cast<double>(histogram.percentile(q));
+        assert(reported >= exact && reported <= exact * (1.0 + 1.0 / LatencyHistogram::SUB_BUCKETS));
+    }
+    assert(histogram.percentile(1.0) == 1000000 && histogram.percentile(0.0) == 1000);
+    for (uint64_t v : {uint64_t(0), uint64_t(31), uint64_t(32), uint64_t(12345), ~uint64_t(0)}) {
+        int b = LatencyHistogram::bucketOf(v);
+        assert(b < LatencyHistogram::NUM_BUCKETS);
+        assert(LatencyHistogram::bucketLow(b) <= v && v <= LatencyHistogram::bucketHigh(b));
+    }
+    std::cout << "✓ Histogram percentiles within 1/" << LatencyHistogram::SUB_BUCKETS << " of exact" << std::endl;
+
+    Graph graph = makeRoadGraph(60, 44);
+    int n = graph.getNumVertices();
+    MetricsRegistry& metrics = MetricsRegistry::global();
+    metrics.reset();
+    metrics.labelGraph(&graph, "road \"60x60\"");
+    ContractionHierarchy hierarchy = ContractionHierarchy::build(graph);
+    metrics.labelGraph(&hierarchy, "road \"60x60\"");
+    LandmarkIndex landmarks = LandmarkIndex::build(graph);
+    runDijkstra(graph, 0);
+    assert(metrics.queryCount("runDijkstra", "road \"60x60\"") == 0);   // disabled by default
+
+    MetricsRegistry::setEnabled(true);
+    metrics.setSlowQueryCapacity(3);
+    for (int s = 0; s < 5; ++s) runDijkstra(graph, s * 7);
+    assert(metrics.queryCount("runDijkstra", "road \"60x60\"") == 5);
+    assert(metrics.histogram("runDijkstra", "road \"60x60\"").count() == 5);
+    std::vector<QueryRecord> slow = metrics.slowQueries();
+    assert(slow.size() == 3);
+    for (size_t i = 1; i < slow.size(); ++i) assert(slow[i - 1].latency_ns >= slow[i].latency_ns);
+    assert(slow[0].counter("settled_vertices") == static_cast<uint64_t>(n));
+    assert(slow[0].counter("relaxed_edges") >= static_cast<uint64_t>(n - 1));
+    assert(slow[0].parameters.compare(0, 7, "source=") == 0);
+    std::cout << "✓ runDijkstra recorded with counters; 3 slowest of 5 kept" << std::endl;
+
+    // The recursion records once, under the top-level call
+    std::vector<double> distances(n, INF);
+    std::vector<int> predecessors(n, -1);
+    distances[0] = 0.0;
+    int level = static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::max(1, graph.getT())));
+    metrics.setSlowQueryCapacity(16);
+    runBMSSP(graph, distances, predecessors, level, 1e9, {0});
+    assert(metrics.queryCount("runBMSSP", "road \"60x60\"") == 1);
+    QueryRecord bmssp;
+    for (const QueryRecord& query : metrics.slowQueries()) {
+        if (query.engine == "runBMSSP") bmssp = query;
+    }
+    assert(bmssp.complete && bmssp.counter("pulls") > 0 && bmssp.counter("base_cases") > 0);
+    assert(bmssp.counter("settled_vertices") > 0 && bmssp.counter("relaxed_edges") > 0);
+
+    CancellationToken cancelled;
+    cancelled.cancel();
+    runDijkstra(graph, 0, &cancelled);
+    PointToPointQuery query(graph);
+    query.run(0, n - 1);
+    boundedSSSP(graph, {0}, 300.0);
+
+    // The speed-up engines and distance tables record with their counters too
+    CHQuery ch_query(hierarchy);
+    ALTQuery alt_query(graph, landmarks);
+    double ch_distance = ch_query.run(0, n - 1);
+    assert(closeEnough(alt_query.run(0, n - 1), ch_distance));
+    distanceTable(graph, {0, 5, 17}, {n - 1, 30});
+    for (const char* engine : {"CHQuery::run", "ALTQuery::run", "distanceTable"}) {
+        assert(metrics.queryCount(engine, "road \"60x60\"") == 1);
+        QueryRecord recorded;
+        for (const QueryRecord& query : metrics.slowQueries()) {
+            if (query.engine == engine) recorded = query;
+        }
+        assert(recorded.counter("settled_vertices") > 0 && recorded.counter("relaxed_edges") > 0);
+        assert(recorded.parameters.compare(0, 7, "source=") == 0 || recorded.parameters.compare(0, 8, "sources=") == 0);
+    }
+    std::cout << "✓ CHQuery, ALTQuery and distanceTable recorded with counters" << std::endl;
+
+    std::string json = metrics.toJson();
+    assert(json.find("\"engine\": \"runBMSSP\"") != std::string::npos);
+    assert(json.find("\"engine\": \"PointToPointQuery::run\"") != std::string::npos);
+    assert(json.find("\"engine\": \"boundedSSSP\"") != std::string::npos);
+    assert(json.find("\"graph\": \"road \\\"60x60\\\"\"") != std::string::npos);
+    assert(json.find("\"incomplete\": 1") != std::string::npos);
+    assert(json.find("\"slow_queries\": [{") != std::string::npos);
+    std::cout << "✓ JSON export: " << json.size() << " bytes, " << metrics.slowQueries().size()
+              << " slow queries" << std::endl;
+
+    MetricsRegistry::setEnabled(false);
+    metrics.reset();
+    runDijkstra(graph, 0);
+    assert(metrics.slowQueries().empty());
+}
+
+void testTracing() {
+    std::cout << "\n=== Testing Tracing ===" << std::endl;
+
+    Graph graph = makeRoadGraph(60, 45);
+    int n = graph.getNumVertices();
+    int level = static_cast<int>(std::ceil(std::log(static_cast<double>(n)) / std::max(1, graph.getT())));
+    std::vector<double> distances(n, INF);
+    std::vector<int> predecessors(n, -1);
+    TraceRecorder& tracer = TraceRecorder::global();
+    distances[0] = 0.0;
+    runBMSSP(graph, distances, predecessors, level, 1e9, {0});
+    assert(tracer.eventCount() == 0);   // off by default
+
+    tracer.start();
+    distances.assign(n, INF);
+    distances[0] = 0.0;
+    runBMSSP(graph, distances, predecessors, level, 1e9, {0});
+    tracer.stop();
+    std::vector<TraceEvent> events = tracer.getEvents();
+
+    // Spans close innermost first, so the top-level call is the last event
+    const TraceEvent& top = events.back();
+    assert(std::string(top.name) == "runBMSSP" && top.num_args >= 2);
+    assert(std::string(top.arg_names[0]) == "level" && top.arg_values[0] == level);
+    int levels = 0, pivots = 0, pulls = 0, base_cases = 0;
+    for (const TraceEvent& event : events) {
+        std::string name = event.name;
+        levels += name == "runBMSSP";
+        pivots += name == "findPivots";
+        pulls += name == "BatchHeap::pull";
+        base_cases += name == "runBaseCase";
+        assert(event.thread == top.thread && event.duration_ns >= 0);
+        assert(event.start_ns >= top.start_ns && event.start_ns + event.duration_ns <= top.start_ns + top.duration_ns);
+    }
+    assert(levels > 1 && pivots > 0 && pulls > 0 && base_cases > 0);
+    std::cout << "✓ " << events.size() << " spans: " << levels << " runBMSSP, " << pivots << " findPivots, " << pulls
+              << " pulls, " << base_cases << " base cases, nested in the top-level call" << std::endl;
+
+    std::string json = tracer.toJson();
+    assert(json.compare(0, 16, "{\"traceEvents\": ") == 0);
+    assert(json.find("\"name\": \"BatchHeap::pull\", \"cat\": \"batchheap\", \"ph\": \"X\"") != std::string::npos);
+    assert(json.find("\"displayTimeUnit\": \"ns\"") != std::string::npos);
+    std::string path = "test_query_engines_trace.json";
+    tracer.writeJson(path);
+    std::remove(path.c_str());
+    bool threw = false;
+    try {
+        tracer.writeJson("/nonexistent-directory/trace.json");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Chrome trace JSON: " << json.size() << " bytes" << std::endl;
+
+    runBMSSP(graph, distances, predecessors, level, 1e9, {0});
+    assert(tracer.eventCount() == events.size());
+    tracer.clear();
+}
+
+void testSSSPCache() {
+    std::cout << "\n=== Testing SSSP Cache ===" << std::endl;
+
+    Graph graph = makeRoadGraph(40, 29);
+    int n = graph.getNumVertices();
+    SSSPCache cache(graph);
+    std::shared_ptr<const SSSPTree> tree = cache.get(5);
+    DijkstraResults reference = runDijkstra(graph, 5);
+    assert(tree->isExact() && tree->distances == reference.distances && tree->predecessors == reference.predecessors);
+    assert(cache.get(5) == tree && cache.contains(5) && !cache.contains(6));
+    assert(closeEnough(pathLength(graph, tree->getPath(n - 1)), tree->distance(n - 1)));
+    std::vector<double> copied;
+    tree->copyDistances(copied);
+    assert(copied == reference.distances);
+    SSSPCacheStats stats = cache.stats();
+    assert(stats.hits == 1 && stats.misses == 1 && stats.entries == 1 && stats.bytes == tree->memoryUsage());
+    std::cout << "✓ Miss runs one search, hit returns the same tree (" << tree->memoryUsage() << " bytes)" << std::endl;
+
+    // Room for three trees: the least recently used one goes first
+    cache.setCapacity(3 * tree->memoryUsage());
+    cache.get(1);
+    cache.get(2);
+    cache.get(5);
+    cache.get(3);
+    assert(cache.contains(5) && cache.contains(2) && cache.contains(3) && !cache.contains(1));
+    stats = cache.stats();
+    assert(stats.entries == 3 && stats.evictions == 1 && stats.bytes <= 3 * tree->memoryUsage());
+    cache.setCapacity(tree->memoryUsage() - 1);
+    std::shared_ptr<const SSSPTree> uncached = cache.get(7);
+    assert(uncached->distances == runDijkstra(graph, 7).distances);
+    assert(cache.stats().entries == 0 && !cache.contains(7));
+    assert(tree->distances == reference.distances);   // evicted trees stay valid for their holders
+    std::cout << "✓ LRU eviction within the byte budget, oversized trees served but not kept" << std::endl;
+
+    // Concurrent lookups of a few hot sources
+    cache.setCapacity(size_t(64) << 20);
+    cache.resetStats();
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches(0);
+    std::vector<std::vector<double>> expected;
+    for (int s = 0; s < 4; ++s) expected.push_back(runDijkstra(graph, s * 100).distances);
+    for (int t = 0; t < 6; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 20; ++i) {
+                int s = (t + i) % 4;
+                if (cache.get(s * 100)->distances != expected[s]) ++mismatches;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    stats = cache.stats();
+    assert(mismatches.load() == 0);
+    assert(stats.misses == 4 && stats.hits + stats.coalesced == 6 * 20 - 4);
+    std::cout << "✓ 6 threads x 20 lookups: " << stats.misses << " searches, " << stats.coalesced
+              << " coalesced, hit rate " << stats.hitRate() << std::endl;
+
+    // Any mutation changes the graph version and flushes the cache; compaction does not
+    uint64_t version = graph.getVersion();
+    Graph copy = graph;
+    assert(copy.getVersion() == version);
+    graph.removeEdge(graph.findEdge(0, 1));
+    assert(graph.getVersion() != version && !cache.contains(0));
+    std::shared_ptr<const SSSPTree> repaired = cache.get(0);
+    assert(repaired->distances == runDijkstra(graph, 0).distances && repaired->graph_version == graph.getVersion());
+    version = graph.getVersion();
+    graph.compact();
+    assert(graph.getVersion() == version && cache.contains(0));
+    graph.addEdge(0, 1, 0.5);
+    assert(!cache.contains(0) && cache.get(0)->distance(1) == 0.5);
+    assert(cache.stats().invalidations == 2);
+    cache.invalidate();
+    assert(!cache.contains(0) && cache.stats().invalidations == 3);
+    std::cout << "✓ Mutation through the Graph API invalidates, compaction keeps entries" << std::endl;
+
+    // float32 distances
+    SSSPCacheOptions options;
+    options.float_distances = true;
+    SSSPCache compact(graph, options);
+    std::shared_ptr<const SSSPTree> small = compact.get(0);
+    std::vector<double> exact = runDijkstra(graph, 0).distances;
+    assert(!small->isExact() && small->distances.empty());
+    for (int v = 0; v < n; ++v) {
+        assert(exact[v] == INF ? small->distance(v) == INF
+                               : std::fabs(small->distance(v) - exact[v]) <= 1e-6 * std::max(1.0, exact[v]));
+    }
+    assert(small->memoryUsage() < cache.get(0)->memoryUsage());
+    std::cout << "✓ float32 trees: " << small->memoryUsage() << " bytes, within float precision"
+              << std::endl;
+
+    bool threw = false;
+    try {
+        cache.get(n);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void testQueryServer() {
+    std::cout << "\n=== Testing Query Server ===" << std::endl;
+
+    Graph graph = generateRMAT(2000, 10000, 23).toGraph();   // directed: has unreachable pairs
+    int n = graph.getNumVertices();
+    std::string socket_path = "/tmp/test_query_engines_" + std::to_string(::getpid()) + ".sock";
+    QueryServerOptions options;
+    options.num_workers = 3;
+    options.max_batch = 16;
+    options.cache_bytes = size_t(16) << 20;
+    QueryServer server(graph, options);
+    server.start(socket_path);
+    assert(server.isRunning());
+
+    QueryClient client(socket_path);
+    int num_vertices = 0;
+    int64_t num_edges = 0;
+    client.info(num_vertices, num_edges);
+    assert(num_vertices == n && num_edges == static_cast<int64_t>(graph.getNumEdges()));
+
+    std::vector<int> predecessors;
+    DijkstraResults reference = runDijkstra(graph, 7);
+    assert(client.sssp(7, &predecessors) == reference.distances);
+    assert(predecessors == reference.predecessors);
+    std::cout << "✓ INFO and SSSP (with predecessors) match runDijkstra" << std::endl;
+
+    // Concurrent clients with a mixed load; same-source requests get batched together
+    const int num_clients = 6;
+    std::vector<int> sources = {0, 7, 42, 1999};
+    std::vector<std::vector<double>> expected;
+    for (int s : sources) expected.push_back(runDijkstra(graph, s).distances);
+    std::vector<std::thread> clients;
+    std::atomic<int> mismatches(0);
+    for (int c = 0; c < num_clients; ++c) {
+        clients.emplace_back([&, c] {
+            QueryClient own(socket_path);
+            for (int i = 0; i < 40; ++i) {
+                size_t k = (c + i) % sources.size();
+                int target = (c * 131 + i * 37) % n;
+                std::vector<int> path;
+                double distance = own.pointToPoint(sources[k], target, i % 2 ? &path : nullptr);
+                if (distance != expected[k][target]) ++mismatches;
+                if (i % 2 && distance != INF && !closeEnough(pathLength(graph, path), distance)) ++mismatches;
+                if (i % 2 && distance == INF && !path.empty()) ++mismatches;
+                if (i % 10 == 0 && own.sssp(sources[k]) != expected[k]) ++mismatches;
+            }
+        });
+    }
+    for (auto& thread : clients) thread.join();
+    assert(mismatches.load() == 0);
+    std::cout << "✓ " << num_clients << " concurrent clients: point-to-point distances and paths exact" << std::endl;
+
+    std::vector<int> table_sources = {0, 7, 7, 1999};
+    std::vector<int> table_targets = {3, 0, 500, 1234, 3};
+    std::vector<double> table = client.distanceTable(table_sources, table_targets);
+    assert(table == distanceTable(graph, table_sources, table_targets).distances);
+    std::cout << "✓ DISTANCE_TABLE matches distanceTable" << std::endl;
+
+    bool threw = false;
+    try {
+        client.pointToPoint(0, n);
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()).find("out of range") != std::string::npos;
+    }
+    assert(threw);
+    assert(client.pointToPoint(0, 0) == 0.0);   // the connection survives a rejected request
+    std::cout << "✓ Invalid vertex rejected with the server's message, connection kept" << std::endl;
+
+    QueryServerStats stats = server.stats();
+    assert(stats.connections == num_clients + 1);
+    assert(stats.errors == 1 && stats.requests >= 6u * 40 + 5);
+    assert(stats.searches <= stats.requests && stats.batches > 0 && stats.cache_hits > 0);
+    std::cout << "✓ " << stats.requests << " requests in " << stats.batches << " batches, " << stats.searches
+              << " searches, " << stats.cache_hits << " cache hits" << std::endl;
+
+    server.stop();
+    assert(!server.isRunning() && ::access(socket_path.c_str(), F_OK) != 0);
+    threw = false;
+    try {
+        QueryClient late(socket_path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ stop() closes connections and removes the socket" << std::endl;
+
+    // Oversized answers are refused up front; a two-slot queue still serves every client
+    QueryServerOptions tight;
+    tight.num_workers = 1;
+    tight.max_response_bytes = 4096;
+    tight.max_queued_requests = 2;
+    QueryServer limited(graph, tight);
+    limited.start(socket_path);
+    QueryClient small(socket_path);
+    threw = false;
+    try {
+        small.sssp(7);   // 8 bytes per vertex
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()).find("exceeds the limit") != std::string::npos;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        small.distanceTable(std::vector<int>(10, 0), std::vector<int>(100, 1));
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()).find("exceeds the response limit") != std::string::npos;
+    }
+    assert(threw);
+    assert(small.distanceTable({0, 7}, {3, 1234}) == distanceTable(graph, {0, 7}, {3, 1234}).distances);
+
+    mismatches.store(0);
+    clients.clear();
+    for (int c = 0; c < num_clients; ++c) {
+        clients.emplace_back([&, c] {
+            QueryClient own(socket_path);
+            for (int i = 0; i < 20; ++i) {
+                size_t k = (c + i) % sources.size();
+                int target = (c * 17 + i * 101) % n;
+                if (own.pointToPoint(sources[k], target) != expected[k][target]) ++mismatches;
+            }
+        });
+    }
+    for (auto& thread : clients) thread.join();
+    assert(mismatches.load() == 0);
+    limited.stop();   // joins the workers, so the counters are final
+    stats = limited.stats();
+    assert(stats.errors == 2 && stats.requests == 3u + num_clients * 20u);
+    std::cout << "✓ Oversized SSSP and table answers refused; " << num_clients
+              << " clients served through a 2-request queue" << std::endl;
+}
+
+void testPointToPoint() {
+    std::cout << "\n=== Testing Point-to-Point Query ===" << std::endl;
+
+    Graph graph = makeRoadGraph(40, 5);
+    int n = graph.getNumVertices();
+    BMSSPTestFramework framework(5);
+    std::vector<double> reference = framework.runReferenceDijkstra(graph, {0});
+
+    PointToPointQuery query(graph);
+    for (int target : {0, 1, 41, 800, n - 1}) {
+        assert(closeEnough(query.run(0, target), reference[target]));
+
+        // The lazily rebuilt path starts at the source, ends at the target and its
+        // edge weights add up to the reported distance
+        std::vector<int> path = query.getPath(target);
+        assert(!path.empty() && path.front() == 0 && path.back() == target);
+        assert(closeEnough(pathLength(graph, path), reference[target]));
+    }
+    std::cout << "✓ Distances and paths match reference Dijkstra" << std::endl;
+
+    // Local queries settle only a small part of the graph
+    PointToPointResult local = query.run(0, std::vector<int>{1});
+    assert(local.settled_vertices < n / 10);
+    std::cout << "✓ Early exit: neighbour query settled " << local.settled_vertices << "/" << n << " vertices" << std::endl;
+
+    // Target set: all requested targets settled, repeated targets allowed
+    PointToPointResult multi = query.run(0, std::vector<int>{n - 1, 41, n - 1});
+    assert(closeEnough(multi.distances[0], reference[n - 1]));
+    assert(closeEnough(multi.distances[1], reference[41]));
+    assert(multi.distances[2] == multi.distances[0]);
+
+    QueryOptions first;
+    first.stop_at_first_target = true;
+    PointToPointResult nearest = query.run(0, std::vector<int>{n - 1, 41}, first);
+    assert(closeEnough(nearest.distances[1], reference[41]));
+    assert(nearest.distances[0] == INF);
+    std::cout << "✓ Target sets (all targets / first target)" << std::endl;
+
+    // Distance cap: targets at or beyond the cap are reported unreached
+    QueryOptions capped;
+    capped.distance_cap = reference[n - 1];
+    assert(query.run(0, n - 1, capped) == INF);
+    assert(query.getPath(n - 1).empty());
+    capped.distance_cap = reference[41] * 1.5;
+    assert(closeEnough(query.run(0, 41, capped), reference[41]));
+    std::cout << "✓ Distance cap bounds the search" << std::endl;
+
+    // Unreachable target and invalid ids
+    Graph split(3);
+    split.addEdge(0, 1, 2.0);
+    PointToPointQuery split_query(split);
+    assert(split_query.run(0, 2) == INF && split_query.getPath(2).empty());
+    assert(split_query.run(0, 0) == 0.0 && split_query.getPath(0) == std::vector<int>{0});
+    bool threw = false;
+    try {
+        split_query.run(0, 3);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Unreachable targets and invalid ids handled" << std::endl;
+}
+
+void testReverseEdges() {
+    std::cout << "\n=== Testing Reverse Adjacency ===" << std::endl;
+
+    Graph graph(4);
+    graph.addEdge(0, 1, 1.5);
+    graph.addEdge(2, 1, 2.5);
+    assert(!graph.hasReverseEdges());
+    assert(graph.reverseNeighbors(1).empty());
+
+    graph.enableReverseEdges();
+    graph.addEdge(3, 1, 4.0);   // added after enabling: must be mirrored too
+    const std::vector<Edge>& incoming = graph.reverseNeighbors(1);
+    assert(incoming.size() == 3);
+    assert(incoming[0].dest == 0 && incoming[0].weight == 1.5);
+    assert(incoming[2].dest == 3 && incoming[2].weight == 4.0);
+    assert(graph.reverseNeighbors(0).empty());
+
+    Graph copy = graph;
+    assert(copy.hasReverseEdges() && copy.reverseNeighbors(1).size() == 3);
+    copy.disableReverseEdges();
+    assert(!copy.hasReverseEdges() && graph.hasReverseEdges());
+    std::cout << "✓ Incoming edges built, maintained by addEdge and copied with the graph" << std::endl;
+}
+
+void testBidirectional() {
+    std::cout << "\n=== Testing Bidirectional Dijkstra ===" << std::endl;
+
+    bool threw = false;
+    Graph plain(3);
+    try {
+        BidirectionalQuery query(plain);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Directed graphs exercise the reverse search properly
+    Graph graph = generateRMAT(2000, 16000, 11).toGraph();
+    graph.enableReverseEdges();
+    BMSSPTestFramework framework(11);
+    BidirectionalQuery query(graph);
+
+    int checked = 0;
+    for (int source : {0, 7, 1500}) {
+        std::vector<double> reference = framework.runReferenceDijkstra(graph, {source});
+        for (int target = 0; target < graph.getNumVertices(); target += 37) {
+            double dist = query.run(source, target);
+            assert(closeEnough(dist, reference[target]));
+            std::vector<int> path = query.getPath();
+            if (dist == INF) {
+                assert(path.empty());
+            } else {
+                assert(path.front() == source && path.back() == target);
+                assert(closeEnough(pathLength(graph, path), dist));
+            }
+            checked++;
+        }
+    }
+    std::cout << "✓ " << checked << " R-MAT queries match reference Dijkstra" << std::endl;
+
+    // On a road grid the two searches together settle fewer vertices than one-sided search
+    Graph road = makeRoadGraph(60, 9);
+    road.enableReverseEdges();
+    int n = road.getNumVertices();
+    BidirectionalQuery road_query(road);
+    PointToPointQuery one_sided(road);
+    long long bidirectional_settled = 0, one_sided_settled = 0;
+    for (int i = 0; i < 20; ++i) {
+        int s = (i * 7919) % n, t = (i * 104729 + 13) % n;
+        double dist = road_query.run(s, t);
+        PointToPointResult result = one_sided.run(s, std::vector<int>{t});
+        assert(closeEnough(dist, result.distances[0]));
+        bidirectional_settled += road_query.getSettledCount();
+        one_sided_settled += result.settled_vertices;
+    }
+    assert(bidirectional_settled < one_sided_settled);
+    std::cout << "✓ Road grid search space: " << bidirectional_settled << " vs "
+              << one_sided_settled << " settled (bidirectional vs one-sided)" << std::endl;
+
+    // Same vertex, distance cap, unreachable target
+    assert(road_query.run(5, 5) == 0.0 && road_query.getPath() == std::vector<int>{5});
+    QueryOptions capped;
+    capped.distance_cap = road_query.run(0, n - 1);
+    assert(road_query.run(0, n - 1, capped) == INF && road_query.getPath().empty());
+
+    Graph split(3);
+    split.addEdge(0, 1, 1.0);
+    split.enableReverseEdges();
+    BidirectionalQuery split_query(split);
+    assert(split_query.run(0, 2) == INF && split_query.getMeetingVertex() == -1);
+    assert(split_query.run(0, 1) == 1.0);
+    std::cout << "✓ Trivial, capped and unreachable queries handled" << std::endl;
+}
+
+void testDistanceTableScale(bool enabled) {
+    if (!enabled) return;
+    std::cout << "\n=== Distance Table Timing ===" << std::endl;
+
+    Graph graph = makeRoadGraph(300, 3);
+    std::vector<int> sources, targets;
+    for (int i = 0; i < 200; ++i) {
+        sources.push_back((i * 7919) % graph.getNumVertices());
+        targets.push_back((i * 104729) % graph.getNumVertices());
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    DistanceTable table = distanceTable(graph, sources, targets);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "  200x200 table on 90K-vertex road grid: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    assert(table.distances.size() == 40000u);
+
+    std::vector<int> facilities;
+    for (int i = 0; i < 200; ++i) facilities.push_back(static_cast<int>((i * 15485863LL) % graph.getNumVertices()));
+    NearestFacilityQuery query(graph, facilities);
+    start = std::chrono::high_resolution_clock::now();
+    NearestFacilityTable nearest = query.runAll(3);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "  3 nearest of 200 facilities for all 90K vertices: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+    assert(nearest.hits.size() == 3u * graph.getNumVertices());
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Query Engine Test Suite ===" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+
+    initializeDebug(argc, argv);
+    bool timing = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--timing") timing = true;
+    }
+
+    try {
+        testIndexedHeap();
+        testDistanceTable();
+        testMultiSource();
+        testNearestFacilities();
+        testBoundedSSSP();
+        testSparseResult();
+        testCancellation();
+        testMetrics();
+        testTracing();
+        testSSSPCache();
+        testQueryServer();
+        testPointToPoint();
+        testReverseEdges();
+        testBidirectional();
+        testDistanceTableScale(timing);
+
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "🎉 All query engine tests PASSED!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,369 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "Graph.h"
+#include "GraphGenerators.h"
+#include "BMSSPTestFramework.h"
+#include "ContractionHierarchy.h"
+#include "Landmarks.h"
+#include "PointToPoint.h"
+#include "Parallel.h"
+#include "Debug.h"
+
+/**
+ * Speed-up Technique Test Suite
+ * Preprocessing-based point-to-point engines, verified against
+ * BMSSPTestFramework::runReferenceDijkstra:
+ * - Contraction Hierarchies (build, query, path unpacking, file round trip)
+ * - ALT landmarks (selection strategies, float32/float16 tables, A* query)
+ */
+
+const double INF = std::numeric_limits<double>::max();
+
+bool closeEnough(double a, double b) {
+    if (a == INF || b == INF) return a == b;
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+// Length of a vertex path in the original graph, INF if some hop is not an edge
+double pathLength(const Graph& graph, const std::vector<int>& path) {
+    double length = 0.0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        double best = INF;
+        for (const auto& edge : graph.neighbors(path[i])) {
+            if (edge.dest == path[i + 1]) best = std::min(best, edge.weight);
+        }
+        if (best == INF) return INF;
+        length += best;
+    }
+    return length;
+}
+
+// Checks every (source, target) pair for the given sources against reference Dijkstra
+template <typename Query>
+int verifyQueries(const Graph& graph, Query& query, const std::vector<int>& sources, int target_stride) {
+    BMSSPTestFramework framework(1);
+    int checked = 0;
+    for (int source : sources) {
+        std::vector<double> reference = framework.runReferenceDijkstra(graph, {source});
+        for (int target = 0; target < graph.getNumVertices(); target += target_stride) {
+            double dist = query.run(source, target);
+            assert(closeEnough(dist, reference[target]));
+
+            std::vector<int> path = query.getPath();
+            if (dist == INF) {
+                assert(path.empty());
+            } else {
+                assert(path.front() == source && path.back() == target);
+                assert(closeEnough(pathLength(graph, path), dist));
+            }
+            checked++;
+        }
+    }
+    return checked;
+}
+
+void testContractionHierarchy() {
+    std::cout << "=== Testing Contraction Hierarchies ===" << std::endl;
+
+    // Road grid: the intended use case
+    Graph road = generateRoadGrid(40, 40, 21).toGraph();
+    ContractionHierarchy ch = ContractionHierarchy::build(road);
+    assert(ch.getNumVertices() == road.getNumVertices());
+    CHQuery query(ch);
+    int checked = verifyQueries(road, query, {0, 777, 1599}, 7);
+    std::cout << "✓ Road grid: " << checked << " queries match reference Dijkstra ("
+              << ch.getNumShortcuts() << " shortcuts)" << std::endl;
+
+    // Directed power-law graph with unreachable pairs, parallel edges and self-loops
+    Graph rmat = generateRMAT(1000, 6000, 4).toGraph();
+    rmat.addEdge(3, 3, 1.0);
+    rmat.addEdge(3, 9, 100.0);
+    rmat.addEdge(3, 9, 0.25);
+    ContractionHierarchy rmat_ch = ContractionHierarchy::build(rmat);
+    CHQuery rmat_query(rmat_ch);
+    checked = verifyQueries(rmat, rmat_query, {0, 3, 500}, 3);
+    std::cout << "✓ R-MAT: " << checked << " queries match reference Dijkstra" << std::endl;
+
+    // Ranks form a permutation
+    std::vector<char> seen(road.getNumVertices(), 0);
+    for (int v = 0; v < road.getNumVertices(); ++v) {
+        int rank = ch.getRank(v);
+        assert(rank >= 0 && rank < road.getNumVertices() && !seen[rank]);
+        seen[rank] = 1;
+    }
+
+    // Query-side search space is a small fraction of the graph
+    long long settled = 0;
+    for (int i = 0; i < 50; ++i) {
+        query.run((i * 7919) % 1600, (i * 104729 + 5) % 1600);
+        settled += query.getSettledCount();
+    }
+    assert(settled / 50 < 1600 / 4);
+    std::cout << "✓ Average query settles " << settled / 50 << " of 1600 vertices" << std::endl;
+}
+
+void testContractionDeterminism() {
+    std::cout << "\n=== Testing Contraction Determinism ===" << std::endl;
+
+    Graph graph = generateRandomGeometric(1500, 0.05, 8).toGraph();
+    int saved_threads = getParallelThreads();
+
+    setParallelThreads(1);
+    ContractionHierarchy serial = ContractionHierarchy::build(graph);
+    setParallelThreads(4);
+    ContractionHierarchy parallel = ContractionHierarchy::build(graph);
+    setParallelThreads(saved_threads);
+
+    assert(serial.getNumArcs() == parallel.getNumArcs());
+    assert(serial.getNumShortcuts() == parallel.getNumShortcuts());
+    for (int v = 0; v < graph.getNumVertices(); ++v) {
+        assert(serial.getRank(v) == parallel.getRank(v));
+    }
+    std::cout << "✓ Same hierarchy with 1 and 4 threads" << std::endl;
+}
+
+void testHierarchyFile() {
+    std::cout << "\n=== Testing Hierarchy Serialization ===" << std::endl;
+
+    Graph graph = generateRoadGrid(25, 25, 2).toGraph();
+    ContractionHierarchy built = ContractionHierarchy::build(graph);
+    const std::string path = "test_speedup_techniques.ch";
+    built.save(path);
+
+    ContractionHierarchy loaded = ContractionHierarchy::load(path);
+    assert(loaded.getNumVertices() == built.getNumVertices());
+    assert(loaded.getNumArcs() == built.getNumArcs());
+    assert(loaded.getNumShortcuts() == built.getNumShortcuts());
+
+    CHQuery from_built(built), from_file(loaded);
+    for (int s = 0; s < graph.getNumVertices(); s += 61) {
+        for (int t = 0; t < graph.getNumVertices(); t += 17) {
+            assert(from_built.run(s, t) == from_file.run(s, t));
+            assert(from_built.getPath() == from_file.getPath());
+        }
+    }
+    std::cout << "✓ Saved hierarchy answers identically after loading" << std::endl;
+
+    // Truncated and foreign files are rejected
+    {
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated.write("FDCH", 4);
+    }
+    bool threw = false;
+    try { ContractionHierarchy::load(path); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    {
+        std::ofstream foreign(path, std::ios::trunc);
+        foreign << "not a hierarchy";
+    }
+    threw = false;
+    try { ContractionHierarchy::load(path); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::remove(path.c_str());
+
+    threw = false;
+    try { ContractionHierarchy::load("does/not/exist.ch"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    // Well-formed files with broken hierarchy invariants. Layout: 20 header bytes, n ranks,
+    // then per direction n + 1 offsets and the target, weight and middle arrays.
+    built.save(path);
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    int n = built.getNumVertices();
+    size_t num_forward = built.forwardEnd(n - 1) - built.forwardBegin(0);
+    size_t ranks_at = 20;
+    size_t targets_at = ranks_at + 4 * n + 8 * (n + 1);
+    size_t middles_at = targets_at + 12 * num_forward;
+
+    auto loadPatched = [&](size_t offset, int32_t value) {
+        std::string patched = bytes;
+        std::memcpy(&patched[offset], &value, sizeof(value));
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(patched.data(), patched.size());
+        }
+        try { ContractionHierarchy::load(path); } catch (const std::runtime_error&) { return true; }
+        return false;
+    };
+
+    int lowest = 0, shortcut_at = -1, shortcut_from = -1, upward_from = -1;
+    for (int v = 0; v < n; ++v) {
+        if (built.getRank(v) == 0) lowest = v;
+        for (const CHArc* arc = built.forwardBegin(v); arc != built.forwardEnd(v); ++arc) {
+            if (arc->middle >= 0 && shortcut_at < 0) {
+                shortcut_at = static_cast<int>(arc - built.forwardBegin(0));
+                shortcut_from = v;
+            }
+        }
+    }
+    for (int v = 0; v < n && upward_from < 0; ++v) {
+        if (v != lowest && built.forwardBegin(v) != built.forwardEnd(v)) upward_from = v;
+    }
+    assert(shortcut_at >= 0 && upward_from >= 0);
+
+    assert(loadPatched(8, 1 << 30));                                          // n far beyond the file
+    assert(loadPatched(ranks_at + 4, built.getRank(0)));                      // duplicate rank
+    assert(loadPatched(ranks_at, n));                                         // rank out of range
+    size_t upward_at = built.forwardBegin(upward_from) - built.forwardBegin(0);
+    assert(loadPatched(targets_at + 4 * upward_at, lowest));                  // arc leading downward
+    assert(loadPatched(middles_at + 4 * shortcut_at, shortcut_from));         // middle == from
+    assert(!loadPatched(middles_at + 4 * shortcut_at, built.forwardBegin(0)[shortcut_at].middle));
+    std::remove(path.c_str());
+    std::cout << "✓ Corrupt, foreign and missing files throw std::runtime_error" << std::endl;
+}
+
+void testLandmarks() {
+    std::cout << "\n=== Testing ALT Landmarks ===" << std::endl;
+
+    Graph road = generateRoadGrid(40, 40, 21).toGraph();
+    Graph rmat = generateRMAT(1000, 6000, 4).toGraph();
+    BMSSPTestFramework framework(1);
+
+    for (LandmarkStrategy strategy : {LandmarkStrategy::FARTHEST, LandmarkStrategy::AVOID}) {
+        for (LandmarkPrecision precision : {LandmarkPrecision::FLOAT32, LandmarkPrecision::FLOAT16}) {
+            LandmarkParams params;
+            params.num_landmarks = 8;
+            params.strategy = strategy;
+            params.precision = precision;
+            const char* label = strategy == LandmarkStrategy::FARTHEST ? "farthest" : "avoid";
+            const char* bits = precision == LandmarkPrecision::FLOAT32 ? "float32" : "float16";
+
+            for (const Graph* graph : {&road, &rmat}) {
+                LandmarkIndex index = LandmarkIndex::build(*graph, params);
+                assert(index.getNumLandmarks() == 8);
+
+                // Bounds never exceed true distances, even after rounding to float16
+                for (int s : {0, 333, 999}) {
+                    std::vector<double> reference = framework.runReferenceDijkstra(*graph, {s});
+                    for (int t = 0; t < graph->getNumVertices(); t += 5) {
+                        double bound = index.lowerBound(s, t);
+                        assert(reference[t] == INF ? true : bound <= reference[t]);
+                    }
+                }
+
+                ALTQuery query(*graph, index);
+                verifyQueries(*graph, query, {0, 500}, 9);
+            }
+            std::cout << "✓ " << label << " / " << bits << ": admissible bounds, queries match reference" << std::endl;
+        }
+    }
+
+    // float16 tables take half the memory of float32 ones
+    LandmarkParams half_params;
+    half_params.precision = LandmarkPrecision::FLOAT16;
+    LandmarkIndex half_index = LandmarkIndex::build(road, half_params);
+    LandmarkIndex full_index = LandmarkIndex::build(road);
+    assert(half_index.tableBytes() * 2 == full_index.tableBytes());
+    assert(full_index.tableBytes() == 2u * 16 * road.getNumVertices() * sizeof(float));
+
+    // Goal direction shrinks the search compared to plain early-exit Dijkstra
+    ALTQuery alt(road, full_index);
+    PointToPointQuery plain(road);
+    long long alt_settled = 0, plain_settled = 0;
+    for (int i = 0; i < 30; ++i) {
+        int s = (i * 7919) % 1600, t = (i * 104729 + 3) % 1600;
+        double dist = alt.run(s, t);
+        PointToPointResult result = plain.run(s, std::vector<int>{t});
+        assert(closeEnough(dist, result.distances[0]));
+        alt_settled += alt.getSettledCount();
+        plain_settled += result.settled_vertices;
+    }
+    assert(alt_settled < plain_settled);
+    std::cout << "✓ Search space: " << alt_settled << " vs " << plain_settled
+              << " settled (ALT vs Dijkstra)" << std::endl;
+
+    bool threw = false;
+    try {
+        LandmarkParams none;
+        none.num_landmarks = 0;
+        LandmarkIndex::build(road, none);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // More landmarks than vertices, and an index for the wrong graph
+    Graph tiny(3);
+    tiny.addEdge(0, 1, 1.0);
+    LandmarkIndex tiny_index = LandmarkIndex::build(tiny);
+    assert(tiny_index.getNumLandmarks() == 3);
+    ALTQuery tiny_query(tiny, tiny_index);
+    assert(tiny_query.run(0, 1) == 1.0 && tiny_query.run(0, 2) == INF);
+    threw = false;
+    try {
+        ALTQuery mismatched(road, tiny_index);
+        mismatched.run(0, 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Invalid parameters and mismatched indexes rejected" << std::endl;
+}
+
+void testHierarchyTiming(bool enabled) {
+    if (!enabled) return;
+    std::cout << "\n=== Contraction Hierarchy Timing ===" << std::endl;
+
+    Graph graph = generateRoadGrid(200, 200, 3).toGraph();
+    int n = graph.getNumVertices();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    ContractionHierarchy ch = ContractionHierarchy::build(graph);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Preprocessing 40K-vertex road grid: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms, "
+              << ch.getNumShortcuts() << " shortcuts" << std::endl;
+
+    CHQuery query(ch);
+    const int num_queries = 1000;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < num_queries; ++i) {
+        query.run((i * 7919) % n, (i * 104729 + 11) % n);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Average query: "
+              << std::chrono::duration<double, std::micro>(end - start).count() / num_queries << " us" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Speed-up Technique Test Suite ===" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+
+    initializeDebug(argc, argv);
+    bool timing = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--timing") timing = true;
+    }
+
+    try {
+        testContractionHierarchy();
+        testContractionDeterminism();
+        testHierarchyFile();
+        testLandmarks();
+        testHierarchyTiming(timing);
+
+        std::cout << "\n" << std::string(60, '=') << std::endl;
+        std::cout << "🎉 All speed-up technique tests PASSED!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "QueryServer.h"
+#include "Metrics.h"
+#include "Debug.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Query Load Generator
+ * Opens one connection per simulated client against a running query_server and issues a
+ * random mix of point-to-point, SSSP and distance-table requests as fast as each answer
+ * arrives. Reports throughput and latency percentiles per request type.
+ *
+ * Usage:
+ *   query_client --socket /tmp/fastdijkstra.sock [--clients 8] [--requests 1000]
+ *                [--mix 90:5:5] [--table 16] [--seed S]
+ */
+
+namespace {
+    const char* TYPE_NAMES[] = {"point-to-point", "sssp", "table"};
+    const int NUM_TYPES = 3;
+
+    struct ClientResult {
+        LatencyHistogram latency[NUM_TYPES];
+        LatencyHistogram all;
+        uint64_t errors = 0;
+    };
+
+    void printRow(const std::string& name, const LatencyHistogram& h) {
+        if (h.count() == 0) return;
+        auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        std::cout << std::left << std::setw(16) << name << std::right << std::setw(10) << h.count() << std::fixed
+                  << std::setprecision(1) << std::setw(10) << us(static_cast<uint64_t>(h.mean()))
+                  << std::setw(10) << us(h.percentile(0.5)) << std::setw(10) << us(h.percentile(0.9))
+                  << std::setw(10) << us(h.percentile(0.99)) << std::setw(10) << us(h.percentile(0.999))
+                  << std::setw(10) << us(h.max()) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    initializeDebug(argc, argv);
+
+    std::string socket_path = "/tmp/fastdijkstra.sock";
+    int num_clients = 8;
+    int requests = 1000;
+    int table_size = 16;
+    uint64_t seed = 1;
+    int mix[NUM_TYPES] = {90, 5, 5};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--clients" && i + 1 < argc) {
+            num_clients = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--requests" && i + 1 < argc) {
+            requests = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--table" && i + 1 < argc) {
+            table_size = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--mix" && i + 1 < argc) {
+            std::string text = argv[++i];
+            size_t first = text.find(':'), second = text.find(':', first + 1);
+            if (first == std::string::npos || second == std::string::npos) {
+                std::cerr << "❌ --mix expects P2P:SSSP:TABLE weights, e.g. 90:5:5" << std::endl;
+                return 1;
+            }
+            mix[0] = std::max(0, std::atoi(text.substr(0, first).c_str()));
+            mix[1] = std::max(0, std::atoi(text.substr(first + 1, second - first - 1).c_str()));
+            mix[2] = std::max(0, std::atoi(text.substr(second + 1).c_str()));
+        } else if (arg == "--debug" || arg == "-d") {
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--socket PATH] [--clients N] [--requests N per client]"
+                      << " [--mix P2P:SSSP:TABLE] [--table K] [--seed S]" << std::endl;
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+    if (mix[0] + mix[1] + mix[2] == 0) mix[0] = 1;
+
+    int n = 0;
+    int64_t m = 0;
+    try {
+        QueryClient probe(socket_path);
+        probe.info(n, m);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Server graph: " << n << " vertices, " << m << " edges; " << num_clients << " clients x "
+              << requests << " requests, mix " << mix[0] << ":" << mix[1] << ":" << mix[2] << std::endl;
+
+    std::vector<ClientResult> results(num_clients);
+    std::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < num_clients; ++c) {
+        clients.emplace_back([&, c] {
+            ClientResult& result = results[c];
+            std::mt19937_64 rng(seed * 1000003 + c);
+            std::uniform_int_distribution<int> vertex(0, n - 1);
+            std::discrete_distribution<int> type({static_cast<double>(mix[0]), static_cast<double>(mix[1]),
+                                                  static_cast<double>(mix[2])});
+            try {
+                QueryClient client(socket_path);
+                std::vector<int> sources(table_size), targets(table_size);
+                for (int i = 0; i < requests; ++i) {
+                    int kind = type(rng);
+                    auto begin = std::chrono::steady_clock::now();
+                    try {
+                        if (kind == 0) {
+                            client.pointToPoint(vertex(rng), vertex(rng));
+                        } else if (kind == 1) {
+                            client.sssp(vertex(rng));
+                        } else {
+                            for (int& v : sources) v = vertex(rng);
+                            for (int& v : targets) v = vertex(rng);
+                            client.distanceTable(sources, targets);
+                        }
+                    } catch (const std::runtime_error&) {
+                        ++result.errors;
+                    }
+                    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                            std::chrono::steady_clock::now() - begin)
+                                                            .count());
+                    result.latency[kind].record(ns);
+                    result.all.record(ns);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "❌ client " << c << ": " << e.what() << std::endl;
+                ++result.errors;
+            }
+        });
+    }
+    for (auto& thread : clients) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ClientResult total;
+    for (const ClientResult& result : results) {
+        for (int k = 0; k < NUM_TYPES; ++k) total.latency[k].merge(result.latency[k]);
+        total.all.merge(result.all);
+        total.errors += result.errors;
+    }
+
+    std::cout << "\nThroughput: " << std::fixed << std::setprecision(0)
+              << static_cast<double>(total.all.count()) / seconds << " requests/s over " << std::setprecision(2)
+              << seconds << " s, " << total.errors << " errors" << std::endl;
+    std::cout << "\n" << std::left << std::setw(16) << "Latency (us)" << std::right << std::setw(10) << "count"
+              << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10)
+              << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    for (int k = 0; k < NUM_TYPES; ++k) printRow(TYPE_NAMES[k], total.latency[k]);
+    printRow("all", total.all);
+    return total.errors == 0 ? 0 : 1;
+}
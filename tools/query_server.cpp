@@ -0,0 +1,114 @@
+#include "QueryServer.h"
+#include "GraphGenerators.h"
+#include "Debug.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+#include <string>
+
+/**
+ * Query Daemon
+ * Loads one graph, keeps it resident and serves shortest-path requests on a Unix socket
+ * (protocol in QueryServer.h) until SIGINT or SIGTERM.
+ *
+ * Usage:
+ *   query_server --socket /tmp/fastdijkstra.sock --graph road.fdg [--workers N] [--batch N] [--cache MB]
+ *   query_server --socket /tmp/fastdijkstra.sock --road 300x300 [--seed S] [--save road.fdg]
+ *   query_server --socket /tmp/fastdijkstra.sock --rmat 1000000x8000000
+ */
+
+namespace {
+    bool parseSize(const std::string& text, long long& a, long long& b) {
+        size_t x = text.find('x');
+        if (x == std::string::npos) return false;
+        a = std::atoll(text.substr(0, x).c_str());
+        b = std::atoll(text.substr(x + 1).c_str());
+        return a > 0 && b > 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    initializeDebug(argc, argv);
+
+    std::string socket_path = "/tmp/fastdijkstra.sock";
+    std::string graph_path, road, rmat, save_path;
+    uint64_t seed = 1;
+    QueryServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--graph" && i + 1 < argc) {
+            graph_path = argv[++i];
+        } else if (arg == "--road" && i + 1 < argc) {
+            road = argv[++i];
+        } else if (arg == "--rmat" && i + 1 < argc) {
+            rmat = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--save" && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            options.num_workers = std::atoi(argv[++i]);
+        } else if (arg == "--cache" && i + 1 < argc) {
+            options.cache_bytes = static_cast<size_t>(std::max(0, std::atoi(argv[++i]))) << 20;
+        } else if (arg == "--batch" && i + 1 < argc) {
+            options.max_batch = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--debug" || arg == "-d") {
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--socket PATH] (--graph FILE | --road ROWSxCOLS | --rmat NxM)"
+                      << " [--seed S] [--save FILE] [--workers N] [--batch N] [--cache MB]" << std::endl;
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    // Block the stop signals before any thread starts so they all inherit the mask and only
+    // the sigwait below receives them
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        GeneratedGraph generated;
+        long long a = 0, b = 0;
+        if (!graph_path.empty()) {
+            generated = GeneratedGraph::load(graph_path);
+        } else if (parseSize(road, a, b)) {
+            generated = generateRoadGrid(static_cast<int>(a), static_cast<int>(b), seed);
+        } else if (parseSize(rmat, a, b)) {
+            generated = generateRMAT(static_cast<int>(a), b, seed);
+        } else {
+            std::cerr << "❌ No graph: give --graph FILE, --road ROWSxCOLS or --rmat NxM" << std::endl;
+            return 1;
+        }
+        if (!save_path.empty()) generated.save(save_path);
+        Graph graph = generated.toGraph();
+        generated = GeneratedGraph();
+        double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Graph: " << graph.getNumVertices() << " vertices, " << graph.getNumEdges() << " edges ("
+                  << load_ms << " ms, " << graph.memoryUsage() / (1024 * 1024) << " MB)" << std::endl;
+
+        QueryServer server(graph, options);
+        server.start(socket_path);
+        std::cout << "Listening on " << socket_path << std::endl;
+
+        int received = 0;
+        sigwait(&stop_signals, &received);
+        server.stop();
+
+        QueryServerStats stats = server.stats();
+        std::cout << "Stopped: " << stats.connections << " connections, " << stats.requests << " requests ("
+                  << stats.errors << " errors) in " << stats.batches << " batches, " << stats.searches
+                  << " searches, " << stats.cache_hits << " cache hits" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}